@@ -1,7 +1,7 @@
 /*
 	Date: June 24, 2011
 	File Name: Queue.c
-	Version: 1.03
+	Version: 1.04
 	IDE: Visual Studio 2010 Professional
 	Compiler: C89
 
@@ -18,199 +18,5985 @@
 	#include "stdlib.h"
 #endif // end of USE_MALLOC
 
+#if (USING_QUEUE_ALLOCATION_COUNTERS == 1)
+	static QUEUE_ALLOCATION_STATS QueueAllocationStats;
+
+	static void *QueueCountedMemAlloc(UINT32 Size)
+	{
+		void *Mem;
+
+		if((Mem = QueueMemAlloc(Size)) == (void*)NULL) // MemAlloc defined in QueueConfig.h
+			QueueAtomicAddRelaxed(&(QueueAllocationStats.FailedAllocations), (UINT32)1);
+		else
+			QueueAtomicAddRelaxed(&(QueueAllocationStats.Allocations), (UINT32)1);
+
+		return (void*)Mem;
+	}
+
+	static void QueueCountedMemDealloc(void *Mem)
+	{
+		QueueAtomicAddRelaxed(&(QueueAllocationStats.Deallocations), (UINT32)1);
+
+		QueueMemDealloc(Mem); // MemDealloc defined in QueueConfig.h
+	}
+
+	/*
+		Every QueueMemAlloc() and QueueMemDealloc() below this point
+		goes through the counters.
+	*/
+	#undef QueueMemAlloc
+	#undef QueueMemDealloc
+
+	#define QueueMemAlloc(Mem)							QueueCountedMemAlloc((UINT32)(Mem))
+	#define QueueMemDealloc(Mem)						QueueCountedMemDealloc(Mem)
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
+
+#if (USING_QUEUE_COPY == 1)
+	#include "string.h"
+
+	/*
+		A copy QUEUE keeps its own copy of each element right behind
+		the QUEUE_NODE, so a node's Data points there rather than at
+		the element that was passed in.  Methods that hand the data 
+		pointer back out would return a pointer into a freed node and
+		refuse a copy QUEUE.
+	*/
+	#define QueueIsCopyQueue(Queue)						(Queue->Type == (BYTE)QUEUE_TYPE_COPY)
+	#define QueueNodeData(Queue, Node, Data)			((QueueIsCopyQueue(Queue)) ? (void*)((Node) + 1) : (void*)(Data))
+#else
+	#define QueueIsCopyQueue(Queue)						((BOOL)FALSE)
+	#define QueueNodeData(Queue, Node, Data)			((void*)(Data))
+#endif // end of USING_QUEUE_COPY
+
+#if (USING_QUEUE_TIMER == 1)
+	#define QueueIsTimerQueue(Queue)					(Queue->Type == (BYTE)QUEUE_TYPE_TIMER)
+#else
+	#define QueueIsTimerQueue(Queue)					((BOOL)FALSE)
+#endif // end of USING_QUEUE_TIMER
+
+#if (USE_PTHREADS == 1)
+	#include "time.h"
+
+	#if (USING_QUEUE_NODE_POOL == 1)
+		static pthread_mutex_t QueueNodePoolMutex = PTHREAD_MUTEX_INITIALIZER;
+	#endif // end of USING_QUEUE_NODE_POOL
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	/*
+		The default QueueConditionWait() for POSIX threads.  Timeout 
+		is relative and in milliseconds, or QUEUE_WAIT_FOREVER.
+	*/
+	static void QueuePthreadConditionWait(pthread_cond_t *Condition, pthread_mutex_t *Mutex, UINT32 Timeout)
+	{
+		struct timespec Deadline;
+
+		if(Timeout == (UINT32)QUEUE_WAIT_FOREVER)
+		{
+			pthread_cond_wait(Condition, Mutex);
+
+			return;
+		}
+
+		clock_gettime(CLOCK_REALTIME, &Deadline);
+
+		Deadline.tv_sec += (time_t)(Timeout / 1000);
+		Deadline.tv_nsec += (long)(Timeout % 1000) * 1000000L;
+
+		if(Deadline.tv_nsec >= 1000000000L)
+		{
+			Deadline.tv_sec++;
+			Deadline.tv_nsec -= 1000000000L;
+		}
+
+		pthread_cond_timedwait(Condition, Mutex, &Deadline);
+	}
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1 || USING_QUEUE_WAIT_TIME_STATISTICS == 1 || USING_QUEUE_PERSISTENT == 1 || USING_QUEUE_SHARED == 1 || USING_QUEUE_TIMER == 1)
+	/*
+		The default QueueGetTickCount() for POSIX, a monotonic
+		millisecond count.
+	*/
+	static UINT32 QueuePosixGetTickCount(void)
+	{
+		struct timespec Now;
+
+		clock_gettime(CLOCK_MONOTONIC, &Now);
+
+		return (UINT32)((UINT32)Now.tv_sec * (UINT32)1000 + (UINT32)(Now.tv_nsec / 1000000L));
+	}
+	#endif // end of USING_QUEUE_BLOCKING_METHODS || USING_QUEUE_WAIT_TIME_STATISTICS || USING_QUEUE_PERSISTENT || USING_QUEUE_SHARED || USING_QUEUE_TIMER
+
+	#if (USING_QUEUE_MULTI == 1)
+	/*
+		The default QueueGetTimestamp() for POSIX, a monotonic
+		nanosecond count.
+	*/
+	static UINT64 QueuePosixGetTimestamp(void)
+	{
+		struct timespec Now;
+
+		clock_gettime(CLOCK_MONOTONIC, &Now);
+
+		return (UINT64)((UINT64)Now.tv_sec * (UINT64)1000000000 + (UINT64)Now.tv_nsec);
+	}
+	#endif // end of USING_QUEUE_MULTI
+#endif // end of USE_PTHREADS
+
+#if (USING_QUEUE_NODE_POOL == 1)
+	/*
+		The node pool shared by every QUEUE.  Every slab with idle
+		QUEUE_NODE's is on one list, the completely idle slabs at the
+		end where they are taken last and released first.  A slab
+		whose QUEUE_NODE's are all in use is on no list at all.
+	*/
+	static QUEUE_NODE_SLAB *QueueNodePoolFirst = (QUEUE_NODE_SLAB*)NULL;
+	static QUEUE_NODE_SLAB *QueueNodePoolLast = (QUEUE_NODE_SLAB*)NULL;
+	static QUEUE_NODE_POOL_STATS QueueNodePoolStats;
+
+	/*
+		Links Slab into the pool's list, at the end if it is
+		completely idle and at the front otherwise.
+	*/
+	static void QueueNodePoolLinkSlab(QUEUE_NODE_SLAB *Slab, BOOL Idle)
+	{
+		if(Idle)
+		{
+			Slab->Next = (QUEUE_NODE_SLAB*)NULL;
+			Slab->Prev = (QUEUE_NODE_SLAB*)QueueNodePoolLast;
+
+			if(QueueNodePoolLast != (QUEUE_NODE_SLAB*)NULL)
+				QueueNodePoolLast->Next = (QUEUE_NODE_SLAB*)Slab;
+			else
+				QueueNodePoolFirst = (QUEUE_NODE_SLAB*)Slab;
+
+			QueueNodePoolLast = (QUEUE_NODE_SLAB*)Slab;
+		}
+		else
+		{
+			Slab->Prev = (QUEUE_NODE_SLAB*)NULL;
+			Slab->Next = (QUEUE_NODE_SLAB*)QueueNodePoolFirst;
+
+			if(QueueNodePoolFirst != (QUEUE_NODE_SLAB*)NULL)
+				QueueNodePoolFirst->Prev = (QUEUE_NODE_SLAB*)Slab;
+			else
+				QueueNodePoolLast = (QUEUE_NODE_SLAB*)Slab;
+
+			QueueNodePoolFirst = (QUEUE_NODE_SLAB*)Slab;
+		}
+	}
+
+	static void QueueNodePoolUnlinkSlab(QUEUE_NODE_SLAB *Slab)
+	{
+		if(Slab->Prev != (QUEUE_NODE_SLAB*)NULL)
+			Slab->Prev->Next = (QUEUE_NODE_SLAB*)(Slab->Next);
+		else
+			QueueNodePoolFirst = (QUEUE_NODE_SLAB*)(Slab->Next);
+
+		if(Slab->Next != (QUEUE_NODE_SLAB*)NULL)
+			Slab->Next->Prev = (QUEUE_NODE_SLAB*)(Slab->Prev);
+		else
+			QueueNodePoolLast = (QUEUE_NODE_SLAB*)(Slab->Prev);
+	}
+
+	static BOOL QueueNodePoolGrow(void)
+	{
+		QUEUE_NODE_SLAB *Slab;
+		UINT32 i;
+
+		if((Slab = (QUEUE_NODE_SLAB*)QueueNodeSlabAlloc(sizeof(QUEUE_NODE_SLAB))) == (QUEUE_NODE_SLAB*)NULL) // NodeSlabAlloc defined in QueueConfig.h
+		{
+			return (BOOL)FALSE;
+		}
+
+		Slab->FreeList = (QUEUE_NODE*)NULL;
+		Slab->FreeNodes = (UINT32)QUEUE_NODE_POOL_SLAB_SIZE;
+
+		// Thread every node of the new slab onto its free list.
+		for(i = 0; i < (UINT32)QUEUE_NODE_POOL_SLAB_SIZE; i++)
+		{
+			Slab->Nodes[i].Slab = (QUEUE_NODE_SLAB*)Slab;
+			Slab->Nodes[i].Next = (QUEUE_NODE*)(Slab->FreeList);
+			Slab->FreeList = (QUEUE_NODE*)&(Slab->Nodes[i]);
+		}
+
+		QueueNodePoolLinkSlab(Slab, (BOOL)TRUE);
+
+		QueueNodePoolStats.Slabs++;
+		QueueNodePoolStats.TotalNodes += (UINT32)QUEUE_NODE_POOL_SLAB_SIZE;
+		QueueNodePoolStats.FreeNodes += (UINT32)QUEUE_NODE_POOL_SLAB_SIZE;
+		QueueNodePoolStats.SlabAllocations++;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Takes Count idle QUEUE_NODE's out of the pool, linked through
+		their Next pointers with the last one's Next NULL.  The pool
+		must hold at least Count idle nodes.
+	*/
+	static QUEUE_NODE *QueueNodePoolTakeUnsafe(UINT32 Count)
+	{
+		QUEUE_NODE_SLAB *Slab;
+		QUEUE_NODE *First, *Node;
+		UINT32 i;
+
+		First = (QUEUE_NODE*)NULL;
+
+		for(i = (UINT32)0; i < Count; i++)
+		{
+			// Partly used slabs come first so the idle ones stay idle.
+			Slab = (QUEUE_NODE_SLAB*)QueueNodePoolFirst;
+
+			Node = (QUEUE_NODE*)(Slab->FreeList);
+			Slab->FreeList = (QUEUE_NODE*)(Node->Next);
+
+			if(--Slab->FreeNodes == (UINT32)0)
+				QueueNodePoolUnlinkSlab(Slab);
+
+			Node->Next = (QUEUE_NODE*)First;
+			First = (QUEUE_NODE*)Node;
+		}
+
+		QueueNodePoolStats.FreeNodes -= Count;
+
+		if(QueueNodePoolStats.TotalNodes - QueueNodePoolStats.FreeNodes > QueueNodePoolStats.PeakNodesInUse)
+			QueueNodePoolStats.PeakNodesInUse = QueueNodePoolStats.TotalNodes - QueueNodePoolStats.FreeNodes;
+
+		return (QUEUE_NODE*)First;
+	}
+
+	/*
+		Releases completely idle slabs, from the end of the list,
+		while the pool holds more than MaxFreeNodes idle nodes.
+	*/
+	static UINT32 QueueNodePoolShrinkUnsafe(UINT32 MaxFreeNodes)
+	{
+		QUEUE_NODE_SLAB *Slab;
+		UINT32 Released;
+
+		Released = (UINT32)0;
+
+		while(QueueNodePoolStats.FreeNodes > MaxFreeNodes && QueueNodePoolLast != (QUEUE_NODE_SLAB*)NULL)
+		{
+			Slab = (QUEUE_NODE_SLAB*)QueueNodePoolLast;
+
+			if(Slab->FreeNodes != (UINT32)QUEUE_NODE_POOL_SLAB_SIZE)
+				break;
+
+			QueueNodePoolUnlinkSlab(Slab);
+
+			QueueNodeSlabDealloc((void*)Slab, sizeof(QUEUE_NODE_SLAB)); // NodeSlabDealloc defined in QueueConfig.h
+
+			QueueNodePoolStats.FreeNodes -= (UINT32)QUEUE_NODE_POOL_SLAB_SIZE;
+			Released++;
+		}
+
+		QueueNodePoolStats.Slabs -= Released;
+		QueueNodePoolStats.TotalNodes -= (UINT32)(Released * (UINT32)QUEUE_NODE_POOL_SLAB_SIZE);
+		QueueNodePoolStats.SlabReleases += Released;
+
+		return (UINT32)Released;
+	}
+
+	/*
+		Puts the chain of Count QUEUE_NODE's starting at First back
+		into the slabs they came from.  Once a whole slab's worth
+		of idle nodes is over QUEUE_NODE_POOL_MAX_FREE_NODES an idle
+		slab is released.
+	*/
+	static void QueueNodePoolPut(QUEUE_NODE *First, UINT32 Count)
+	{
+		QUEUE_NODE_SLAB *Slab;
+		QUEUE_NODE *Node;
+		UINT32 i;
+
+		QueueNodePoolLock();
+
+		for(i = (UINT32)0; i < Count; i++)
+		{
+			Node = (QUEUE_NODE*)First;
+			First = (QUEUE_NODE*)(First->Next);
+
+			Slab = (QUEUE_NODE_SLAB*)(Node->Slab);
+
+			Node->Next = (QUEUE_NODE*)(Slab->FreeList);
+			Slab->FreeList = (QUEUE_NODE*)Node;
+
+			if(Slab->FreeNodes++ == (UINT32)0)
+			{
+				QueueNodePoolLinkSlab(Slab, (BOOL)(Slab->FreeNodes == (UINT32)QUEUE_NODE_POOL_SLAB_SIZE));
+			}
+			else if(Slab->FreeNodes == (UINT32)QUEUE_NODE_POOL_SLAB_SIZE)
+			{
+				QueueNodePoolUnlinkSlab(Slab);
+				QueueNodePoolLinkSlab(Slab, (BOOL)TRUE);
+			}
+		}
+
+		QueueNodePoolStats.FreeNodes += Count;
+
+		#if (QUEUE_NODE_POOL_MAX_FREE_NODES > 0)
+			QueueNodePoolShrinkUnsafe((UINT32)(QUEUE_NODE_POOL_MAX_FREE_NODES + QUEUE_NODE_POOL_SLAB_SIZE - 1));
+		#endif // end of QUEUE_NODE_POOL_MAX_FREE_NODES
+
+		QueueNodePoolUnlock();
+	}
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+	/*
+		Every node cache ever created, and the calling thread's own.
+	*/
+	static QUEUE_NODE_CACHE *QueueNodeCaches = (QUEUE_NODE_CACHE*)NULL;
+	static QUEUE_THREAD_LOCAL QUEUE_NODE_CACHE *QueueNodeCacheSelf = (QUEUE_NODE_CACHE*)NULL;
+
+	/*
+		Takes every QUEUE_NODE other threads sent back to Cache,
+		Last and Count receive the end and length of the chain.
+	*/
+	static QUEUE_NODE *QueueNodeCacheTake(QUEUE_NODE_CACHE *Cache, QUEUE_NODE **Last, UINT32 *Count)
+	{
+		QUEUE_NODE *Node;
+
+		Node = (QUEUE_NODE*)QueueAtomicLoadRelaxed(&(Cache->Returned));
+
+		// Taking the whole list at once can't suffer from ABA.
+		while(Node != (QUEUE_NODE*)NULL && !QueueAtomicCompareExchangeStrong(&(Cache->Returned), &Node, (QUEUE_NODE*)NULL));
+
+		if(Node == (QUEUE_NODE*)NULL)
+			return (QUEUE_NODE*)NULL;
+
+		for(*Last = Node, *Count = (UINT32)1; (*Last)->Next != (QUEUE_NODE*)NULL; *Last = (*Last)->Next)
+			(*Count)++;
+
+		return (QUEUE_NODE*)Node;
+	}
+
+	/*
+		Hands every QUEUE_NODE sent back to Cache to the node pool.
+	*/
+	static void QueueNodeCacheDrain(QUEUE_NODE_CACHE *Cache)
+	{
+		QUEUE_NODE *First, *Last;
+		UINT32 Count;
+
+		if((First = QueueNodeCacheTake(Cache, &Last, &Count)) != (QUEUE_NODE*)NULL)
+			QueueNodePoolPut(First, Count);
+	}
+
+	/*
+		Returns the calling thread's node cache, adopting one that
+		another thread left behind or creating one the first time.
+	*/
+	static QUEUE_NODE_CACHE *QueueNodeCacheGet(void)
+	{
+		QUEUE_NODE_CACHE *Cache;
+
+		if(QueueNodeCacheSelf != (QUEUE_NODE_CACHE*)NULL)
+			return (QUEUE_NODE_CACHE*)QueueNodeCacheSelf;
+
+		QueueNodePoolLock();
+
+		for(Cache = QueueNodeCaches; Cache != (QUEUE_NODE_CACHE*)NULL && Cache->InUse; Cache = Cache->Next);
+
+		if(Cache == (QUEUE_NODE_CACHE*)NULL)
+		{
+			if((Cache = (QUEUE_NODE_CACHE*)QueueMemAlloc(sizeof(QUEUE_NODE_CACHE))) != (QUEUE_NODE_CACHE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				Cache->Returned = Cache->FreeList = (QUEUE_NODE*)NULL;
+				Cache->RemoteFirst = Cache->RemoteLast = (QUEUE_NODE*)NULL;
+				Cache->FreeNodes = Cache->RemoteNodes = (UINT32)0;
+				Cache->Remote = (QUEUE_NODE_CACHE*)NULL;
+
+				Cache->Next = (QUEUE_NODE_CACHE*)QueueNodeCaches;
+				QueueNodeCaches = (QUEUE_NODE_CACHE*)Cache;
+			}
+		}
+
+		if(Cache != (QUEUE_NODE_CACHE*)NULL)
+			QueueAtomicStoreRelaxed(&(Cache->InUse), (BOOL)TRUE);
+
+		QueueNodePoolUnlock();
+
+		// Whatever was still sent to the cache while nobody owned it belongs to the pool.
+		if(Cache != (QUEUE_NODE_CACHE*)NULL)
+			QueueNodeCacheDrain(Cache);
+
+		QueueNodeCacheSelf = (QUEUE_NODE_CACHE*)Cache;
+
+		return (QUEUE_NODE_CACHE*)Cache;
+	}
+
+	/*
+		Pushes the chain of QUEUE_NODE's from First to Last onto
+		the nodes sent back to Cache.
+	*/
+	static void QueueNodeCachePush(QUEUE_NODE_CACHE *Cache, QUEUE_NODE *First, QUEUE_NODE *Last)
+	{
+		QUEUE_NODE *Head;
+
+		Head = (QUEUE_NODE*)QueueAtomicLoadRelaxed(&(Cache->Returned));
+
+		do
+		{
+			Last->Next = (QUEUE_NODE*)Head;
+		}
+		while(!QueueAtomicCompareExchangeStrong(&(Cache->Returned), &Head, First));
+	}
+
+	/*
+		Takes every QUEUE_NODE other threads sent back to Cache
+		onto its free list.
+	*/
+	static void QueueNodeCacheReclaim(QUEUE_NODE_CACHE *Cache)
+	{
+		QUEUE_NODE *Node, *Last;
+		UINT32 Count;
+
+		if((Node = QueueNodeCacheTake(Cache, &Last, &Count)) == (QUEUE_NODE*)NULL)
+			return;
+
+		Last->Next = (QUEUE_NODE*)(Cache->FreeList);
+		Cache->FreeList = (QUEUE_NODE*)Node;
+		Cache->FreeNodes += Count;
+	}
+
+	/*
+		Sends the chain of Count QUEUE_NODE's from First to Last
+		back to Cache, or to the node pool when no thread owns it.
+	*/
+	static void QueueNodeCacheSend(QUEUE_NODE_CACHE *Cache, QUEUE_NODE *First, QUEUE_NODE *Last, UINT32 Count)
+	{
+		if(!QueueAtomicLoadRelaxed(&(Cache->InUse)))
+		{
+			QueueNodePoolPut(First, Count);
+
+			return;
+		}
+
+		QueueNodeCachePush(Cache, First, Last);
+
+		// The owner may have released the cache after it last drained it, nobody else would.
+		QueueAtomicFence();
+
+		if(!QueueAtomicLoadRelaxed(&(Cache->InUse)))
+			QueueNodeCacheDrain(Cache);
+	}
+
+	/*
+		Sends the QUEUE_NODE's this thread freed for another
+		thread back to that thread's cache.
+	*/
+	static void QueueNodeCacheFlush(QUEUE_NODE_CACHE *Cache)
+	{
+		if(Cache->RemoteNodes)
+		{
+			QueueNodeCacheSend(Cache->Remote, Cache->RemoteFirst, Cache->RemoteLast, Cache->RemoteNodes);
+
+			Cache->RemoteFirst = Cache->RemoteLast = (QUEUE_NODE*)NULL;
+			Cache->RemoteNodes = (UINT32)0;
+		}
+
+		Cache->Remote = (QUEUE_NODE_CACHE*)NULL;
+	}
+
+	/*
+		Hands the first Count idle QUEUE_NODE's of Cache back to
+		the node pool.
+	*/
+	static void QueueNodeCacheGiveBack(QUEUE_NODE_CACHE *Cache, UINT32 Count)
+	{
+		QUEUE_NODE *First, *Last;
+		UINT32 i;
+
+		First = Last = (QUEUE_NODE*)(Cache->FreeList);
+
+		for(i = (UINT32)1; i < Count; i++)
+			Last = (QUEUE_NODE*)(Last->Next);
+
+		Cache->FreeList = (QUEUE_NODE*)(Last->Next);
+		Cache->FreeNodes -= Count;
+
+		QueueNodePoolPut(First, Count);
+	}
+
+	static QUEUE_NODE *QueueNodeCacheAlloc(void)
+	{
+		QUEUE_NODE_CACHE *Cache;
+		QUEUE_NODE *Node;
+		UINT32 Count;
+
+		if((Cache = QueueNodeCacheGet()) == (QUEUE_NODE_CACHE*)NULL)
+			return (QUEUE_NODE*)NULL;
+
+		if(Cache->FreeList == (QUEUE_NODE*)NULL)
+		{
+			QueueNodeCacheReclaim(Cache);
+
+			// A thread that only allocates gets everything its consumers free back here.
+			if(Cache->FreeNodes > (UINT32)QUEUE_NODE_CACHE_MAX_FREE_NODES)
+				QueueNodeCacheGiveBack(Cache, Cache->FreeNodes - (UINT32)QUEUE_NODE_CACHE_MAX_FREE_NODES);
+		}
+
+		// Only go to the pool when no other thread sent anything back.
+		if(Cache->FreeList == (QUEUE_NODE*)NULL)
+		{
+			QueueNodePoolLock();
+
+			while(QueueNodePoolStats.FreeNodes < (UINT32)QUEUE_NODE_CACHE_BATCH && QueueNodePoolGrow());
+
+			if(QueueNodePoolStats.FreeNodes == (UINT32)0)
+			{
+				QueueNodePoolUnlock();
+
+				return (QUEUE_NODE*)NULL;
+			}
+
+			Count = (QueueNodePoolStats.FreeNodes < (UINT32)QUEUE_NODE_CACHE_BATCH) ? QueueNodePoolStats.FreeNodes : (UINT32)QUEUE_NODE_CACHE_BATCH;
+
+			Cache->FreeList = QueueNodePoolTakeUnsafe(Count);
+
+			QueueNodePoolUnlock();
+
+			Cache->FreeNodes = Count;
+		}
+
+		Node = (QUEUE_NODE*)(Cache->FreeList);
+		Cache->FreeList = (QUEUE_NODE*)(Node->Next);
+		Cache->FreeNodes--;
+
+		Node->Owner = (QUEUE_NODE_CACHE*)Cache;
+
+		return (QUEUE_NODE*)Node;
+	}
+
+	static void QueueNodeCacheFree(QUEUE_NODE *Node)
+	{
+		QUEUE_NODE_CACHE *Cache;
+
+		// A thread without a cache of its own sends the node straight back.
+		if((Cache = QueueNodeCacheGet()) == (QUEUE_NODE_CACHE*)NULL)
+		{
+			QueueNodeCacheSend(Node->Owner, Node, Node, (UINT32)1);
+
+			return;
+		}
+
+		if(Node->Owner == Cache)
+		{
+			Node->Next = (QUEUE_NODE*)(Cache->FreeList);
+			Cache->FreeList = (QUEUE_NODE*)Node;
+
+			if(++Cache->FreeNodes > (UINT32)QUEUE_NODE_CACHE_MAX_FREE_NODES)
+				QueueNodeCacheGiveBack(Cache, (Cache->FreeNodes < (UINT32)QUEUE_NODE_CACHE_BATCH) ? Cache->FreeNodes : (UINT32)QUEUE_NODE_CACHE_BATCH);
+
+			return;
+		}
+
+		// Collect a batch for one owner at a time, which is all a producer and consumer pair needs.
+		if(Cache->Remote != Node->Owner)
+		{
+			QueueNodeCacheFlush(Cache);
+
+			Cache->Remote = (QUEUE_NODE_CACHE*)(Node->Owner);
+		}
+
+		Node->Next = (QUEUE_NODE*)(Cache->RemoteFirst);
+		Cache->RemoteFirst = (QUEUE_NODE*)Node;
+
+		if(Cache->RemoteNodes++ == (UINT32)0)
+			Cache->RemoteLast = (QUEUE_NODE*)Node;
+
+		if(Cache->RemoteNodes >= (UINT32)QUEUE_NODE_CACHE_BATCH)
+			QueueNodeCacheFlush(Cache);
+	}
+
+	/*
+		Sends what the calling thread collected for another thread
+		back right away.  A consumer that found its QUEUE empty may
+		not free another QUEUE_NODE for a long time, and until then
+		its producer can't use the ones it holds.
+	*/
+	static void QueueNodeCacheIdle(void)
+	{
+		if(QueueNodeCacheSelf != (QUEUE_NODE_CACHE*)NULL && QueueNodeCacheSelf->RemoteNodes)
+			QueueNodeCacheFlush(QueueNodeCacheSelf);
+	}
+	#endif // end of USING_QUEUE_NODE_CACHE
+#endif // end of USING_QUEUE_NODE_POOL
+
+#if (USING_QUEUE_NODE_CACHE == 0)
+	#define QueueNodeCacheIdle()						((void)0)
+#endif // end of USING_QUEUE_NODE_CACHE
+
+#if (USING_QUEUE_STATISTICS == 1)
+	/*
+		Counts Count pieces of data that were just added, the QUEUE's
+		Size already includes them.
+	*/
+	static void QueueStatsAdded(QUEUE *Queue, UINT32 Count)
+	{
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			// Only one piece of data is timed at a time, the first added while none is.
+			if(Queue->Sampling == (BOOL)FALSE)
+			{
+				// Counted in what leaves the QUEUE, so data swapped in doesn't throw it off.
+				Queue->SampleTime = (UINT32)QueueGetTickCount();
+				Queue->SamplePosition = Queue->Stats.Dequeues + Queue->Stats.Cleared + Queue->Size - Count;
+				Queue->Sampling = (BOOL)TRUE;
+			}
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+
+		Queue->Stats.Enqueues += Count;
+
+		if(Queue->Size > Queue->Stats.HighWaterMark)
+			Queue->Stats.HighWaterMark = Queue->Size;
+	}
+
+	/*
+		Counts Count pieces of data about to be removed from the front.
+	*/
+	static void QueueStatsRemoved(QUEUE *Queue, UINT32 Count)
+	{
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			UINT32 Wait;
+
+			/*
+				Data leaves in order, removed or cleared, so the timed data
+				leaves once that count passes what was ahead of it.
+			*/
+			if(Queue->Sampling && Queue->SamplePosition - (Queue->Stats.Dequeues + Queue->Stats.Cleared) < Count)
+			{
+				Wait = (UINT32)QueueGetTickCount() - Queue->SampleTime;
+
+				Queue->Stats.WaitSamples++;
+				Queue->Stats.TotalWaitTime += Wait;
+
+				if(Wait > Queue->Stats.MaxWaitTime)
+					Queue->Stats.MaxWaitTime = Wait;
+
+				Queue->Sampling = (BOOL)FALSE;
+			}
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+
+		Queue->Stats.Dequeues += Count;
+	}
+
+	/*
+		Counts Count pieces of data about to be thrown away.
+	*/
+	static void QueueStatsCleared(QUEUE *Queue, UINT32 Count)
+	{
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			Queue->Sampling = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+
+		Queue->Stats.Cleared += Count;
+	}
+
+	/*
+		Counts Count pieces of data taken from the end of the QUEUE.
+		The timed data may be among them, so timing starts over.
+	*/
+	static void QueueStatsMovedOut(QUEUE *Queue, UINT32 Count)
+	{
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			Queue->Sampling = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+
+		Queue->Stats.Dequeues += Count;
+	}
+
+	/*
+		Notes that the QUEUE just traded its data for another QUEUE's,
+		which counts as neither added nor removed.  The timed data is
+		gone, so timing starts over.
+	*/
+	static void QueueStatsSwapped(QUEUE *Queue)
+	{
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			Queue->Sampling = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+
+		if(Queue->Size > Queue->Stats.HighWaterMark)
+			Queue->Stats.HighWaterMark = Queue->Size;
+	}
+
+	#define QueueStatsCount(Queue, Counter)				(Queue->Stats.Counter++)
+#else
+	#define QueueStatsAdded(Queue, Count)				((void)0)
+	#define QueueStatsRemoved(Queue, Count)				((void)0)
+	#define QueueStatsCleared(Queue, Count)				((void)0)
+	#define QueueStatsMovedOut(Queue, Count)			((void)0)
+	#define QueueStatsSwapped(Queue)					((void)0)
+	#define QueueStatsCount(Queue, Counter)				((void)0)
+#endif // end of USING_QUEUE_STATISTICS
+
+#if (USING_QUEUE_EVENT_FD == 1)
+	#include "unistd.h"
+
+	#if defined(__linux__)
+		#include "sys/eventfd.h"
+
+		/*
+			The default QueueEvent methods for Linux, on an eventfd.
+		*/
+		static int QueueLinuxEventCreate(void)
+		{
+			return eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		}
+
+		static void QueueLinuxEventSignal(int Fd)
+		{
+			eventfd_write(Fd, (eventfd_t)1);
+		}
+
+		static void QueueLinuxEventClear(int Fd)
+		{
+			eventfd_t Value;
+
+			eventfd_read(Fd, &Value);
+		}
+	#endif // end of __linux__
+
+	/*
+		Makes the event file descriptor readable when data was added 
+		and it isn't already, so a burst of adds costs one system call.
+	*/
+	static void QueueEventRaise(QUEUE *Queue)
+	{
+		if(Queue->EventFd >= 0 && !Queue->EventSignaled && !QueueIsEmpty(Queue))
+		{
+			QueueEventSignal(Queue->EventFd);
+
+			Queue->EventSignaled = (BOOL)TRUE;
+		}
+	}
+
+	/*
+		Called by every remove which finds the QUEUE empty.  The 
+		consumer drained it, so the next add has to signal again.
+	*/
+	static void QueueEventRearm(QUEUE *Queue)
+	{
+		if(Queue->EventSignaled)
+		{
+			QueueEventClear(Queue->EventFd);
+
+			Queue->EventSignaled = (BOOL)FALSE;
+		}
+	}
+#else
+	#define QueueEventRaise(Queue)						((void)0)
+	#define QueueEventRearm(Queue)						((void)0)
+#endif // end of USING_QUEUE_EVENT_FD
+
+/*
+	All QUEUE_NODE's are allocated and freed through the following
+	two methods so that the node pool can stand in for QueueMemAlloc()
+	and QueueMemDealloc(), so that an intrusive QUEUE can use the
+	QUEUE_NODE embedded in the data instead, and so that a copy QUEUE
+	gets its node and its copy of the data from one allocation.
+*/
+static QUEUE_NODE *QueueAllocNode(QUEUE *Queue, const void *Data)
+{
+	#if ((USING_QUEUE_NODE_POOL == 1 && USING_QUEUE_NODE_CACHE == 0) || USING_QUEUE_COPY == 1)
+		QUEUE_NODE *Node;
+	#endif // end of USING_QUEUE_NODE_POOL && !USING_QUEUE_NODE_CACHE || USING_QUEUE_COPY
+
+	#if (USING_QUEUE_INTRUSIVE == 0 && USING_QUEUE_COPY == 0)
+		// Only an intrusive or a copy QUEUE looks at the QUEUE or the data.
+		(void)Queue;
+		(void)Data;
+	#endif // end of !USING_QUEUE_INTRUSIVE && !USING_QUEUE_COPY
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		if(Queue->Type == (BYTE)QUEUE_TYPE_INTRUSIVE)
+		{
+			if(Data == (const void*)NULL)
+				return (QUEUE_NODE*)NULL;
+
+			return (QUEUE_NODE*)((BYTE*)Data + Queue->NodeOffset);
+		}
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_COPY == 1)
+		if(QueueIsCopyQueue(Queue))
+		{
+			if(Data == (const void*)NULL)
+				return (QUEUE_NODE*)NULL;
+
+			if((Node = (QUEUE_NODE*)QueueMemAlloc(sizeof(QUEUE_NODE) + Queue->ElementSize)) == (QUEUE_NODE*)NULL) // MemAlloc defined in QueueConfig.h
+				return (QUEUE_NODE*)NULL;
+
+			memcpy((void*)(Node + 1), Data, Queue->ElementSize);
+
+			return (QUEUE_NODE*)Node;
+		}
+	#endif // end of USING_QUEUE_COPY
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+		return QueueNodeCacheAlloc();
+	#else
+	#if (USING_QUEUE_NODE_POOL == 1)
+		QueueNodePoolLock();
+
+		if(QueueNodePoolStats.FreeNodes == (UINT32)0)
+		{
+			if(QueueNodePoolGrow() == (BOOL)FALSE)
+			{
+				QueueNodePoolUnlock();
+
+				return (QUEUE_NODE*)NULL;
+			}
+		}
+
+		Node = QueueNodePoolTakeUnsafe((UINT32)1);
+
+		QueueNodePoolUnlock();
+
+		return (QUEUE_NODE*)Node;
+	#else
+		return (QUEUE_NODE*)QueueMemAlloc(sizeof(QUEUE_NODE)); // MemAlloc defined in QueueConfig.h
+	#endif // end of USING_QUEUE_NODE_POOL
+	#endif // end of USING_QUEUE_NODE_CACHE
+}
+
+static void QueueFreeNode(QUEUE *Queue, QUEUE_NODE *Node)
+{
+	#if (USING_QUEUE_INTRUSIVE == 0 && USING_QUEUE_COPY == 0)
+		(void)Queue;
+	#endif // end of !USING_QUEUE_INTRUSIVE && !USING_QUEUE_COPY
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		// The node belongs to the data, there is nothing to free.
+		if(Queue->Type == (BYTE)QUEUE_TYPE_INTRUSIVE)
+			return;
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_COPY == 1)
+		// A copy QUEUE's node never came from the pool.
+		if(QueueIsCopyQueue(Queue))
+		{
+			QueueMemDealloc((void*)Node); // MemDealloc defined in QueueConfig.h
+
+			return;
+		}
+	#endif // end of USING_QUEUE_COPY
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+		QueueNodeCacheFree(Node);
+	#else
+	#if (USING_QUEUE_NODE_POOL == 1)
+		QueueNodePoolPut(Node, (UINT32)1);
+	#else
+		QueueMemDealloc((void*)Node); // MemDealloc defined in QueueConfig.h
+	#endif // end of USING_QUEUE_NODE_POOL
+	#endif // end of USING_QUEUE_NODE_CACHE
+}
+
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	/*
+		Allocates Count QUEUE_NODE's linked through their Next
+		pointers, the last one's Next is NULL.  With the node pool
+		the whole chain costs a single lock.
+	*/
+	static QUEUE_NODE *QueueAllocNodes(QUEUE *Queue, const void **Items, UINT32 Count)
+	{
+		QUEUE_NODE *First;
+
+		#if (USING_QUEUE_NODE_POOL == 0 || USING_QUEUE_NODE_CACHE == 1 || USING_QUEUE_INTRUSIVE == 1 || USING_QUEUE_COPY == 1)
+			QUEUE_NODE *Node;
+			UINT32 i;
+		#endif // end of !USING_QUEUE_NODE_POOL || USING_QUEUE_NODE_CACHE || USING_QUEUE_INTRUSIVE || USING_QUEUE_COPY
+
+		#if (USING_QUEUE_INTRUSIVE == 0 && USING_QUEUE_COPY == 0)
+			// Only an intrusive or a copy QUEUE looks at the QUEUE or the data.
+			(void)Queue;
+			(void)Items;
+		#endif // end of !USING_QUEUE_INTRUSIVE && !USING_QUEUE_COPY
+
+		First = (QUEUE_NODE*)NULL;
+
+		#if (USING_QUEUE_INTRUSIVE == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_INTRUSIVE)
+			{
+				// Chain the nodes embedded in the data back to front.
+				for(i = Count; i; i--)
+				{
+					if((Node = QueueAllocNode(Queue, Items[i - 1])) == (QUEUE_NODE*)NULL)
+						return (QUEUE_NODE*)NULL;
+
+					Node->Next = (QUEUE_NODE*)First;
+					First = (QUEUE_NODE*)Node;
+				}
+
+				return (QUEUE_NODE*)First;
+			}
+		#endif // end of USING_QUEUE_INTRUSIVE
+
+		#if (USING_QUEUE_COPY == 1)
+			if(QueueIsCopyQueue(Queue))
+			{
+				for(i = Count; i; i--)
+				{
+					if((Node = QueueAllocNode(Queue, Items[i - 1])) == (QUEUE_NODE*)NULL)
+					{
+						while(First != (QUEUE_NODE*)NULL)
+						{
+							Node = (QUEUE_NODE*)First;
+							First = (QUEUE_NODE*)(First->Next);
+
+							QueueFreeNode(Queue, Node);
+						}
+
+						return (QUEUE_NODE*)NULL;
+					}
+
+					Node->Next = (QUEUE_NODE*)First;
+					First = (QUEUE_NODE*)Node;
+				}
+
+				return (QUEUE_NODE*)First;
+			}
+		#endif // end of USING_QUEUE_COPY
+
+		#if (USING_QUEUE_NODE_CACHE == 1)
+			for(i = (UINT32)0; i < Count; i++)
+			{
+				if((Node = QueueNodeCacheAlloc()) == (QUEUE_NODE*)NULL)
+				{
+					while(First != (QUEUE_NODE*)NULL)
+					{
+						Node = (QUEUE_NODE*)First;
+						First = (QUEUE_NODE*)(First->Next);
+
+						QueueNodeCacheFree(Node);
+					}
+
+					return (QUEUE_NODE*)NULL;
+				}
+
+				Node->Next = (QUEUE_NODE*)First;
+				First = (QUEUE_NODE*)Node;
+			}
+		#else
+		#if (USING_QUEUE_NODE_POOL == 1)
+			QueueNodePoolLock();
+
+			while(QueueNodePoolStats.FreeNodes < Count)
+			{
+				if(QueueNodePoolGrow() == (BOOL)FALSE)
+				{
+					QueueNodePoolUnlock();
+
+					return (QUEUE_NODE*)NULL;
+				}
+			}
+
+			First = QueueNodePoolTakeUnsafe(Count);
+
+			QueueNodePoolUnlock();
+		#else
+			// Build the chain back to front so no tail pointer is needed.
+			for(i = (UINT32)0; i < Count; i++)
+			{
+				if((Node = (QUEUE_NODE*)QueueMemAlloc(sizeof(QUEUE_NODE))) == (QUEUE_NODE*)NULL) // MemAlloc defined in QueueConfig.h
+				{
+					while(First != (QUEUE_NODE*)NULL)
+					{
+						Node = (QUEUE_NODE*)First;
+						First = (QUEUE_NODE*)(First->Next);
+
+						QueueMemDealloc((void*)Node); // MemDealloc defined in QueueConfig.h
+					}
+
+					return (QUEUE_NODE*)NULL;
+				}
+
+				Node->Next = (QUEUE_NODE*)First;
+				First = (QUEUE_NODE*)Node;
+			}
+		#endif // end of USING_QUEUE_NODE_POOL
+		#endif // end of USING_QUEUE_NODE_CACHE
+
+		return (QUEUE_NODE*)First;
+	}
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+#if (USING_QUEUE_BATCH_METHODS == 1 || USING_QUEUE_CLEAR_METHOD == 1)
+	/*
+		Frees the chain of Count QUEUE_NODE's starting at First.  With
+		the node pool the whole chain costs a single lock.
+	*/
+	static void QueueFreeNodes(QUEUE *Queue, QUEUE_NODE *First, UINT32 Count)
+	{
+		#if (USING_QUEUE_NODE_POOL == 0 || USING_QUEUE_NODE_CACHE == 1 || USING_QUEUE_COPY == 1)
+			QUEUE_NODE *Next;
+		#endif // end of USING_QUEUE_NODE_POOL || USING_QUEUE_NODE_CACHE || USING_QUEUE_COPY
+
+		#if (USING_QUEUE_INTRUSIVE == 0 && USING_QUEUE_COPY == 0)
+			(void)Queue;
+		#endif // end of !USING_QUEUE_INTRUSIVE && !USING_QUEUE_COPY
+
+		#if (USING_QUEUE_INTRUSIVE == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_INTRUSIVE)
+				return;
+		#endif // end of USING_QUEUE_INTRUSIVE
+
+		#if (USING_QUEUE_COPY == 1)
+			if(QueueIsCopyQueue(Queue))
+			{
+				for(; Count; Count--)
+				{
+					Next = (QUEUE_NODE*)(First->Next);
+
+					QueueFreeNode(Queue, First);
+
+					First = (QUEUE_NODE*)Next;
+				}
+
+				return;
+			}
+		#endif // end of USING_QUEUE_COPY
+
+		#if (USING_QUEUE_NODE_CACHE == 1)
+			// Each node goes back to the cache it came from.
+			for(; Count; Count--)
+			{
+				Next = (QUEUE_NODE*)(First->Next);
+
+				QueueNodeCacheFree(First);
+
+				First = (QUEUE_NODE*)Next;
+			}
+		#else
+		#if (USING_QUEUE_NODE_POOL == 1)
+			QueueNodePoolPut(First, Count);
+		#else
+			for(; Count; Count--)
+			{
+				Next = (QUEUE_NODE*)(First->Next);
+
+				QueueMemDealloc((void*)First); // MemDealloc defined in QueueConfig.h
+
+				First = (QUEUE_NODE*)Next;
+			}
+		#endif // end of USING_QUEUE_NODE_POOL
+		#endif // end of USING_QUEUE_NODE_CACHE
+	}
+#endif // end of USING_QUEUE_BATCH_METHODS || USING_QUEUE_CLEAR_METHOD
+
 QUEUE *CreateQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data))
 {
-	QUEUE *TempQueue;
+	QUEUE *TempQueue;
+
+	// If the user didn't pass in a pointer, allocate memory for the QUEUE structure.
+	if(QueueIsNull(Queue))
+	{
+		if((TempQueue = (QUEUE*)QueueMemAlloc(sizeof(QUEUE))) == (QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			return (QUEUE*)NULL;
+		}
+
+		Queue = (QUEUE*)TempQueue;
+	}
+
+	// Initialize the Queue.
+	Queue->Head = Queue->Tail = (QUEUE_NODE*)NULL;
+	Queue->Size = (UINT32)0;
+
+	#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+		Queue->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
+	#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+	#if (USING_QUEUE_TYPES == 1)
+		Queue->Type = (BYTE)QUEUE_TYPE_LINKED;
+	#endif // end of USING_QUEUE_TYPES
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		Queue->Buffer = (void**)NULL;
+		Queue->Mask = Queue->First = (UINT32)0;
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		Queue->NodeOffset = (UINT32)0;
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_COPY == 1)
+		Queue->ElementSize = (UINT32)0;
+	#endif // end of USING_QUEUE_COPY
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		Queue->Heap = (QUEUE_PRIORITY_ENTRY*)NULL;
+		Queue->Capacity = Queue->Sequence = (UINT32)0;
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_TIMER == 1)
+		Queue->Wheel = (QUEUE_TIMER_WHEEL*)NULL;
+	#endif // end of USING_QUEUE_TIMER
+
+	#if (USING_QUEUE_BOUNDED == 1)
+		Queue->Limit = Queue->Dropped = (UINT32)0;
+		Queue->Policy = (BYTE)QUEUE_OVERFLOW_REJECT;
+	#endif // end of USING_QUEUE_BOUNDED
+
+	#if (USING_QUEUE_STATISTICS == 1)
+		Queue->Stats.Enqueues = Queue->Stats.Dequeues = Queue->Stats.Cleared = (UINT32)0;
+		Queue->Stats.HighWaterMark = Queue->Stats.AllocationFailures = Queue->Stats.EmptyRemoves = (UINT32)0;
+
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			Queue->Stats.WaitSamples = Queue->Stats.TotalWaitTime = Queue->Stats.MaxWaitTime = (UINT32)0;
+			Queue->SampleTime = Queue->SamplePosition = (UINT32)0;
+			Queue->Sampling = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+	#endif // end of USING_QUEUE_STATISTICS
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		QueueLockInit(&(Queue->Lock));
+		QueueConditionInit(&(Queue->NotEmpty));
+		QueueConditionInit(&(Queue->NotFull));
+
+		Queue->EmptyWaiters = Queue->FullWaiters = (UINT32)0;
+		Queue->Closed = (BOOL)FALSE;
+
+		#if (USING_QUEUE_BOUNDED == 1)
+			Queue->BatchWaiters = (UINT32)0;
+		#endif // end of USING_QUEUE_BOUNDED
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	#if (USING_QUEUE_EVENT_FD == 1)
+		Queue->EventFd = -1;
+		Queue->EventSignaled = (BOOL)FALSE;
+	#endif // end of USING_QUEUE_EVENT_FD
+
+	return (QUEUE*)Queue;
+}
+
+#if (USING_QUEUE_INTRUSIVE == 1)
+	QUEUE *CreateIntrusiveQueue(QUEUE *Queue, UINT32 NodeOffset, void (*CustomFreeMethod)(void *Data))
+	{
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+			return (QUEUE*)NULL;
+
+		Queue->Type = (BYTE)QUEUE_TYPE_INTRUSIVE;
+		Queue->NodeOffset = (UINT32)NodeOffset;
+
+		return (QUEUE*)Queue;
+	}
+#endif // end of USING_QUEUE_INTRUSIVE
+
+#if (USING_QUEUE_COPY == 1)
+	QUEUE *CreateCopyQueue(QUEUE *Queue, UINT32 ElementSize, void (*CustomFreeMethod)(void *Data))
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(ElementSize == (UINT32)0)
+				return (QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+			return (QUEUE*)NULL;
+
+		Queue->Type = (BYTE)QUEUE_TYPE_COPY;
+		Queue->ElementSize = (UINT32)ElementSize;
+
+		return (QUEUE*)Queue;
+	}
+#endif // end of USING_QUEUE_COPY
+
+#if (USING_QUEUE_RING_BUFFER == 1)
+	QUEUE *CreateRingQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+	{
+		void **Buffer;
+		UINT32 Size;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Capacity == (UINT32)0 || Capacity > (UINT32)0x80000000)
+				return (QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the capacity up to a power of two so indexes can wrap with a mask.
+		for(Size = (UINT32)1; Size < Capacity; Size <<= 1);
+
+		if((Buffer = (void**)QueueMemAlloc(Size * sizeof(void*))) == (void**)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			return (QUEUE*)NULL;
+		}
+
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+		{
+			QueueMemDealloc((void*)Buffer); // MemDealloc defined in QueueConfig.h
+
+			return (QUEUE*)NULL;
+		}
+
+		Queue->Type = (BYTE)QUEUE_TYPE_RING;
+		Queue->Buffer = (void**)Buffer;
+		Queue->Mask = (UINT32)(Size - 1);
+
+		return (QUEUE*)Queue;
+	}
+
+	BOOL DestroyRingQueue(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+
+			if(Queue->Type != (BYTE)QUEUE_TYPE_RING)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+			{
+				for(; Queue->Size; Queue->Size--, Queue->First = (Queue->First + 1) & Queue->Mask)
+					Queue->QueueFreeMethod(Queue->Buffer[Queue->First]);
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		QueueMemDealloc((void*)(Queue->Buffer)); // MemDealloc defined in QueueConfig.h
+
+		// The QUEUE is left as an empty linked QUEUE.
+		Queue->Type = (BYTE)QUEUE_TYPE_LINKED;
+		Queue->Buffer = (void**)NULL;
+		Queue->Size = Queue->Mask = Queue->First = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_RING_BUFFER
+
+#if (USING_QUEUE_BOUNDED == 1)
+	QUEUE *CreateBoundedQueue(QUEUE *Queue, UINT32 Limit, BYTE Policy, void (*CustomFreeMethod)(void *Data))
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Limit == (UINT32)0 || Policy > (BYTE)QUEUE_OVERFLOW_DROP_NEWEST)
+				return (QUEUE*)NULL;
+
+			#if (USING_QUEUE_BLOCKING_METHODS == 0)
+				// Nothing could ever wake a blocked QueueAdd().
+				if(Policy == (BYTE)QUEUE_OVERFLOW_BLOCK)
+					return (QUEUE*)NULL;
+			#endif // end of USING_QUEUE_BLOCKING_METHODS
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+			return (QUEUE*)NULL;
+
+		Queue->Limit = (UINT32)Limit;
+		Queue->Policy = (BYTE)Policy;
+
+		return (QUEUE*)Queue;
+	}
+
+	UINT32 QueueGetDropCount(QUEUE *Queue)
+	{
+		UINT32 Dropped;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		Dropped = Queue->Dropped;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (UINT32)Dropped;
+	}
+#endif // end of USING_QUEUE_BOUNDED
+
+#if (USING_QUEUE_PRIORITY == 1)
+	QUEUE *CreatePriorityQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+	{
+		QUEUE_PRIORITY_ENTRY *Heap;
+
+		if(Capacity == (UINT32)0)
+			Capacity = (UINT32)1;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Capacity > (UINT32)0xFFFFFFFF / (UINT32)sizeof(QUEUE_PRIORITY_ENTRY))
+				return (QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((Heap = (QUEUE_PRIORITY_ENTRY*)QueueMemAlloc(Capacity * sizeof(QUEUE_PRIORITY_ENTRY))) == (QUEUE_PRIORITY_ENTRY*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			return (QUEUE*)NULL;
+		}
+
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+		{
+			QueueMemDealloc((void*)Heap); // MemDealloc defined in QueueConfig.h
+
+			return (QUEUE*)NULL;
+		}
+
+		Queue->Type = (BYTE)QUEUE_TYPE_PRIORITY;
+		Queue->Heap = (QUEUE_PRIORITY_ENTRY*)Heap;
+		Queue->Capacity = (UINT32)Capacity;
+
+		return (QUEUE*)Queue;
+	}
+
+	BOOL DestroyPriorityQueue(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+
+			if(Queue->Type != (BYTE)QUEUE_TYPE_PRIORITY)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+			{
+				for(; Queue->Size; Queue->Size--)
+					Queue->QueueFreeMethod(Queue->Heap[Queue->Size - 1].Data);
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		QueueMemDealloc((void*)(Queue->Heap)); // MemDealloc defined in QueueConfig.h
+
+		// The QUEUE is left as an empty linked QUEUE.
+		Queue->Type = (BYTE)QUEUE_TYPE_LINKED;
+		Queue->Heap = (QUEUE_PRIORITY_ENTRY*)NULL;
+		Queue->Size = Queue->Capacity = Queue->Sequence = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		TRUE if entry A must be removed before entry B, the higher
+		priority first and the one added first among equal priorities.
+		Sequence is compared by difference so it may wrap around.
+	*/
+	static BOOL QueueHeapBefore(const QUEUE_PRIORITY_ENTRY *A, const QUEUE_PRIORITY_ENTRY *B)
+	{
+		if(A->Priority != B->Priority)
+			return (BOOL)(A->Priority > B->Priority);
+
+		return (BOOL)((INT32)(A->Sequence - B->Sequence) < (INT32)0);
+	}
+
+	/*
+		Makes room in the heap for at least Count more entries,
+		doubling it as often as needed.
+	*/
+	static BOOL QueueHeapReserve(QUEUE *Queue, UINT32 Count)
+	{
+		QUEUE_PRIORITY_ENTRY *Heap;
+		UINT32 Capacity, i;
+
+		if(Count <= Queue->Capacity - Queue->Size)
+			return (BOOL)TRUE;
+
+		if(Count > (UINT32)0x7FFFFFFF / (UINT32)sizeof(QUEUE_PRIORITY_ENTRY) - Queue->Size)
+			return (BOOL)FALSE;
+
+		for(Capacity = Queue->Capacity; Capacity - Queue->Size < Count; Capacity <<= 1);
+
+		if((Heap = (QUEUE_PRIORITY_ENTRY*)QueueMemAlloc(Capacity * sizeof(QUEUE_PRIORITY_ENTRY))) == (QUEUE_PRIORITY_ENTRY*)NULL) // MemAlloc defined in QueueConfig.h
+			return (BOOL)FALSE;
+
+		for(i = (UINT32)0; i < Queue->Size; i++)
+			Heap[i] = Queue->Heap[i];
+
+		QueueMemDealloc((void*)(Queue->Heap)); // MemDealloc defined in QueueConfig.h
+
+		Queue->Heap = (QUEUE_PRIORITY_ENTRY*)Heap;
+		Queue->Capacity = (UINT32)Capacity;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Adds an entry at the bottom of the heap and moves the hole
+		up until its parent comes first, O(log n).  The heap must
+		already have room.
+	*/
+	static void QueueHeapPush(QUEUE *Queue, const void *Data, UINT32 Priority)
+	{
+		QUEUE_PRIORITY_ENTRY Entry;
+		UINT32 Hole, Parent;
+
+		Entry.Priority = (UINT32)Priority;
+		Entry.Sequence = Queue->Sequence++;
+		Entry.Data = (void*)Data;
+
+		for(Hole = Queue->Size; Hole; Hole = Parent)
+		{
+			Parent = (Hole - 1) / (UINT32)QUEUE_PRIORITY_HEAP_ARITY;
+
+			if(!QueueHeapBefore(&Entry, &(Queue->Heap[Parent])))
+				break;
+
+			Queue->Heap[Hole] = Queue->Heap[Parent];
+		}
+
+		Queue->Heap[Hole] = Entry;
+
+		Queue->Size++;
+	}
+
+	/*
+		Removes the entry at the top of the heap, the last entry
+		fills the hole which moves down to the child that comes 
+		first, O(d log n).  The children of an entry sit next to
+		each other in the array.
+	*/
+	static void *QueueHeapPop(QUEUE *Queue)
+	{
+		QUEUE_PRIORITY_ENTRY *Last;
+		void *Data;
+		UINT32 Hole, Child, Best, End;
+
+		Data = (void*)(Queue->Heap[0].Data);
+
+		Last = &(Queue->Heap[--Queue->Size]);
+
+		for(Hole = (UINT32)0; ; Hole = Best)
+		{
+			Child = Hole * (UINT32)QUEUE_PRIORITY_HEAP_ARITY + (UINT32)1;
+
+			if(Child >= Queue->Size)
+				break;
+
+			End = (Queue->Size - Child < (UINT32)QUEUE_PRIORITY_HEAP_ARITY) ? Queue->Size : Child + (UINT32)QUEUE_PRIORITY_HEAP_ARITY;
+
+			for(Best = Child++; Child < End; Child++)
+			{
+				if(QueueHeapBefore(&(Queue->Heap[Child]), &(Queue->Heap[Best])))
+					Best = Child;
+			}
+
+			if(!QueueHeapBefore(&(Queue->Heap[Best]), Last))
+				break;
+
+			Queue->Heap[Hole] = Queue->Heap[Best];
+		}
+
+		Queue->Heap[Hole] = *Last;
+
+		return (void*)Data;
+	}
+
+	/*
+		The work of QueueAdd() and QueueAddWithPriority() for a priority QUEUE.
+	*/
+	static BOOL QueueHeapInsert(QUEUE *Queue, const void *Data, UINT32 Priority)
+	{
+		if(QueueHeapReserve(Queue, (UINT32)1) == (BOOL)FALSE)
+		{
+			QueueStatsCount(Queue, AllocationFailures);
+
+			return (BOOL)FALSE;
+		}
+
+		QueueHeapPush(Queue, Data, Priority);
+
+		QueueStatsAdded(Queue, (UINT32)1);
+		QueueEventRaise(Queue);
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_PRIORITY
+
+/*
+	The following methods do the work of QueueAdd(), QueueRemove(),
+	QueuePeek() and QueueClear() once the parameters have been checked
+	and, with USING_QUEUE_BLOCKING_METHODS, the QUEUE's lock is held.
+*/
+static BOOL QueueInsertData(QUEUE *Queue, const void *Data)
+{
+	QUEUE_NODE *TempQueueNode;
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		// Without a priority the data goes in at the lowest one.
+		if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			return QueueHeapInsert(Queue, Data, (UINT32)0);
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+		{
+			// A ring QUEUE never allocates, it is simply full.
+			if(Queue->Size > Queue->Mask)
+				return (BOOL)FALSE;
+
+			Queue->Buffer[(Queue->First + Queue->Size) & Queue->Mask] = (void*)Data;
+
+			Queue->Size++;
+
+			QueueStatsAdded(Queue, (UINT32)1);
+			QueueEventRaise(Queue);
+
+			return (BOOL)TRUE;
+		}
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		// If the last node still has room just store the data there.
+		if(!QueueIsEmpty(Queue) && Queue->Tail->Last < (UINT32)QUEUE_SEGMENT_SIZE)
+		{
+			Queue->Tail->Data[Queue->Tail->Last++] = (void*)Data;
+
+			// Increment the size.
+			Queue->Size++;
+
+			QueueStatsAdded(Queue, (UINT32)1);
+			QueueEventRaise(Queue);
+
+			return (BOOL)TRUE;
+		}
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+	// Allocate memory for the new node
+	if((TempQueueNode = (QUEUE_NODE*)QueueAllocNode(Queue, Data)) == (QUEUE_NODE*)NULL)
+	{
+		QueueStatsCount(Queue, AllocationFailures);
+
+		return (BOOL)FALSE;
+	}
+
+	// Initialize the new node.
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		TempQueueNode->Data[0] = (void*)Data;
+		TempQueueNode->First = (UINT32)0;
+		TempQueueNode->Last = (UINT32)1;
+	#else
+		TempQueueNode->Data = QueueNodeData(Queue, TempQueueNode, Data);
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+	TempQueueNode->Next = (QUEUE_NODE*)NULL;
+
+	/*
+		Test for empty edge case, if so Tail and Head both point to the node.
+		Otherwise just append it to the end of the QUEUE.
+	*/
+	if(QueueIsEmpty(Queue))
+	{
+		Queue->Head = Queue->Tail = (QUEUE_NODE*)TempQueueNode;
+	}
+	else
+	{
+		Queue->Tail->Next = (QUEUE_NODE*)TempQueueNode;
+		Queue->Tail = (QUEUE_NODE*)TempQueueNode;
+	}
+
+	// Increment the size.
+	Queue->Size++;
+
+	QueueStatsAdded(Queue, (UINT32)1);
+	QueueEventRaise(Queue);
+
+	return (BOOL)TRUE;
+}
+
+static void *QueueExtractData(QUEUE *Queue)
+{
+	void *Data;
+	QUEUE_NODE *TempQueueNode;
+
+	QueueStatsRemoved(Queue, (UINT32)1);
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			return QueueHeapPop(Queue);
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+		{
+			Data = (void*)(Queue->Buffer[Queue->First]);
+
+			Queue->First = (Queue->First + 1) & Queue->Mask;
+
+			Queue->Size--;
+
+			return (void*)Data;
+		}
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		// Take the data and only free the node once all of its data was removed.
+		Data = (void*)(Queue->Head->Data[Queue->Head->First++]);
+
+		Queue->Size--;
+
+		if(Queue->Head->First == Queue->Head->Last)
+		{
+			TempQueueNode = (QUEUE_NODE*)(Queue->Head);
+
+			Queue->Head = (QUEUE_NODE*)(Queue->Head->Next);
+
+			QueueFreeNode(Queue, TempQueueNode);
+
+			if(Queue->Head == (QUEUE_NODE*)NULL)
+				Queue->Tail = (QUEUE_NODE*)NULL;
+		}
+
+		return (void*)Data;
+	#else
+		// Set the temp node to the QUEUE's Head.
+		TempQueueNode = (QUEUE_NODE*)(Queue->Head);
+
+		// Iterate the QUEUE's Head to the next node (We don't know if it's NULL yet).
+		Queue->Head = (QUEUE_NODE*)(Queue->Head->Next);
+
+		// Get a handle on the data of the node we're about to remove.
+		Data = (void*)(TempQueueNode->Data);
+
+		// Free the old node.
+		QueueFreeNode(Queue, TempQueueNode);
+
+		// Check to see if the Queue is now empty.
+		if(Queue->Head == (QUEUE_NODE*)NULL)
+			Queue->Tail = (QUEUE_NODE*)NULL;
+
+		// No matter what, decrement the QUEUE's size by one.
+		Queue->Size--;
+
+		return (void*)Data;
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
+}
+
+#if (USING_QUEUE_BOUNDED == 1)
+	/*
+		Frees data the overflow policy threw away.
+	*/
+	static void QueueDrop(QUEUE *Queue, const void *Data)
+	{
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+				Queue->QueueFreeMethod((void*)Data);
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		Queue->Dropped++;
+	}
+
+	/*
+		Throws away the front of a full QUEUE and adds Data at its
+		end, reusing the front's QUEUE_NODE.  A new QUEUE_NODE is only
+		needed while other data keeps the front segment alive, and is
+		taken before anything is thrown away.  Returns FALSE if that
+		failed, with the QUEUE untouched.
+	*/
+	static BOOL QueueReplaceOldest(QUEUE *Queue, const void *Data)
+	{
+		QUEUE_NODE *Node;
+		void *Oldest;
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			BOOL Emptied;
+
+			Emptied = (BOOL)(Queue->Head->First + 1 == Queue->Head->Last);
+
+			if(!Emptied && Queue->Tail->Last == (UINT32)QUEUE_SEGMENT_SIZE)
+			{
+				if((Node = (QUEUE_NODE*)QueueAllocNode(Queue, Data)) == (QUEUE_NODE*)NULL)
+				{
+					QueueStatsCount(Queue, AllocationFailures);
+
+					return (BOOL)FALSE;
+				}
+
+				Node->First = Node->Last = (UINT32)0;
+				Node->Next = (QUEUE_NODE*)NULL;
+
+				Queue->Tail->Next = (QUEUE_NODE*)Node;
+				Queue->Tail = (QUEUE_NODE*)Node;
+			}
+
+			Node = (QUEUE_NODE*)(Queue->Head);
+			Oldest = (void*)(Node->Data[Node->First++]);
+
+			// The emptied front segment becomes the end of the QUEUE.
+			if(Emptied)
+			{
+				Node->First = Node->Last = (UINT32)0;
+
+				if(Node != Queue->Tail)
+				{
+					Queue->Head = (QUEUE_NODE*)(Node->Next);
+
+					Node->Next = (QUEUE_NODE*)NULL;
+
+					Queue->Tail->Next = (QUEUE_NODE*)Node;
+					Queue->Tail = (QUEUE_NODE*)Node;
+				}
+			}
+
+			Queue->Tail->Data[Queue->Tail->Last++] = (void*)Data;
+		#else
+			Node = (QUEUE_NODE*)(Queue->Head);
+			Oldest = (void*)(Node->Data);
+
+			// The front node becomes the end of the QUEUE.
+			if(Node != Queue->Tail)
+			{
+				Queue->Head = (QUEUE_NODE*)(Node->Next);
+
+				Node->Next = (QUEUE_NODE*)NULL;
+
+				Queue->Tail->Next = (QUEUE_NODE*)Node;
+				Queue->Tail = (QUEUE_NODE*)Node;
+			}
+
+			Node->Data = QueueNodeData(Queue, Node, Data);
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+		// Thrown away, not removed, so it doesn't count as a dequeue.
+		QueueStatsCleared(Queue, (UINT32)1);
+		QueueStatsAdded(Queue, (UINT32)1);
+		QueueEventRaise(Queue);
+
+		QueueDrop(Queue, Oldest);
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		QueueInsertData() for a QUEUE which may be at its limit.  Only
+		a dropping policy ever gets past a full QUEUE, the others fail
+		here and QueueAddWait() waits for room instead.
+	*/
+	static BOOL QueueInsertBounded(QUEUE *Queue, const void *Data)
+	{
+		if(Queue->Limit && Queue->Size >= Queue->Limit)
+		{
+			if(Queue->Policy == (BYTE)QUEUE_OVERFLOW_DROP_NEWEST)
+			{
+				QueueDrop(Queue, Data);
+
+				return (BOOL)TRUE;
+			}
+
+			if(Queue->Policy != (BYTE)QUEUE_OVERFLOW_DROP_OLDEST)
+				return (BOOL)FALSE;
+
+			// Never past the limit, not even for a moment.
+			return QueueReplaceOldest(Queue, Data);
+		}
+
+		return QueueInsertData(Queue, Data);
+	}
+
+	/*
+		TRUE if Count more pieces of data fit under the limit.
+	*/
+	#define QueueFits(Queue, Count)						(Queue->Limit == (UINT32)0 || (Count) <= Queue->Limit - Queue->Size)
+#else
+	#define QueueInsertBounded(Queue, Data)				QueueInsertData(Queue, Data)
+	#define QueueFits(Queue, Count)						((BOOL)TRUE)
+#endif // end of USING_QUEUE_BOUNDED
+
+#if (USING_QUEUE_TIMER == 1)
+	/*
+		Puts Timer on the slot of the lowest level of the wheel
+		whose higher slots its deadline shares with Current.  The
+		deadline must not be before Current.
+	*/
+	static void QueueTimerPlace(QUEUE_TIMER_WHEEL *Wheel, QUEUE_TIMER *Timer)
+	{
+		QUEUE_TIMER **Slot;
+		UINT32 Level;
+
+		for(Level = (UINT32)0; Level < (UINT32)QUEUE_TIMER_LEVELS - 1; Level++)
+		{
+			if((Timer->Deadline >> (QUEUE_TIMER_SLOT_BITS * (Level + 1))) == (Wheel->Current >> (QUEUE_TIMER_SLOT_BITS * (Level + 1))))
+				break;
+		}
+
+		Slot = &(Wheel->Slots[Level][(Timer->Deadline >> (QUEUE_TIMER_SLOT_BITS * Level)) & (QUEUE_TIMER_SLOTS - 1)]);
+
+		Timer->Next = *Slot;
+		*Slot = Timer;
+	}
+
+	/*
+		Moves the data of a due Timer to the end of the QUEUE.  If
+		it can't get a QUEUE_NODE the Timer goes off again next tick.
+	*/
+	static void QueueTimerFire(QUEUE *Queue, QUEUE_TIMER *Timer)
+	{
+		QUEUE_TIMER_WHEEL *Wheel;
+
+		Wheel = Queue->Wheel;
+
+		if(QueueInsertData(Queue, Timer->Data) == (BOOL)FALSE)
+		{
+			Timer->Deadline = Wheel->Current + 1;
+
+			QueueTimerPlace(Wheel, Timer);
+
+			return;
+		}
+
+		Wheel->Pending--;
+
+		Timer->Next = Wheel->FreeList;
+		Wheel->FreeList = Timer;
+	}
+
+	/*
+		Finds the first tick after Current that enters a slot with
+		timers.  Every level only holds timers of the slot Current is
+		in one level up, so the lowest level with any has the nearest.
+	*/
+	static UINT32 QueueTimerNextTick(QUEUE_TIMER_WHEEL *Wheel)
+	{
+		UINT32 Level, Index, i;
+
+		for(Level = (UINT32)0; Level < (UINT32)QUEUE_TIMER_LEVELS; Level++)
+		{
+			Index = Wheel->Current >> (QUEUE_TIMER_SLOT_BITS * Level);
+
+			for(i = (UINT32)1; i < (UINT32)QUEUE_TIMER_SLOTS; i++)
+			{
+				if(Wheel->Slots[Level][(Index + i) & (QUEUE_TIMER_SLOTS - 1)] != (QUEUE_TIMER*)NULL)
+					return (UINT32)((Index + i) << (QUEUE_TIMER_SLOT_BITS * Level));
+			}
+		}
+
+		return (UINT32)(Wheel->Current + 1);
+	}
+
+	/*
+		Turns the wheel up to Now, stopping only at the ticks that
+		enter a slot with timers.  Each of them first hands the timers
+		of every higher slot Current has just entered down a level,
+		then fires level 0's slot.
+	*/
+	static void QueueTimerExpire(QUEUE *Queue, UINT32 Now)
+	{
+		QUEUE_TIMER_WHEEL *Wheel;
+		QUEUE_TIMER *Timer, *Next;
+		UINT32 Level, Slot, Tick;
+
+		Wheel = Queue->Wheel;
+
+		while(Wheel->Pending && (INT32)(Now - Wheel->Current) > (INT32)0)
+		{
+			// Ticks in between only pass empty slots, a day of them would take a day of steps.
+			Tick = QueueTimerNextTick(Wheel);
+
+			if((INT32)(Now - Tick) < (INT32)0)
+			{
+				Wheel->Current = Now;
+
+				break;
+			}
+
+			Wheel->Current = Tick;
+
+			for(Level = (UINT32)1; Level < (UINT32)QUEUE_TIMER_LEVELS; Level++)
+			{
+				if(Wheel->Current & (((UINT32)1 << (QUEUE_TIMER_SLOT_BITS * Level)) - 1))
+					break;
+			}
+
+			// Highest level first, a timer may move down more than once.
+			while(--Level)
+			{
+				Slot = (Wheel->Current >> (QUEUE_TIMER_SLOT_BITS * Level)) & (QUEUE_TIMER_SLOTS - 1);
+
+				Timer = Wheel->Slots[Level][Slot];
+				Wheel->Slots[Level][Slot] = (QUEUE_TIMER*)NULL;
+
+				for(; Timer != (QUEUE_TIMER*)NULL; Timer = Next)
+				{
+					Next = Timer->Next;
+
+					QueueTimerPlace(Wheel, Timer);
+				}
+			}
+
+			Slot = Wheel->Current & (QUEUE_TIMER_SLOTS - 1);
+
+			Timer = Wheel->Slots[0][Slot];
+			Wheel->Slots[0][Slot] = (QUEUE_TIMER*)NULL;
+
+			for(; Timer != (QUEUE_TIMER*)NULL; Timer = Next)
+			{
+				Next = Timer->Next;
+
+				QueueTimerFire(Queue, Timer);
+			}
+		}
+
+		// With nothing pending there is nothing to step through.
+		if(Wheel->Pending == (UINT32)0)
+			Wheel->Current = Now;
+	}
+
+	/*
+		Finds the earliest deadline on the wheel.  Every level only
+		holds deadlines later than those of the levels below it, so
+		the first slot with timers after Current's holds the earliest.
+	*/
+	static BOOL QueueTimerNext(QUEUE_TIMER_WHEEL *Wheel, UINT32 *Deadline)
+	{
+		QUEUE_TIMER *Timer;
+		UINT32 Level, Index, i;
+
+		if(Wheel->Pending == (UINT32)0)
+			return (BOOL)FALSE;
+
+		for(Level = (UINT32)0; Level < (UINT32)QUEUE_TIMER_LEVELS; Level++)
+		{
+			Index = Wheel->Current >> (QUEUE_TIMER_SLOT_BITS * Level);
+
+			for(i = (UINT32)1; i < (UINT32)QUEUE_TIMER_SLOTS; i++)
+			{
+				if((Timer = Wheel->Slots[Level][(Index + i) & (QUEUE_TIMER_SLOTS - 1)]) == (QUEUE_TIMER*)NULL)
+					continue;
+
+				for(*Deadline = Timer->Deadline; Timer != (QUEUE_TIMER*)NULL; Timer = Timer->Next)
+				{
+					if((INT32)(Timer->Deadline - *Deadline) < (INT32)0)
+						*Deadline = Timer->Deadline;
+				}
+
+				return (BOOL)TRUE;
+			}
+		}
+
+		return (BOOL)FALSE;
+	}
+
+	/*
+		Throws away every timer on the wheel and its data.
+	*/
+	static void QueueTimerClear(QUEUE *Queue)
+	{
+		QUEUE_TIMER_WHEEL *Wheel;
+		QUEUE_TIMER *Timer, *Next;
+		UINT32 Level, Slot;
+
+		Wheel = Queue->Wheel;
+
+		for(Level = (UINT32)0; Wheel->Pending && Level < (UINT32)QUEUE_TIMER_LEVELS; Level++)
+		{
+			for(Slot = (UINT32)0; Slot < (UINT32)QUEUE_TIMER_SLOTS; Slot++)
+			{
+				for(Timer = Wheel->Slots[Level][Slot]; Timer != (QUEUE_TIMER*)NULL; Timer = Next)
+				{
+					Next = Timer->Next;
+
+					#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+						if(Queue->QueueFreeMethod)
+							Queue->QueueFreeMethod(Timer->Data);
+					#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+					Timer->Next = Wheel->FreeList;
+					Wheel->FreeList = Timer;
+
+					Wheel->Pending--;
+				}
+
+				Wheel->Slots[Level][Slot] = (QUEUE_TIMER*)NULL;
+			}
+		}
+	}
+
+	/*
+		Moves whatever became due since the last call into the QUEUE.
+	*/
+	#define QueueTimerAdvance(Queue)					do { if(QueueIsTimerQueue(Queue)) QueueTimerExpire(Queue, (UINT32)QueueGetTickCount()); } while(0)
+
+	QUEUE *CreateTimerQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data))
+	{
+		QUEUE_TIMER_WHEEL *Wheel;
+		UINT32 Level, Slot;
+
+		if((Wheel = (QUEUE_TIMER_WHEEL*)QueueMemAlloc(sizeof(QUEUE_TIMER_WHEEL))) == (QUEUE_TIMER_WHEEL*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			return (QUEUE*)NULL;
+		}
+
+		if((Queue = CreateQueue(Queue, CustomFreeMethod)) == (QUEUE*)NULL)
+		{
+			QueueMemDealloc((void*)Wheel); // MemDealloc defined in QueueConfig.h
+
+			return (QUEUE*)NULL;
+		}
+
+		for(Level = (UINT32)0; Level < (UINT32)QUEUE_TIMER_LEVELS; Level++)
+		{
+			for(Slot = (UINT32)0; Slot < (UINT32)QUEUE_TIMER_SLOTS; Slot++)
+				Wheel->Slots[Level][Slot] = (QUEUE_TIMER*)NULL;
+		}
+
+		Wheel->FreeList = (QUEUE_TIMER*)NULL;
+		Wheel->Current = (UINT32)QueueGetTickCount();
+		Wheel->Pending = (UINT32)0;
+
+		Queue->Type = (BYTE)QUEUE_TYPE_TIMER;
+		Queue->Wheel = (QUEUE_TIMER_WHEEL*)Wheel;
+
+		return (QUEUE*)Queue;
+	}
+
+	BOOL DestroyTimerQueue(QUEUE *Queue)
+	{
+		QUEUE_TIMER *Timer, *Next;
+		void *Data;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+
+			if(!QueueIsTimerQueue(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		while(!QueueIsEmpty(Queue))
+		{
+			Data = QueueExtractData(Queue);
+
+			#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+				if(Queue->QueueFreeMethod)
+					Queue->QueueFreeMethod(Data);
+			#else
+				(void)Data;
+			#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+		}
+
+		QueueTimerClear(Queue);
+
+		for(Timer = Queue->Wheel->FreeList; Timer != (QUEUE_TIMER*)NULL; Timer = Next)
+		{
+			Next = Timer->Next;
+
+			QueueMemDealloc((void*)Timer); // MemDealloc defined in QueueConfig.h
+		}
+
+		QueueMemDealloc((void*)(Queue->Wheel)); // MemDealloc defined in QueueConfig.h
+
+		// The QUEUE is left as an empty linked QUEUE.
+		Queue->Type = (BYTE)QUEUE_TYPE_LINKED;
+		Queue->Wheel = (QUEUE_TIMER_WHEEL*)NULL;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL QueueAddAt(QUEUE *Queue, const void *Data, UINT32 Deadline)
+	{
+		QUEUE_TIMER_WHEEL *Wheel;
+		QUEUE_TIMER *Timer;
+		BOOL Added;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || !QueueIsTimerQueue(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Wheel = Queue->Wheel;
+		Added = (BOOL)TRUE;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			if(Queue->Closed)
+			{
+				QueueUnlock(&(Queue->Lock));
+
+				return (BOOL)FALSE;
+			}
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		QueueTimerExpire(Queue, (UINT32)QueueGetTickCount());
+
+		if((INT32)(Deadline - Wheel->Current) <= (INT32)0)
+		{
+			// Already due, straight into the QUEUE.
+			Added = QueueInsertData(Queue, Data);
+		}
+		else
+		{
+			if((Timer = Wheel->FreeList) != (QUEUE_TIMER*)NULL)
+				Wheel->FreeList = Timer->Next;
+			else if((Timer = (QUEUE_TIMER*)QueueMemAlloc(sizeof(QUEUE_TIMER))) == (QUEUE_TIMER*)NULL) // MemAlloc defined in QueueConfig.h
+				Added = (BOOL)FALSE;
+
+			if(Added)
+			{
+				Timer->Data = (void*)Data;
+				Timer->Deadline = (UINT32)Deadline;
+
+				QueueTimerPlace(Wheel, Timer);
+
+				Wheel->Pending++;
+			}
+		}
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			// Waiters sleep until the earliest deadline, which may have just moved up.
+			if(Added && Queue->EmptyWaiters)
+				QueueConditionBroadcast(&(Queue->NotEmpty));
+
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Added;
+	}
+
+	BOOL QueueGetNextDeadline(QUEUE *Queue, UINT32 *Deadline)
+	{
+		BOOL Found;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || !QueueIsTimerQueue(Queue) || Deadline == (UINT32*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		QueueTimerExpire(Queue, (UINT32)QueueGetTickCount());
+
+		// Data that is already due is due now.
+		if(!QueueIsEmpty(Queue))
+		{
+			*Deadline = Queue->Wheel->Current;
+
+			Found = (BOOL)TRUE;
+		}
+		else
+		{
+			Found = QueueTimerNext(Queue->Wheel, Deadline);
+		}
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Found;
+	}
+#else
+	#define QueueTimerAdvance(Queue)					((void)0)
+#endif // end of USING_QUEUE_TIMER
+
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	static BOOL QueueInsertBatch(QUEUE *Queue, const void **Items, UINT32 Count)
+	{
+		QUEUE_NODE *First, *Node;
+		UINT32 i;
+
+		#if (USING_QUEUE_BOUNDED == 1)
+			if(!QueueFits(Queue, Count))
+			{
+				if(Queue->Policy == (BYTE)QUEUE_OVERFLOW_REJECT || Queue->Policy == (BYTE)QUEUE_OVERFLOW_BLOCK)
+					return (BOOL)FALSE;
+
+				// The policy decides what survives, one piece of data at a time.
+				for(i = (UINT32)0; i < Count; i++)
+				{
+					if(QueueInsertBounded(Queue, Items[i]) == (BOOL)FALSE)
+						return (BOOL)FALSE;
+				}
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_QUEUE_BOUNDED
+
+		#if (USING_QUEUE_PRIORITY == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			{
+				// All or nothing, so make room for the whole batch first.
+				if(QueueHeapReserve(Queue, Count) == (BOOL)FALSE)
+				{
+					QueueStatsCount(Queue, AllocationFailures);
+
+					return (BOOL)FALSE;
+				}
+
+				for(i = (UINT32)0; i < Count; i++)
+					QueueHeapPush(Queue, Items[i], (UINT32)0);
+
+				QueueStatsAdded(Queue, Count);
+				QueueEventRaise(Queue);
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_QUEUE_PRIORITY
+
+		#if (USING_QUEUE_RING_BUFFER == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+			{
+				// All or nothing, a ring QUEUE never allocates.
+				if(Count > (Queue->Mask + 1) - Queue->Size)
+					return (BOOL)FALSE;
+
+				for(i = (UINT32)0; i < Count; i++)
+					Queue->Buffer[(Queue->First + Queue->Size + i) & Queue->Mask] = (void*)Items[i];
+
+				Queue->Size += Count;
+
+				QueueStatsAdded(Queue, Count);
+				QueueEventRaise(Queue);
+
+				return (BOOL)TRUE;
+			}
+		#endif // end of USING_QUEUE_RING_BUFFER
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		{
+			UINT32 Room, Segments;
+
+			// Whatever doesn't fit in the last node goes into whole new nodes.
+			Room = (QueueIsEmpty(Queue)) ? (UINT32)0 : (UINT32)QUEUE_SEGMENT_SIZE - Queue->Tail->Last;
+
+			if(Count > Room)
+			{
+				Segments = (Count - Room + (UINT32)QUEUE_SEGMENT_SIZE - 1) / (UINT32)QUEUE_SEGMENT_SIZE;
+
+				if((First = QueueAllocNodes(Queue, Items, Segments)) == (QUEUE_NODE*)NULL)
+				{
+					QueueStatsCount(Queue, AllocationFailures);
+
+					return (BOOL)FALSE;
+				}
+			}
+			else
+			{
+				First = (QUEUE_NODE*)NULL;
+			}
+
+			for(i = (UINT32)0; i < Count && i < Room; i++)
+				Queue->Tail->Data[Queue->Tail->Last++] = (void*)Items[i];
+
+			for(Node = First; Node != (QUEUE_NODE*)NULL; Node = Node->Next)
+			{
+				for(Node->First = Node->Last = (UINT32)0; i < Count && Node->Last < (UINT32)QUEUE_SEGMENT_SIZE; i++)
+					Node->Data[Node->Last++] = (void*)Items[i];
+
+				if(Node->Next == (QUEUE_NODE*)NULL)
+					break;
+			}
+		}
+		#else
+			if((First = QueueAllocNodes(Queue, Items, Count)) == (QUEUE_NODE*)NULL)
+			{
+				QueueStatsCount(Queue, AllocationFailures);
+
+				return (BOOL)FALSE;
+			}
+
+			for(i = (UINT32)0, Node = First; ; Node = Node->Next)
+			{
+				Node->Data = QueueNodeData(Queue, Node, Items[i]);
+
+				i++;
+
+				if(Node->Next == (QUEUE_NODE*)NULL)
+					break;
+			}
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+		// Splice the whole chain onto the end of the QUEUE at once.
+		if(First != (QUEUE_NODE*)NULL)
+		{
+			if(QueueIsEmpty(Queue))
+				Queue->Head = (QUEUE_NODE*)First;
+			else
+				Queue->Tail->Next = (QUEUE_NODE*)First;
+
+			Queue->Tail = (QUEUE_NODE*)Node;
+		}
+
+		Queue->Size += Count;
+
+		QueueStatsAdded(Queue, Count);
+		QueueEventRaise(Queue);
+
+		return (BOOL)TRUE;
+	}
+
+	static UINT32 QueueExtractBatch(QUEUE *Queue, void **Items, UINT32 Max)
+	{
+		QUEUE_NODE *First;
+		UINT32 Count, Nodes;
+
+		if(Max > Queue->Size)
+		{
+			if(QueueIsEmpty(Queue))
+			{
+				QueueStatsCount(Queue, EmptyRemoves);
+				QueueNodeCacheIdle();
+			}
+
+			// Asking for more than there is drains the QUEUE.
+			QueueEventRearm(Queue);
+
+			Max = Queue->Size;
+		}
+
+		QueueStatsRemoved(Queue, Max);
+
+		#if (USING_QUEUE_PRIORITY == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			{
+				for(Count = (UINT32)0; Count < Max; Count++)
+					Items[Count] = QueueHeapPop(Queue);
+
+				return (UINT32)Max;
+			}
+		#endif // end of USING_QUEUE_PRIORITY
+
+		#if (USING_QUEUE_RING_BUFFER == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+			{
+				for(Count = (UINT32)0; Count < Max; Count++)
+				{
+					Items[Count] = Queue->Buffer[Queue->First];
+					Queue->First = (Queue->First + 1) & Queue->Mask;
+				}
+
+				Queue->Size -= Max;
+
+				return (UINT32)Max;
+			}
+		#endif // end of USING_QUEUE_RING_BUFFER
+
+		/*
+			The nodes that get emptied are always at the front of the
+			QUEUE, so they come off as one chain starting at First.
+		*/
+		First = (QUEUE_NODE*)(Queue->Head);
+		Nodes = (UINT32)0;
+
+		for(Count = (UINT32)0; Count < Max; )
+		{
+			#if (USING_QUEUE_SEGMENTED_NODES == 1)
+				while(Count < Max && Queue->Head->First < Queue->Head->Last)
+					Items[Count++] = Queue->Head->Data[Queue->Head->First++];
+
+				// A partly removed node stays in the QUEUE.
+				if(Queue->Head->First < Queue->Head->Last)
+					break;
+			#else
+				Items[Count++] = Queue->Head->Data;
+			#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+			Queue->Head = (QUEUE_NODE*)(Queue->Head->Next);
+			Nodes++;
+		}
+
+		if(Queue->Head == (QUEUE_NODE*)NULL)
+			Queue->Tail = (QUEUE_NODE*)NULL;
+
+		Queue->Size -= Count;
+
+		if(Nodes)
+			QueueFreeNodes(Queue, First, Nodes);
+
+		return (UINT32)Count;
+	}
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+#if (USING_QUEUE_PEEK_METHOD == 1)
+	static void *QueuePeekData(QUEUE *Queue)
+	{
+		#if (USING_QUEUE_PRIORITY == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+				return (void*)(Queue->Heap[0].Data);
+		#endif // end of USING_QUEUE_PRIORITY
+
+		#if (USING_QUEUE_RING_BUFFER == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+				return (void*)(Queue->Buffer[Queue->First]);
+		#endif // end of USING_QUEUE_RING_BUFFER
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			return (void*)(Queue->Head->Data[Queue->Head->First]);
+		#else
+			return (void*)(Queue->Head->Data);
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+	}
+#endif // end of USING_QUEUE_PEEK_METHOD
+
+#if (USING_QUEUE_CLEAR_METHOD == 1)
+	static void QueueClearData(QUEUE *Queue)
+	{
+		UINT32 Nodes;
+
+		#if (USING_QUEUE_DEPENDENT_FREE_METHOD == 1 || USING_QUEUE_SEGMENTED_NODES == 1)
+			QUEUE_NODE *Node;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD || USING_QUEUE_SEGMENTED_NODES
+
+		#if (USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			QUEUE_NODE *Next;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		#if (USING_QUEUE_DEPENDENT_FREE_METHOD == 1 && USING_QUEUE_SEGMENTED_NODES == 1)
+			UINT32 i;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD && USING_QUEUE_SEGMENTED_NODES
+
+		QueueStatsCleared(Queue, Queue->Size);
+
+		#if (USING_QUEUE_PRIORITY == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			{
+				#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+					if(Queue->QueueFreeMethod)
+					{
+						for(; Queue->Size; Queue->Size--)
+							Queue->QueueFreeMethod(Queue->Heap[Queue->Size - 1].Data);
+					}
+				#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+				// The heap stays with the QUEUE, it is only emptied.
+				Queue->Size = (UINT32)0;
+
+				return;
+			}
+		#endif // end of USING_QUEUE_PRIORITY
+
+		#if (USING_QUEUE_RING_BUFFER == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+			{
+				#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+					if(Queue->QueueFreeMethod)
+					{
+						for(; Queue->Size; Queue->Size--, Queue->First = (Queue->First + 1) & Queue->Mask)
+							Queue->QueueFreeMethod(Queue->Buffer[Queue->First]);
+					}
+				#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+				// The array stays with the QUEUE, it is only emptied.
+				Queue->Size = Queue->First = (UINT32)0;
+
+				return;
+			}
+		#endif // end of USING_QUEUE_RING_BUFFER
+
+		#if (USING_QUEUE_TIMER == 1)
+			// Timers that are not due yet go along with the rest.
+			if(QueueIsTimerQueue(Queue))
+				QueueTimerClear(Queue);
+		#endif // end of USING_QUEUE_TIMER
+
+		if(Queue->Head == (QUEUE_NODE*)NULL)
+			return;
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			Nodes = (UINT32)0;
+		#else
+			Nodes = Queue->Size;
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+		/*
+			Free the data first, then hand every QUEUE_NODE back at once.
+		*/
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+			{
+				// Step past each node before its data is freed, an intrusive node lives inside it.
+				for(Node = Queue->Head; Node != (QUEUE_NODE*)NULL; Node = Next)
+				{
+					Next = (QUEUE_NODE*)(Node->Next);
+
+					#if (USING_QUEUE_SEGMENTED_NODES == 1)
+						for(i = Node->First; i < Node->Last; i++)
+							Queue->QueueFreeMethod((void*)(Node->Data[i]));
+
+						Nodes++;
+					#else
+						Queue->QueueFreeMethod((void*)(Node->Data));
+					#endif // end of USING_QUEUE_SEGMENTED_NODES
+				}
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			// Each node holds several pieces of data, so count them if nobody did.
+			if(Nodes == (UINT32)0)
+			{
+				for(Node = Queue->Head; Node != (QUEUE_NODE*)NULL; Node = Node->Next)
+					Nodes++;
+			}
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+		QueueFreeNodes(Queue, Queue->Head, Nodes);
+
+		Queue->Head = Queue->Tail = (QUEUE_NODE*)NULL;
+
+		// The size is now 0 since the QUEUE is empty.
+		Queue->Size = (UINT32)0;	
+	}
+#endif // end of USING_QUEUE_CLEAR_METHOD
+
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	/*
+		Returns TRUE if QueueAdd() would not fail because the QUEUE
+		is full.  The QUEUE's lock must be held.
+	*/
+	static BOOL QueueHasRoom(QUEUE *Queue)
+	{
+		#if (USING_QUEUE_RING_BUFFER == 0 && USING_QUEUE_BOUNDED == 0)
+			(void)Queue;
+		#endif // end of !USING_QUEUE_RING_BUFFER && !USING_QUEUE_BOUNDED
+
+		#if (USING_QUEUE_RING_BUFFER == 1)
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+				return (BOOL)(Queue->Size <= Queue->Mask);
+		#endif // end of USING_QUEUE_RING_BUFFER
+
+		#if (USING_QUEUE_BOUNDED == 1)
+			// A dropping policy always has room, it makes its own.
+			if(Queue->Limit && Queue->Size >= Queue->Limit)
+				return (BOOL)(Queue->Policy == (BYTE)QUEUE_OVERFLOW_DROP_OLDEST || Queue->Policy == (BYTE)QUEUE_OVERFLOW_DROP_NEWEST);
+		#endif // end of USING_QUEUE_BOUNDED
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Wakes a thread waiting for room after one piece of data was
+		removed.  That may not be enough for a waiting batch, so while
+		one waits they are all woken and whoever fits goes ahead.
+	*/
+	#if (USING_QUEUE_BOUNDED == 1)
+		#define QueueSignalRoom(Queue)					do { if(Queue->BatchWaiters) QueueConditionBroadcast(&(Queue->NotFull)); else if(Queue->FullWaiters) QueueConditionSignal(&(Queue->NotFull)); } while(0)
+	#else
+		#define QueueSignalRoom(Queue)					do { if(Queue->FullWaiters) QueueConditionSignal(&(Queue->NotFull)); } while(0)
+	#endif // end of USING_QUEUE_BOUNDED
+
+	/*
+		Waits on Condition until it is signaled or until Timeout
+		milliseconds have passed since Start.  Returns FALSE once
+		the time is up.  The QUEUE's lock must be held, Waiters is
+		the count of threads waiting on Condition.
+	*/
+	static BOOL QueueWait(QUEUE *Queue, QUEUE_CONDITION *Condition, UINT32 *Waiters, UINT32 Start, UINT32 Timeout)
+	{
+		UINT32 Elapsed;
+
+		#if (USING_QUEUE_TIMER == 1)
+			UINT32 Deadline;
+		#endif // end of USING_QUEUE_TIMER
+
+		if(Timeout != (UINT32)QUEUE_WAIT_FOREVER)
+		{
+			Elapsed = (UINT32)(QueueGetTickCount() - Start);
+
+			if(Elapsed >= Timeout)
+				return (BOOL)FALSE;
+
+			Timeout -= Elapsed;
+		}
+
+		#if (USING_QUEUE_TIMER == 1)
+			// Nobody signals when a timer comes due, so wake up for it.
+			if(QueueIsTimerQueue(Queue) && Condition == &(Queue->NotEmpty) && QueueTimerNext(Queue->Wheel, &Deadline))
+			{
+				Deadline -= Queue->Wheel->Current;
+
+				if(Timeout == (UINT32)QUEUE_WAIT_FOREVER || Deadline < Timeout)
+					Timeout = Deadline;
+			}
+		#endif // end of USING_QUEUE_TIMER
+
+		// Nodes collected for another thread would be stuck while this one sleeps.
+		QueueNodeCacheIdle();
+
+		// Only a registered waiter is ever signaled.
+		(*Waiters)++;
+
+		QueueConditionWait(Condition, &(Queue->Lock), Timeout);
+
+		(*Waiters)--;
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+BOOL QueueAdd(QUEUE *Queue, const void *Data)
+{
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		BOOL Added;
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	#if (QUEUE_SAFE_MODE == 1)
+		if(QueueIsNull(Queue))
+			return (BOOL)FALSE;
+	#endif // end of QUEUE_SAFE_MODE
+
+	#if (USING_QUEUE_BOUNDED == 1 && USING_QUEUE_BLOCKING_METHODS == 1)
+		if(Queue->Policy == (BYTE)QUEUE_OVERFLOW_BLOCK)
+			return QueueAddWait(Queue, Data, (UINT32)QUEUE_WAIT_FOREVER);
+	#endif // end of USING_QUEUE_BOUNDED && USING_QUEUE_BLOCKING_METHODS
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		QueueLock(&(Queue->Lock));
+
+		Added = (Queue->Closed) ? (BOOL)FALSE : QueueInsertBounded(Queue, Data);
+
+		// Only pay for a wakeup when a consumer is actually waiting.
+		if(Added && Queue->EmptyWaiters)
+			QueueConditionSignal(&(Queue->NotEmpty));
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)Added;
+	#else
+		return QueueInsertBounded(Queue, Data);
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+}
+
+#if (USING_QUEUE_PRIORITY == 1)
+	BOOL QueueAddWithPriority(QUEUE *Queue, const void *Data, UINT32 Priority)
+	{
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			BOOL Added;
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || Queue->Type != (BYTE)QUEUE_TYPE_PRIORITY)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			Added = (Queue->Closed) ? (BOOL)FALSE : QueueHeapInsert(Queue, Data, Priority);
+
+			if(Added && Queue->EmptyWaiters)
+				QueueConditionSignal(&(Queue->NotEmpty));
+
+			QueueUnlock(&(Queue->Lock));
+
+			return (BOOL)Added;
+		#else
+			return QueueHeapInsert(Queue, Data, Priority);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+	}
+#endif // end of USING_QUEUE_PRIORITY
+
+void *QueueRemove(QUEUE *Queue)
+{
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		void *Data;
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	#if (QUEUE_SAFE_MODE == 1)
+		if(QueueIsNull(Queue) || QueueIsCopyQueue(Queue))
+			return (void*)NULL;
+	#endif // end of QUEUE_SAFE_MODE
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		QueueLock(&(Queue->Lock));
+
+		QueueTimerAdvance(Queue);
+
+		if(QueueIsEmpty(Queue))
+		{
+			QueueStatsCount(Queue, EmptyRemoves);
+			QueueNodeCacheIdle();
+			QueueEventRearm(Queue);
+
+			QueueUnlock(&(Queue->Lock));
+
+			return (void*)NULL;
+		}
+
+		Data = QueueExtractData(Queue);
+
+		QueueSignalRoom(Queue);
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (void*)Data;
+	#else
+		QueueTimerAdvance(Queue);
+
+		// Nothing outside can tell whether a timer QUEUE has anything due.
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsEmpty(Queue))
+		#else
+			if(QueueIsTimerQueue(Queue) && QueueIsEmpty(Queue))
+		#endif // end of QUEUE_SAFE_MODE
+			{
+				QueueStatsCount(Queue, EmptyRemoves);
+				QueueNodeCacheIdle();
+				QueueEventRearm(Queue);
+
+				return (void*)NULL;
+			}
+
+		return QueueExtractData(Queue);
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+}
+
+#if (USING_QUEUE_COPY == 1)
+	BOOL QueueAddCopy(QUEUE *Queue, const void *Element)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || !QueueIsCopyQueue(Queue) || Element == (const void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// QueueAdd() already copies the element for a copy QUEUE.
+		return QueueAdd(Queue, Element);
+	}
+
+	BOOL QueueRemoveInto(QUEUE *Queue, void *Element)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || !QueueIsCopyQueue(Queue) || Element == (void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		if(QueueIsEmpty(Queue))
+		{
+			QueueStatsCount(Queue, EmptyRemoves);
+			QueueNodeCacheIdle();
+			QueueEventRearm(Queue);
+
+			#if (USING_QUEUE_BLOCKING_METHODS == 1)
+				QueueUnlock(&(Queue->Lock));
+			#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+			return (BOOL)FALSE;
+		}
+
+		// Copy the element out before its node is freed.
+		memcpy(Element, Queue->Head->Data, Queue->ElementSize);
+
+		QueueExtractData(Queue);
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueSignalRoom(Queue);
+
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_COPY
+
+#if (USING_QUEUE_PEEK_METHOD == 1)
+	void *QueuePeek(QUEUE *Queue)
+	{
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			void *Data;
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			QueueTimerAdvance(Queue);
+
+			Data = (QueueIsEmpty(Queue)) ? (void*)NULL : QueuePeekData(Queue);
+
+			QueueUnlock(&(Queue->Lock));
+
+			return (void*)Data;
+		#else
+			QueueTimerAdvance(Queue);
+
+			#if (QUEUE_SAFE_MODE == 1)
+				if(QueueIsEmpty(Queue))	
+			#else
+				if(QueueIsTimerQueue(Queue) && QueueIsEmpty(Queue))
+			#endif // end of QUEUE_SAFE_MODE
+					return (void*)NULL;
+
+			return QueuePeekData(Queue);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+	}
+#endif // end of USING_QUEUE_PEEK_METHOD
+
+#if (USING_QUEUE_CLEAR_METHOD == 1)
+	BOOL QueueClear(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			if(!QueueIsEmpty(Queue))
+			{
+				QueueClearData(Queue);
+
+				if(Queue->FullWaiters)
+					QueueConditionBroadcast(&(Queue->NotFull));
+			}
+
+			QueueUnlock(&(Queue->Lock));
+		#else
+			#if (QUEUE_SAFE_MODE == 1)
+				if(QueueIsEmpty(Queue))
+					return (BOOL)TRUE;
+			#endif // end of QUEUE_SAFE_MODE
+
+			QueueClearData(Queue);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_CLEAR_METHOD
+
+#if (USING_QUEUE_DEFERRED_CLEAR == 1)
+	#include "string.h"
+
+	/*
+		Everything handed over by QueueClearDeferred(), each entry a
+		copy of the QUEUE it was detached from, waiting to be freed.
+	*/
+	static QUEUE QueueReclaimList;
+	static QUEUE_THREAD QueueReclaimerThread;
+	static BOOL QueueReclaimListCreated = (BOOL)FALSE;
+
+	/*
+		Read by QueueClearDeferred() on any thread, so only ever
+		accessed atomically.
+	*/
+	static BOOL QueueReclaimerRunning = (BOOL)FALSE;
+
+	/*
+		The reclaimer thread.  Frees whatever shows up on the list
+		until QueueStopReclaimer() closes it and it runs dry.
+	*/
+	static QUEUE_THREAD_RESULT QueueReclaimer(void *Argument)
+	{
+		QUEUE *Contents;
+
+		(void)Argument;
+
+		while((Contents = (QUEUE*)QueueRemoveWait(&QueueReclaimList, (UINT32)QUEUE_WAIT_FOREVER)) != (QUEUE*)NULL)
+		{
+			QueueClearData(Contents);
+
+			QueueMemDealloc((void*)Contents); // MemDealloc defined in QueueConfig.h
+		}
+
+		return (QUEUE_THREAD_RESULT)0;
+	}
+
+	BOOL QueueStartReclaimer(void)
+	{
+		if(QueueAtomicLoadAcquire(&QueueReclaimerRunning))
+			return (BOOL)FALSE;
+
+		/*
+			The list is only created once, a QueueClearDeferred() that
+			saw the last reclaimer running may still be using its lock.
+		*/
+		if(!QueueReclaimListCreated)
+		{
+			CreateQueue(&QueueReclaimList, (void(*)(void*))NULL);
+
+			QueueReclaimListCreated = (BOOL)TRUE;
+		}
+		else
+		{
+			QueueLock(&(QueueReclaimList.Lock));
+
+			QueueReclaimList.Closed = (BOOL)FALSE;
+
+			QueueUnlock(&(QueueReclaimList.Lock));
+		}
+
+		if(!QueueThreadCreate(&QueueReclaimerThread, QueueReclaimer))
+		{
+			QueueClose(&QueueReclaimList);
+
+			return (BOOL)FALSE;
+		}
+
+		QueueAtomicStoreRelease(&QueueReclaimerRunning, (BOOL)TRUE);
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL QueueStopReclaimer(void)
+	{
+		if(!QueueAtomicLoadAcquire(&QueueReclaimerRunning))
+			return (BOOL)FALSE;
+
+		QueueAtomicStoreRelease(&QueueReclaimerRunning, (BOOL)FALSE);
+
+		// The reclaimer empties the list before it sees it closed.
+		QueueClose(&QueueReclaimList);
+
+		QueueThreadJoin(QueueReclaimerThread);
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL QueueClearDeferred(QUEUE *Queue)
+	{
+		QUEUE *Contents;
+		BOOL Detached;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Contents = (QUEUE*)NULL;
+
+		// Allocate the copy before taking the lock, a timer QUEUE can't hand its wheel over.
+		if(QueueAtomicLoadAcquire(&QueueReclaimerRunning) && !QueueIsTimerQueue(Queue))
+			Contents = (QUEUE*)QueueMemAlloc(sizeof(QUEUE)); // MemAlloc defined in QueueConfig.h
+
+		if(Contents == (QUEUE*)NULL)
+			return QueueClear(Queue);
+
+		Detached = (BOOL)FALSE;
+
+		QueueLock(&(Queue->Lock));
+
+		/*
+			Only the QUEUE_NODE chain of a linked QUEUE can be detached,
+			a ring or priority QUEUE keeps its array and is cleared below.
+		*/
+		if(Queue->Head != (QUEUE_NODE*)NULL)
+		{
+			QueueStatsCleared(Queue, Queue->Size);
+
+			// Only what QueueClearData() needs, never the lock or conditions.
+			memset((void*)Contents, 0, sizeof(QUEUE));
+
+			Contents->Head = Queue->Head;
+			Contents->Tail = Queue->Tail;
+			Contents->Size = Queue->Size;
+
+			#if (USING_QUEUE_TYPES == 1)
+				Contents->Type = Queue->Type;
+			#endif // end of USING_QUEUE_TYPES
+
+			#if (USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+				Contents->QueueFreeMethod = Queue->QueueFreeMethod;
+			#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+			Queue->Head = Queue->Tail = (QUEUE_NODE*)NULL;
+			Queue->Size = (UINT32)0;
+
+			Detached = (BOOL)TRUE;
+
+			if(Queue->FullWaiters)
+				QueueConditionBroadcast(&(Queue->NotFull));
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		if(!Detached)
+		{
+			QueueMemDealloc((void*)Contents); // MemDealloc defined in QueueConfig.h
+
+			return QueueClear(Queue);
+		}
+
+		// Once the reclaimer is stopping the caller frees the data itself.
+		if(!QueueAdd(&QueueReclaimList, (const void*)Contents))
+		{
+			QueueClearData(Contents);
+
+			QueueMemDealloc((void*)Contents); // MemDealloc defined in QueueConfig.h
+		}
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	BOOL QueueAddBatch(QUEUE *Queue, const void **Items, UINT32 Count)
+	{
+		BOOL Added;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || Items == (const void**)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if(Count == (UINT32)0)
+			return (BOOL)TRUE;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			#if (USING_QUEUE_BOUNDED == 1)
+				// Like QueueAdd(), wait until the whole batch fits.  One that never can fails below.
+				if(Queue->Policy == (BYTE)QUEUE_OVERFLOW_BLOCK && Count <= Queue->Limit)
+				{
+					Queue->BatchWaiters++;
+
+					while(!QueueFits(Queue, Count) && !Queue->Closed)
+						QueueWait(Queue, &(Queue->NotFull), &(Queue->FullWaiters), (UINT32)0, (UINT32)QUEUE_WAIT_FOREVER);
+
+					Queue->BatchWaiters--;
+				}
+			#endif // end of USING_QUEUE_BOUNDED
+
+			Added = (Queue->Closed) ? (BOOL)FALSE : QueueInsertBatch(Queue, Items, Count);
+
+			if(Added && Queue->EmptyWaiters)
+			{
+				if(Count == (UINT32)1)
+					QueueConditionSignal(&(Queue->NotEmpty));
+				else
+					QueueConditionBroadcast(&(Queue->NotEmpty));
+			}
+
+			QueueUnlock(&(Queue->Lock));
+		#else
+			Added = QueueInsertBatch(Queue, Items, Count);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Added;
+	}
+
+	UINT32 QueueRemoveBatch(QUEUE *Queue, void **Items, UINT32 Max)
+	{
+		UINT32 Count;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || QueueIsCopyQueue(Queue) || Items == (void**)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+
+			QueueTimerAdvance(Queue);
+
+			Count = QueueExtractBatch(Queue, Items, Max);
+
+			if(Count && Queue->FullWaiters)
+				QueueConditionBroadcast(&(Queue->NotFull));
+
+			QueueUnlock(&(Queue->Lock));
+		#else
+			QueueTimerAdvance(Queue);
+
+			Count = QueueExtractBatch(Queue, Items, Max);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (UINT32)Count;
+	}
+
+	void **QueueDrain(QUEUE *Queue, UINT32 *Count)
+	{
+		void **Items;
+		QUEUE Detached;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || QueueIsCopyQueue(Queue) || Count == (UINT32*)NULL)
+				return (void**)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		*Count = (UINT32)0;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		QueueTimerAdvance(Queue);
+
+		Items = (void**)NULL;
+
+		if(!QueueIsEmpty(Queue))
+			Items = (void**)QueueMemAlloc(Queue->Size * sizeof(void*)); // MemAlloc defined in QueueConfig.h
+		else
+		{
+			QueueStatsCount(Queue, EmptyRemoves);
+			QueueNodeCacheIdle();
+			QueueEventRearm(Queue);
+		}
+
+		if(Items == (void**)NULL)
+		{
+			#if (USING_QUEUE_BLOCKING_METHODS == 1)
+				QueueUnlock(&(Queue->Lock));
+			#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+			return (void**)NULL;
+		}
+
+		#if (USING_QUEUE_RING_BUFFER == 1 || USING_QUEUE_PRIORITY == 1)
+			// Only the nodes of a linked QUEUE can be detached.
+			if(Queue->Type == (BYTE)QUEUE_TYPE_RING || Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			{
+				*Count = QueueExtractBatch(Queue, Items, Queue->Size);
+
+				QueueEventRearm(Queue);
+
+				#if (USING_QUEUE_BLOCKING_METHODS == 1)
+					if(Queue->FullWaiters)
+						QueueConditionBroadcast(&(Queue->NotFull));
+
+					QueueUnlock(&(Queue->Lock));
+				#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+				return (void**)Items;
+			}
+		#endif // end of USING_QUEUE_RING_BUFFER || USING_QUEUE_PRIORITY
+
+		// Detach every node at once, the nodes are walked outside of the lock.
+		QueueStatsRemoved(Queue, Queue->Size);
+
+		Detached = *Queue;
+
+		Queue->Head = Queue->Tail = (QUEUE_NODE*)NULL;
+		Queue->Size = (UINT32)0;
+
+		// Drained empty, so the next add has to signal again.
+		QueueEventRearm(Queue);
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			if(Queue->FullWaiters)
+				QueueConditionBroadcast(&(Queue->NotFull));
+
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		*Count = QueueExtractBatch(&Detached, Items, Detached.Size);
+
+		return (void**)Items;
+	}
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+#if (USING_QUEUE_SPLICE_METHODS == 1)
+	/*
+		TRUE if the QUEUE_NODE's of one QUEUE can be linked into the
+		other.  Only linked QUEUE's of the same kind qualify.
+	*/
+	static BOOL QueueCanSplice(QUEUE *First, QUEUE *Second)
+	{
+		#if (USING_QUEUE_TYPES == 1)
+			if(First->Type != Second->Type)
+				return (BOOL)FALSE;
+
+			#if (USING_QUEUE_RING_BUFFER == 1)
+				if(First->Type == (BYTE)QUEUE_TYPE_RING)
+					return (BOOL)FALSE;
+			#endif // end of USING_QUEUE_RING_BUFFER
+
+			#if (USING_QUEUE_PRIORITY == 1)
+				if(First->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+					return (BOOL)FALSE;
+			#endif // end of USING_QUEUE_PRIORITY
+
+			#if (USING_QUEUE_INTRUSIVE == 1)
+				if(First->Type == (BYTE)QUEUE_TYPE_INTRUSIVE && First->NodeOffset != Second->NodeOffset)
+					return (BOOL)FALSE;
+			#endif // end of USING_QUEUE_INTRUSIVE
+
+			#if (USING_QUEUE_COPY == 1)
+				if(First->Type == (BYTE)QUEUE_TYPE_COPY && First->ElementSize != Second->ElementSize)
+					return (BOOL)FALSE;
+			#endif // end of USING_QUEUE_COPY
+		#else
+			// Without QUEUE types every QUEUE is linked the same way.
+			(void)First;
+			(void)Second;
+		#endif // end of USING_QUEUE_TYPES
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Links the chain of QUEUE_NODE's from First to Last, holding
+		Count pieces of data, onto the end of Queue.
+	*/
+	static void QueueSpliceChain(QUEUE *Queue, QUEUE_NODE *First, QUEUE_NODE *Last, UINT32 Count)
+	{
+		Last->Next = (QUEUE_NODE*)NULL;
+
+		if(QueueIsEmpty(Queue))
+			Queue->Head = (QUEUE_NODE*)First;
+		else
+			Queue->Tail->Next = (QUEUE_NODE*)First;
+
+		Queue->Tail = (QUEUE_NODE*)Last;
+		Queue->Size += Count;
+
+		QueueStatsAdded(Queue, Count);
+		QueueEventRaise(Queue);
+	}
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		/*
+			Takes the locks of two QUEUE's, always in the same order so
+			two threads moving data between the same pair can't deadlock.
+		*/
+		static void QueueLockPair(QUEUE *First, QUEUE *Second)
+		{
+			if(First < Second)
+			{
+				QueueLock(&(First->Lock));
+				QueueLock(&(Second->Lock));
+			}
+			else
+			{
+				QueueLock(&(Second->Lock));
+				QueueLock(&(First->Lock));
+			}
+		}
+
+		/*
+			Wakes whoever waits for what just happened to Queue and
+			releases its lock.
+		*/
+		static void QueueUnlockAfterSplice(QUEUE *Queue)
+		{
+			if(!QueueIsEmpty(Queue) && Queue->EmptyWaiters)
+				QueueConditionBroadcast(&(Queue->NotEmpty));
+
+			if(Queue->FullWaiters)
+				QueueConditionBroadcast(&(Queue->NotFull));
+
+			QueueUnlock(&(Queue->Lock));
+		}
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	BOOL QueueAppendQueue(QUEUE *Destination, QUEUE *Source)
+	{
+		BOOL Appended;
+		UINT32 Count;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Destination) || QueueIsNull(Source) || Destination == Source)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLockPair(Destination, Source);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		Appended = (BOOL)(QueueCanSplice(Destination, Source) && QueueFits(Destination, Source->Size));
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			if(Destination->Closed)
+				Appended = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		if(Appended && !QueueIsEmpty(Source))
+		{
+			Count = Source->Size;
+
+			QueueStatsRemoved(Source, Count);
+
+			QueueSpliceChain(Destination, Source->Head, Source->Tail, Count);
+
+			Source->Head = Source->Tail = (QUEUE_NODE*)NULL;
+			Source->Size = (UINT32)0;
+		}
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlockAfterSplice(Destination);
+			QueueUnlockAfterSplice(Source);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Appended;
+	}
+
+	BOOL QueueSwap(QUEUE *First, QUEUE *Second)
+	{
+		QUEUE Temp;
+		BOOL Swapped;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(First) || QueueIsNull(Second))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if(First == Second)
+			return (BOOL)TRUE;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLockPair(First, Second);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		#if (USING_QUEUE_TYPES == 1)
+			Swapped = (BOOL)(First->Type == Second->Type);
+		#else
+			Swapped = (BOOL)TRUE;
+		#endif // end of USING_QUEUE_TYPES
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			if(First->Closed || Second->Closed)
+				Swapped = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		#if (USING_QUEUE_BOUNDED == 1)
+			// The limits stay with their QUEUE's, so the data has to fit under them.
+			if((First->Limit && Second->Size > First->Limit) || (Second->Limit && First->Size > Second->Limit))
+				Swapped = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_BOUNDED
+
+		if(Swapped)
+		{
+			/*
+				Only the fields that describe the data trade places, the
+				locks, waiters, free methods and statistics stay put.
+			*/
+			Temp.Head = First->Head;
+			Temp.Tail = First->Tail;
+			Temp.Size = First->Size;
+
+			First->Head = Second->Head;
+			First->Tail = Second->Tail;
+			First->Size = Second->Size;
+
+			Second->Head = Temp.Head;
+			Second->Tail = Temp.Tail;
+			Second->Size = Temp.Size;
+
+			#if (USING_QUEUE_RING_BUFFER == 1)
+				Temp.Buffer = First->Buffer;
+				Temp.Mask = First->Mask;
+				Temp.First = First->First;
+
+				First->Buffer = Second->Buffer;
+				First->Mask = Second->Mask;
+				First->First = Second->First;
+
+				Second->Buffer = Temp.Buffer;
+				Second->Mask = Temp.Mask;
+				Second->First = Temp.First;
+			#endif // end of USING_QUEUE_RING_BUFFER
+
+			#if (USING_QUEUE_INTRUSIVE == 1)
+				Temp.NodeOffset = First->NodeOffset;
+				First->NodeOffset = Second->NodeOffset;
+				Second->NodeOffset = Temp.NodeOffset;
+			#endif // end of USING_QUEUE_INTRUSIVE
+
+			#if (USING_QUEUE_COPY == 1)
+				Temp.ElementSize = First->ElementSize;
+				First->ElementSize = Second->ElementSize;
+				Second->ElementSize = Temp.ElementSize;
+			#endif // end of USING_QUEUE_COPY
+
+			#if (USING_QUEUE_PRIORITY == 1)
+				Temp.Heap = First->Heap;
+				Temp.Capacity = First->Capacity;
+				Temp.Sequence = First->Sequence;
+
+				First->Heap = Second->Heap;
+				First->Capacity = Second->Capacity;
+				First->Sequence = Second->Sequence;
+
+				Second->Heap = Temp.Heap;
+				Second->Capacity = Temp.Capacity;
+				Second->Sequence = Temp.Sequence;
+			#endif // end of USING_QUEUE_PRIORITY
+
+			#if (USING_QUEUE_TIMER == 1)
+				Temp.Wheel = First->Wheel;
+				First->Wheel = Second->Wheel;
+				Second->Wheel = Temp.Wheel;
+			#endif // end of USING_QUEUE_TIMER
+
+			QueueStatsSwapped(First);
+			QueueStatsSwapped(Second);
+
+			QueueEventRaise(First);
+			QueueEventRaise(Second);
+		}
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlockAfterSplice(First);
+			QueueUnlockAfterSplice(Second);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Swapped;
+	}
+
+	BOOL QueueSplitAfter(QUEUE *Queue, UINT32 Count, QUEUE *Out)
+	{
+		QUEUE_NODE *Node, *Rest;
+		UINT32 Moved, Skipped;
+		BOOL Split;
+
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			UINT32 i;
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || QueueIsNull(Out) || Queue == Out)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLockPair(Queue, Out);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		Split = (BOOL)(QueueCanSplice(Queue, Out) && (Count >= Queue->Size || QueueFits(Out, Queue->Size - Count)));
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			if(Out->Closed)
+				Split = (BOOL)FALSE;
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		if(Split && Count < Queue->Size)
+		{
+			Moved = Queue->Size - Count;
+
+			if(Count == (UINT32)0)
+			{
+				// Everything moves, no need to walk.
+				Node = (QUEUE_NODE*)NULL;
+				Rest = Queue->Head;
+			}
+			else
+			{
+				// Find the node holding the Count'th piece of data.
+				#if (USING_QUEUE_SEGMENTED_NODES == 1)
+					for(Node = Queue->Head, Skipped = Node->Last - Node->First; Skipped < Count; Skipped += Node->Last - Node->First)
+						Node = Node->Next;
+
+					Skipped = Node->Last - (Skipped - Count);
+
+					// The split falls inside the node, its end goes into a node of its own.
+					if(Skipped < Node->Last)
+					{
+						if((Rest = (QUEUE_NODE*)QueueAllocNode(Queue, (const void*)NULL)) == (QUEUE_NODE*)NULL)
+						{
+							QueueStatsCount(Queue, AllocationFailures);
+
+							Split = (BOOL)FALSE;
+						}
+						else
+						{
+							for(i = (UINT32)0; Skipped < Node->Last; i++)
+								Rest->Data[i] = Node->Data[Skipped++];
+
+							Rest->First = (UINT32)0;
+							Rest->Last = (UINT32)i;
+							Rest->Next = Node->Next;
+
+							Node->Last -= i;
+
+							if(Node == Queue->Tail)
+								Queue->Tail = (QUEUE_NODE*)Rest;
+						}
+					}
+					else
+						Rest = Node->Next;
+				#else
+					for(Node = Queue->Head, Skipped = (UINT32)1; Skipped < Count; Skipped++)
+						Node = Node->Next;
+
+					Rest = Node->Next;
+				#endif // end of USING_QUEUE_SEGMENTED_NODES
+			}
+
+			if(Split)
+			{
+				QueueStatsMovedOut(Queue, Moved);
+
+				QueueSpliceChain(Out, Rest, Queue->Tail, Moved);
+
+				if(Node == (QUEUE_NODE*)NULL)
+					Queue->Head = (QUEUE_NODE*)NULL;
+				else
+					Node->Next = (QUEUE_NODE*)NULL;
+
+				Queue->Tail = (QUEUE_NODE*)Node;
+				Queue->Size = Count;
+			}
+		}
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlockAfterSplice(Out);
+			QueueUnlockAfterSplice(Queue);
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)Split;
+	}
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	void *QueueRemoveWait(QUEUE *Queue, UINT32 Timeout)
+	{
+		void *Data;
+		UINT32 Start;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || QueueIsCopyQueue(Queue))
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Data = (void*)NULL;
+		Start = (UINT32)QueueGetTickCount();
+
+		QueueLock(&(Queue->Lock));
+
+		QueueTimerAdvance(Queue);
+
+		// A closed QUEUE can still be drained, but nobody waits on it.
+		while(QueueIsEmpty(Queue) && !Queue->Closed)
+		{
+			if(QueueWait(Queue, &(Queue->NotEmpty), &(Queue->EmptyWaiters), Start, Timeout) == (BOOL)FALSE)
+				break;
+
+			QueueTimerAdvance(Queue);
+		}
+
+		if(!QueueIsEmpty(Queue))
+		{
+			Data = QueueExtractData(Queue);
+
+			QueueSignalRoom(Queue);
+		}
+		else
+		{
+			QueueStatsCount(Queue, EmptyRemoves);
+			QueueNodeCacheIdle();
+			QueueEventRearm(Queue);
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (void*)Data;
+	}
+
+	BOOL QueueAddWait(QUEUE *Queue, const void *Data, UINT32 Timeout)
+	{
+		BOOL Added;
+		UINT32 Start;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Added = (BOOL)FALSE;
+		Start = (UINT32)QueueGetTickCount();
+
+		QueueLock(&(Queue->Lock));
+
+		while(!QueueHasRoom(Queue) && !Queue->Closed)
+		{
+			if(QueueWait(Queue, &(Queue->NotFull), &(Queue->FullWaiters), Start, Timeout) == (BOOL)FALSE)
+				break;
+		}
+
+		if(!Queue->Closed && QueueHasRoom(Queue))
+		{
+			Added = QueueInsertBounded(Queue, Data);
+
+			if(Added && Queue->EmptyWaiters)
+				QueueConditionSignal(&(Queue->NotEmpty));
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)Added;
+	}
+
+	BOOL QueueClose(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueLock(&(Queue->Lock));
+
+		Queue->Closed = (BOOL)TRUE;
+
+		// Release every waiter, they will all see the QUEUE is closed.
+		QueueConditionBroadcast(&(Queue->NotEmpty));
+		QueueConditionBroadcast(&(Queue->NotFull));
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+#if (USING_QUEUE_EVENT_FD == 1)
+	int QueueOpenEventFd(QUEUE *Queue)
+	{
+		int Fd;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return -1;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		if(Queue->EventFd < 0 && (Queue->EventFd = QueueEventCreate()) >= 0)
+		{
+			// Whatever is already in the QUEUE needs a consumer too.
+			Queue->EventSignaled = (BOOL)FALSE;
+
+			QueueEventRaise(Queue);
+		}
+
+		Fd = Queue->EventFd;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return Fd;
+	}
+
+	BOOL QueueCloseEventFd(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		if(Queue->EventFd >= 0)
+			QueueEventClose(Queue->EventFd);
+
+		Queue->EventFd = -1;
+		Queue->EventSignaled = (BOOL)FALSE;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_EVENT_FD
+
+#if (USING_QUEUE_GET_SIZE_METHOD == 1)
+	UINT32 QueueGetSize(QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue))
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		return (UINT32)(Queue->Size);
+	}
+#endif // end of USING_QUEUE_GET_SIZE_METHOD
+
+UINT32 QueueGetSizeInBytes(QUEUE *Queue, UINT32 DataSizeInBytes)
+{
+	UINT32 Size;
+
+	#if (QUEUE_SAFE_MODE == 1)
+		if(QueueIsNull(Queue))
+			return (UINT32)0;
+	#endif // end of QUEUE_SAFE_MODE
+
+	Size = (UINT32)sizeof(QUEUE);
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		// The array of a ring QUEUE is counted in full, no matter how much of it is in use.
+		if(Queue->Type == (BYTE)QUEUE_TYPE_RING)
+			return (UINT32)(Size + (Queue->Mask + 1) * (UINT32)sizeof(void*) + Queue->Size * DataSizeInBytes);
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		// The heap of a priority QUEUE is counted in full, no matter how much of it is in use.
+		if(Queue->Type == (BYTE)QUEUE_TYPE_PRIORITY)
+			return (UINT32)(Size + Queue->Capacity * (UINT32)sizeof(QUEUE_PRIORITY_ENTRY) + Queue->Size * DataSizeInBytes);
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		// The nodes of an intrusive QUEUE are part of the data.
+		if(Queue->Type == (BYTE)QUEUE_TYPE_INTRUSIVE)
+			return (UINT32)(Size + Queue->Size * DataSizeInBytes);
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_COPY == 1)
+		// Each element is stored inline, right behind its node.
+		if(QueueIsCopyQueue(Queue))
+			return (UINT32)(Size + Queue->Size * ((UINT32)sizeof(QUEUE_NODE) + Queue->ElementSize));
+	#endif // end of USING_QUEUE_COPY
+
+	if(QueueIsEmpty(Queue))
+		return (UINT32)Size;
+
+	/*
+		If the user provided us with the size of their data in bytes
+		then we must use it to calculate the size of the QUEUE in bytes.
+		Otherwise we just don't include it in the calculation.
+	*/
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+	{
+		QUEUE_NODE *TempQueueNode;
+
+		// Every node counts in full, no matter how much of it is in use.
+		for(TempQueueNode = Queue->Head; TempQueueNode != (QUEUE_NODE*)NULL; TempQueueNode = TempQueueNode->Next)
+			Size += (UINT32)sizeof(QUEUE_NODE);
+
+		Size += (UINT32)(Queue->Size * DataSizeInBytes);
+	}
+	#else
+		if(DataSizeInBytes)
+			Size += (Queue->Size * (DataSizeInBytes + (UINT32)sizeof(QUEUE_NODE)));
+		else
+			Size += (UINT32)(Queue->Size * (UINT32)sizeof(QUEUE_NODE));
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+	return (UINT32)Size;
+}
+
+#if (USING_QUEUE_STATISTICS == 1)
+	BOOL QueueGetStats(QUEUE *Queue, QUEUE_STATS *Stats)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(QueueIsNull(Queue) || Stats == (QUEUE_STATS*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueLock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		*Stats = Queue->Stats;
+
+		#if (USING_QUEUE_BLOCKING_METHODS == 1)
+			QueueUnlock(&(Queue->Lock));
+		#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+		return (BOOL)TRUE;
+	}
+#endif // end of USING_QUEUE_STATISTICS
+
+#if (USING_QUEUE_NODE_POOL == 1)
+	BOOL QueueNodePoolGetStats(QUEUE_NODE_POOL_STATS *Stats)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Stats == (QUEUE_NODE_POOL_STATS*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueNodePoolLock();
+
+		*Stats = QueueNodePoolStats;
+
+		QueueNodePoolUnlock();
+
+		return (BOOL)TRUE;
+	}
+
+	UINT32 QueueNodePoolShrink(UINT32 MaxFreeNodes)
+	{
+		UINT32 Released;
+
+		QueueNodePoolLock();
+
+		Released = QueueNodePoolShrinkUnsafe(MaxFreeNodes);
+
+		QueueNodePoolUnlock();
+
+		return (UINT32)Released;
+	}
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+	BOOL QueueNodeCacheRelease(void)
+	{
+		QUEUE_NODE_CACHE *Cache;
+
+		if((Cache = QueueNodeCacheSelf) == (QUEUE_NODE_CACHE*)NULL)
+			return (BOOL)FALSE;
+
+		QueueNodeCacheFlush(Cache);
+
+		if(Cache->FreeNodes)
+			QueueNodeCacheGiveBack(Cache, Cache->FreeNodes);
+
+		QueueNodePoolLock();
+
+		QueueAtomicStoreRelaxed(&(Cache->InUse), (BOOL)FALSE);
+
+		QueueNodePoolUnlock();
+
+		// Senders that still saw the cache in use drain it themselves once they see it released.
+		QueueAtomicFence();
+
+		QueueNodeCacheDrain(Cache);
+
+		QueueNodeCacheSelf = (QUEUE_NODE_CACHE*)NULL;
+
+		return (BOOL)TRUE;
+	}
+	#endif // end of USING_QUEUE_NODE_CACHE
+#endif // end of USING_QUEUE_NODE_POOL
+
+#if (USING_QUEUE_SPSC == 1)
+	SPSC_QUEUE *CreateSpscQueue(SPSC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+	{
+		SPSC_QUEUE *TempQueue;
+		UINT32 Size;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Capacity == (UINT32)0 || Capacity > (UINT32)0x80000000)
+				return (SPSC_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the capacity up to a power of two so indexes can wrap with a mask.
+		for(Size = (UINT32)1; Size < Capacity; Size <<= 1);
+
+		TempQueue = (SPSC_QUEUE*)Queue;
+
+		if(TempQueue == (SPSC_QUEUE*)NULL)
+		{
+			if((TempQueue = (SPSC_QUEUE*)QueueMemAlloc(sizeof(SPSC_QUEUE))) == (SPSC_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (SPSC_QUEUE*)NULL;
+			}
+		}
+
+		if((TempQueue->Buffer = (void**)QueueMemAlloc(Size * sizeof(void*))) == (void**)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			if(Queue == (SPSC_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (SPSC_QUEUE*)NULL;
+		}
+
+		TempQueue->Mask = (UINT32)(Size - 1);
+		TempQueue->Head = TempQueue->Tail = (UINT32)0;
+		TempQueue->CachedHead = TempQueue->CachedTail = (UINT32)0;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			TempQueue->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		return (SPSC_QUEUE*)TempQueue;
+	}
+
+	BOOL DestroySpscQueue(SPSC_QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SPSC_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+			{
+				for(; Queue->Head != Queue->Tail; Queue->Head++)
+					Queue->QueueFreeMethod(Queue->Buffer[Queue->Head & Queue->Mask]);
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		QueueMemDealloc((void*)(Queue->Buffer)); // MemDealloc defined in QueueConfig.h
+
+		Queue->Buffer = (void**)NULL;
+		Queue->Mask = Queue->Head = Queue->Tail = (UINT32)0;
+		Queue->CachedHead = Queue->CachedTail = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL SpscQueueAdd(SPSC_QUEUE *Queue, const void *Data)
+	{
+		UINT32 Tail;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SPSC_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Only the producer writes Tail, so it can be read without an atomic.
+		Tail = Queue->Tail;
+
+		/*
+			Only look at the consumer's Head when the cached copy says the
+			QUEUE is full, this keeps the consumer's cache line where it is.
+		*/
+		if(Tail - Queue->CachedHead > Queue->Mask)
+		{
+			Queue->CachedHead = (UINT32)QueueAtomicLoadAcquire(&(Queue->Head));
+
+			if(Tail - Queue->CachedHead > Queue->Mask)
+				return (BOOL)FALSE;
+		}
+
+		Queue->Buffer[Tail & Queue->Mask] = (void*)Data;
+
+		// Publish the data to the consumer.
+		QueueAtomicStoreRelease(&(Queue->Tail), Tail + 1);
+
+		return (BOOL)TRUE;
+	}
+
+	void *SpscQueueRemove(SPSC_QUEUE *Queue)
+	{
+		void *Data;
+		UINT32 Head;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SPSC_QUEUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Only the consumer writes Head, so it can be read without an atomic.
+		Head = Queue->Head;
+
+		if(Head == Queue->CachedTail)
+		{
+			Queue->CachedTail = (UINT32)QueueAtomicLoadAcquire(&(Queue->Tail));
+
+			if(Head == Queue->CachedTail)
+				return (void*)NULL;
+		}
+
+		Data = (void*)(Queue->Buffer[Head & Queue->Mask]);
+
+		// Hand the slot back to the producer.
+		QueueAtomicStoreRelease(&(Queue->Head), Head + 1);
+
+		return (void*)Data;
+	}
+
+	void *SpscQueuePeek(SPSC_QUEUE *Queue)
+	{
+		UINT32 Head;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SPSC_QUEUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Head = Queue->Head;
+
+		if(Head == Queue->CachedTail)
+		{
+			Queue->CachedTail = (UINT32)QueueAtomicLoadAcquire(&(Queue->Tail));
+
+			if(Head == Queue->CachedTail)
+				return (void*)NULL;
+		}
+
+		return (void*)(Queue->Buffer[Head & Queue->Mask]);
+	}
+
+	UINT32 SpscQueueGetSize(SPSC_QUEUE *Queue)
+	{
+		UINT32 Head;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SPSC_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Read Head first so that the result can never go negative.
+		Head = (UINT32)QueueAtomicLoadAcquire(&(Queue->Head));
+
+		return (UINT32)((UINT32)QueueAtomicLoadAcquire(&(Queue->Tail)) - Head);
+	}
+#endif // end of USING_QUEUE_SPSC
+
+#if (USING_QUEUE_RECORD == 1)
+	/*
+		The bytes a record of Length bytes takes, header included.
+	*/
+	#define RecordQueueSpan(Length)						(((UINT32)QUEUE_RECORD_HEADER_SIZE + (UINT32)(Length) + (UINT32)(QUEUE_RECORD_ALIGNMENT - 1)) & ~(UINT32)(QUEUE_RECORD_ALIGNMENT - 1))
+
+	RECORD_QUEUE *CreateRecordQueue(RECORD_QUEUE *Queue, UINT32 Size)
+	{
+		RECORD_QUEUE *TempQueue;
+		UINT32 Bytes;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Size == (UINT32)0 || Size > (UINT32)0x40000000)
+				return (RECORD_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the size up to a power of two so offsets can wrap with a mask.
+		for(Bytes = (UINT32)(QUEUE_RECORD_HEADER_SIZE * 8); Bytes < Size; Bytes <<= 1);
+
+		TempQueue = (RECORD_QUEUE*)Queue;
+
+		if(TempQueue == (RECORD_QUEUE*)NULL)
+		{
+			if((TempQueue = (RECORD_QUEUE*)QueueMemAlloc(sizeof(RECORD_QUEUE))) == (RECORD_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (RECORD_QUEUE*)NULL;
+			}
+		}
+
+		if((TempQueue->Buffer = (BYTE*)QueueMemAlloc(Bytes)) == (BYTE*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			if(Queue == (RECORD_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (RECORD_QUEUE*)NULL;
+		}
+
+		TempQueue->Mask = (UINT32)(Bytes - 1);
+		TempQueue->Head = TempQueue->Tail = (UINT32)0;
+		TempQueue->CachedHead = TempQueue->CachedTail = (UINT32)0;
+		TempQueue->Reserved = (UINT32)0;
+		TempQueue->Committed = TempQueue->Released = (UINT32)0;
+
+		return (RECORD_QUEUE*)TempQueue;
+	}
+
+	BOOL DestroyRecordQueue(RECORD_QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueMemDealloc((void*)(Queue->Buffer)); // MemDealloc defined in QueueConfig.h
+
+		Queue->Buffer = (BYTE*)NULL;
+		Queue->Mask = Queue->Head = Queue->Tail = (UINT32)0;
+		Queue->CachedHead = Queue->CachedTail = (UINT32)0;
+		Queue->Reserved = (UINT32)0;
+		Queue->Committed = Queue->Released = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	void *RecordQueueReserve(RECORD_QUEUE *Queue, UINT32 Length)
+	{
+		UINT32 Tail, Offset, Room, Span, Needed;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (void*)NULL;
+
+			if(Length > ((Queue->Mask + 1) >> 1) - (UINT32)QUEUE_RECORD_HEADER_SIZE)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Span = RecordQueueSpan(Length);
+
+		// Only the producer writes Tail, so it can be read without an atomic.
+		Tail = Queue->Tail;
+		Offset = Tail & Queue->Mask;
+		Room = Queue->Mask + 1 - Offset;
+
+		// A record that doesn't fit before the end of the buffer starts over at the front.
+		Needed = (Span > Room) ? Room + Span : Span;
+
+		if(Tail - Queue->CachedHead + Needed > Queue->Mask + 1)
+		{
+			Queue->CachedHead = (UINT32)QueueAtomicLoadAcquire(&(Queue->Head));
+
+			if(Tail - Queue->CachedHead + Needed > Queue->Mask + 1)
+				return (void*)NULL;
+		}
+
+		if(Span > Room)
+		{
+			*(UINT32*)(Queue->Buffer + Offset) = (UINT32)QUEUE_RECORD_PADDING;
+
+			// The consumer may skip the padding before the record is committed.
+			QueueAtomicStoreRelease(&(Queue->Tail), Tail + Room);
+
+			Offset = (UINT32)0;
+		}
+
+		Queue->Reserved = Span;
+
+		return (void*)(Queue->Buffer + Offset + QUEUE_RECORD_HEADER_SIZE);
+	}
+
+	BOOL RecordQueueCommit(RECORD_QUEUE *Queue, UINT32 Length)
+	{
+		UINT32 Tail;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (BOOL)FALSE;
+
+			// A record may come out shorter than was reserved, never longer.
+			if(Queue->Reserved == (UINT32)0 || RecordQueueSpan(Length) > Queue->Reserved)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Tail = Queue->Tail;
+
+		*(UINT32*)(Queue->Buffer + (Tail & Queue->Mask)) = (UINT32)Length;
+
+		Queue->Reserved = (UINT32)0;
+
+		QueueAtomicStoreRelaxed(&(Queue->Committed), Queue->Committed + 1);
+
+		// Publish the record to the consumer.
+		QueueAtomicStoreRelease(&(Queue->Tail), Tail + RecordQueueSpan(Length));
+
+		return (BOOL)TRUE;
+	}
+
+	void *RecordQueuePeek(RECORD_QUEUE *Queue, UINT32 *Length)
+	{
+		BYTE *Record;
+		UINT32 Head;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Only the consumer writes Head, so it can be read without an atomic.
+		Head = Queue->Head;
+
+		for(;;)
+		{
+			if(Head == Queue->CachedTail)
+			{
+				Queue->CachedTail = (UINT32)QueueAtomicLoadAcquire(&(Queue->Tail));
+
+				if(Head == Queue->CachedTail)
+					return (void*)NULL;
+			}
+
+			Record = Queue->Buffer + (Head & Queue->Mask);
+
+			if(*(UINT32*)Record != (UINT32)QUEUE_RECORD_PADDING)
+				break;
+
+			// Hand the padding at the end of the buffer straight back to the producer.
+			Head += Queue->Mask + 1 - (Head & Queue->Mask);
+
+			QueueAtomicStoreRelease(&(Queue->Head), Head);
+		}
+
+		if(Length != (UINT32*)NULL)
+			*Length = *(UINT32*)Record;
+
+		return (void*)(Record + QUEUE_RECORD_HEADER_SIZE);
+	}
+
+	BOOL RecordQueueRelease(RECORD_QUEUE *Queue)
+	{
+		UINT32 Length;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Cheap after a peek, and it steps over any padding if there was none.
+		if(RecordQueuePeek(Queue, &Length) == (void*)NULL)
+			return (BOOL)FALSE;
+
+		QueueAtomicStoreRelaxed(&(Queue->Released), Queue->Released + 1);
+
+		// Hand the bytes back to the producer.
+		QueueAtomicStoreRelease(&(Queue->Head), Queue->Head + RecordQueueSpan(Length));
+
+		return (BOOL)TRUE;
+	}
+
+	UINT32 RecordQueueGetSize(RECORD_QUEUE *Queue)
+	{
+		UINT32 Released;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (RECORD_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Read Released first so that the result can never go negative.
+		Released = (UINT32)QueueAtomicLoadAcquire(&(Queue->Released));
+
+		return (UINT32)((UINT32)QueueAtomicLoadAcquire(&(Queue->Committed)) - Released);
+	}
+#endif // end of USING_QUEUE_RECORD
+
+#if (USING_QUEUE_MPMC == 1)
+	MPMC_QUEUE *CreateMpmcQueue(MPMC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+	{
+		MPMC_QUEUE *TempQueue;
+		UINT32 Size, i;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Capacity == (UINT32)0 || Capacity > (UINT32)0x80000000)
+				return (MPMC_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the capacity up to a power of two, a single slot can't tell full from empty.
+		for(Size = (UINT32)2; Size < Capacity; Size <<= 1);
+
+		TempQueue = (MPMC_QUEUE*)Queue;
+
+		if(TempQueue == (MPMC_QUEUE*)NULL)
+		{
+			if((TempQueue = (MPMC_QUEUE*)QueueMemAlloc(sizeof(MPMC_QUEUE))) == (MPMC_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (MPMC_QUEUE*)NULL;
+			}
+		}
+
+		if((TempQueue->Buffer = (MPMC_QUEUE_CELL*)QueueMemAlloc(Size * sizeof(MPMC_QUEUE_CELL))) == (MPMC_QUEUE_CELL*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			if(Queue == (MPMC_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (MPMC_QUEUE*)NULL;
+		}
+
+		// Every slot starts out free for the producer of its position.
+		for(i = 0; i < Size; i++)
+			TempQueue->Buffer[i].Sequence = (UINT32)i;
+
+		TempQueue->Mask = (UINT32)(Size - 1);
+		TempQueue->EnqueuePos = TempQueue->DequeuePos = (UINT32)0;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			TempQueue->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		return (MPMC_QUEUE*)TempQueue;
+	}
+
+	BOOL DestroyMpmcQueue(MPMC_QUEUE *Queue)
+	{
+		void *Data;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MPMC_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Queue->QueueFreeMethod)
+			{
+				while(Queue->DequeuePos != Queue->EnqueuePos)
+				{
+					Data = MpmcQueueRemove(Queue);
+
+					Queue->QueueFreeMethod(Data);
+				}
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		QueueMemDealloc((void*)(Queue->Buffer)); // MemDealloc defined in QueueConfig.h
+
+		Queue->Buffer = (MPMC_QUEUE_CELL*)NULL;
+		Queue->Mask = Queue->EnqueuePos = Queue->DequeuePos = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL MpmcQueueAdd(MPMC_QUEUE *Queue, const void *Data)
+	{
+		MPMC_QUEUE_CELL *Cell;
+		UINT32 Pos, Sequence;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MPMC_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Pos = (UINT32)QueueAtomicLoadRelaxed(&(Queue->EnqueuePos));
+
+		for(;;)
+		{
+			Cell = &(Queue->Buffer[Pos & Queue->Mask]);
+			Sequence = (UINT32)QueueAtomicLoadAcquire(&(Cell->Sequence));
+
+			if(Sequence == Pos)
+			{
+				// The slot is free, try to claim it.  On failure Pos holds the new position.
+				if(QueueAtomicCompareExchange(&(Queue->EnqueuePos), &Pos, Pos + 1))
+					break;
+			}
+			else if((INT32)(Sequence - Pos) < (INT32)0)
+			{
+				// The slot still holds data from one lap ago, the QUEUE is full.
+				return (BOOL)FALSE;
+			}
+			else
+			{
+				// Another producer claimed this position first.
+				Pos = (UINT32)QueueAtomicLoadRelaxed(&(Queue->EnqueuePos));
+			}
+		}
+
+		Cell->Data = (void*)Data;
+
+		// Hand the slot to the consumer of this position.
+		QueueAtomicStoreRelease(&(Cell->Sequence), Pos + 1);
+
+		return (BOOL)TRUE;
+	}
+
+	void *MpmcQueueRemove(MPMC_QUEUE *Queue)
+	{
+		MPMC_QUEUE_CELL *Cell;
+		UINT32 Pos, Sequence;
+		void *Data;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MPMC_QUEUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Pos = (UINT32)QueueAtomicLoadRelaxed(&(Queue->DequeuePos));
+
+		for(;;)
+		{
+			Cell = &(Queue->Buffer[Pos & Queue->Mask]);
+			Sequence = (UINT32)QueueAtomicLoadAcquire(&(Cell->Sequence));
+
+			if(Sequence == Pos + 1)
+			{
+				// The slot holds data, try to claim it.  On failure Pos holds the new position.
+				if(QueueAtomicCompareExchange(&(Queue->DequeuePos), &Pos, Pos + 1))
+					break;
+			}
+			else if((INT32)(Sequence - (Pos + 1)) < (INT32)0)
+			{
+				// No producer has filled this slot yet, the QUEUE is empty.
+				return (void*)NULL;
+			}
+			else
+			{
+				// Another consumer claimed this position first.
+				Pos = (UINT32)QueueAtomicLoadRelaxed(&(Queue->DequeuePos));
+			}
+		}
+
+		Data = (void*)(Cell->Data);
+
+		// Hand the slot to the producer of the next lap.
+		QueueAtomicStoreRelease(&(Cell->Sequence), Pos + Queue->Mask + 1);
+
+		return (void*)Data;
+	}
+
+	UINT32 MpmcQueueGetSize(MPMC_QUEUE *Queue)
+	{
+		UINT32 DequeuePos, EnqueuePos;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MPMC_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		DequeuePos = (UINT32)QueueAtomicLoadAcquire(&(Queue->DequeuePos));
+		EnqueuePos = (UINT32)QueueAtomicLoadAcquire(&(Queue->EnqueuePos));
+
+		// Claimed but unfinished removes can briefly put DequeuePos ahead.
+		if((INT32)(EnqueuePos - DequeuePos) < (INT32)0)
+			return (UINT32)0;
+
+		return (UINT32)(EnqueuePos - DequeuePos);
+	}
+#endif // end of USING_QUEUE_MPMC
+
+#if (USING_QUEUE_WORK_STEALING == 1)
+	static WS_DEQUE_BUFFER *WsDequeAllocBuffer(UINT32 Size)
+	{
+		WS_DEQUE_BUFFER *Buffer;
+
+		if((Buffer = (WS_DEQUE_BUFFER*)QueueMemAlloc(sizeof(WS_DEQUE_BUFFER) + (Size - 1) * sizeof(void*))) == (WS_DEQUE_BUFFER*)NULL) // MemAlloc defined in QueueConfig.h
+			return (WS_DEQUE_BUFFER*)NULL;
+
+		Buffer->Mask = (UINT32)(Size - 1);
+		Buffer->Previous = (WS_DEQUE_BUFFER*)NULL;
+
+		return (WS_DEQUE_BUFFER*)Buffer;
+	}
+
+	WS_DEQUE *CreateWsDeque(WS_DEQUE *Deque, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+	{
+		WS_DEQUE *TempDeque;
+		UINT32 Size;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Capacity > (UINT32)0x40000000)
+				return (WS_DEQUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the capacity up to a power of two so positions can wrap with a mask.
+		for(Size = (UINT32)2; Size < Capacity; Size <<= 1);
+
+		TempDeque = (WS_DEQUE*)Deque;
+
+		if(TempDeque == (WS_DEQUE*)NULL)
+		{
+			if((TempDeque = (WS_DEQUE*)QueueMemAlloc(sizeof(WS_DEQUE))) == (WS_DEQUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (WS_DEQUE*)NULL;
+			}
+		}
+
+		if((TempDeque->Buffer = WsDequeAllocBuffer(Size)) == (WS_DEQUE_BUFFER*)NULL)
+		{
+			if(Deque == (WS_DEQUE*)NULL)
+				QueueMemDealloc((void*)TempDeque); // MemDealloc defined in QueueConfig.h
+
+			return (WS_DEQUE*)NULL;
+		}
+
+		TempDeque->Top = TempDeque->Bottom = (UINT32)0;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			TempDeque->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		return (WS_DEQUE*)TempDeque;
+	}
+
+	BOOL DestroyWsDeque(WS_DEQUE *Deque)
+	{
+		WS_DEQUE_BUFFER *Buffer, *Previous;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Deque == (WS_DEQUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			if(Deque->QueueFreeMethod)
+			{
+				for(; Deque->Top != Deque->Bottom; Deque->Top++)
+					Deque->QueueFreeMethod(Deque->Buffer->Data[Deque->Top & Deque->Buffer->Mask]);
+			}
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		// No thief can be running any more, free every array ever used.
+		for(Buffer = Deque->Buffer; Buffer != (WS_DEQUE_BUFFER*)NULL; Buffer = Previous)
+		{
+			Previous = (WS_DEQUE_BUFFER*)(Buffer->Previous);
+
+			QueueMemDealloc((void*)Buffer); // MemDealloc defined in QueueConfig.h
+		}
+
+		Deque->Buffer = (WS_DEQUE_BUFFER*)NULL;
+		Deque->Top = Deque->Bottom = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL WsDequePush(WS_DEQUE *Deque, const void *Data)
+	{
+		WS_DEQUE_BUFFER *Buffer, *Grown;
+		UINT32 Bottom, Top, i;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Deque == (WS_DEQUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Bottom = (UINT32)QueueAtomicLoadRelaxed(&(Deque->Bottom));
+		Top = (UINT32)QueueAtomicLoadAcquire(&(Deque->Top));
+		Buffer = (WS_DEQUE_BUFFER*)QueueAtomicLoadRelaxed(&(Deque->Buffer));
+
+		if(Bottom - Top > Buffer->Mask)
+		{
+			// Full, copy the live positions into an array twice the size.
+			if(Buffer->Mask >= (UINT32)0x3FFFFFFF || (Grown = WsDequeAllocBuffer((Buffer->Mask + 1) << 1)) == (WS_DEQUE_BUFFER*)NULL)
+				return (BOOL)FALSE;
+
+			for(i = Top; i != Bottom; i++)
+				Grown->Data[i & Grown->Mask] = Buffer->Data[i & Buffer->Mask];
+
+			Grown->Previous = (WS_DEQUE_BUFFER*)Buffer;
+
+			QueueAtomicStoreRelease(&(Deque->Buffer), Grown);
+
+			Buffer = (WS_DEQUE_BUFFER*)Grown;
+		}
+
+		QueueAtomicStoreRelaxed(&(Buffer->Data[Bottom & Buffer->Mask]), (void*)Data);
+
+		// The data must be visible before a thief can see the new Bottom.
+		QueueAtomicFenceRelease();
+
+		QueueAtomicStoreRelaxed(&(Deque->Bottom), Bottom + 1);
+
+		return (BOOL)TRUE;
+	}
+
+	void *WsDequePop(WS_DEQUE *Deque)
+	{
+		WS_DEQUE_BUFFER *Buffer;
+		UINT32 Bottom, Top;
+		void *Data;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Deque == (WS_DEQUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Bottom = (UINT32)QueueAtomicLoadRelaxed(&(Deque->Bottom)) - 1;
+		Buffer = (WS_DEQUE_BUFFER*)QueueAtomicLoadRelaxed(&(Deque->Buffer));
+
+		// Claim the newest position first, then see whether a thief got there too.
+		QueueAtomicStoreRelaxed(&(Deque->Bottom), Bottom);
+
+		QueueAtomicFence();
+
+		Top = (UINT32)QueueAtomicLoadRelaxed(&(Deque->Top));
+
+		if((INT32)(Bottom - Top) < (INT32)0)
+		{
+			// It was already empty.
+			QueueAtomicStoreRelaxed(&(Deque->Bottom), Bottom + 1);
+
+			return (void*)NULL;
+		}
+
+		Data = (void*)QueueAtomicLoadRelaxed(&(Buffer->Data[Bottom & Buffer->Mask]));
+
+		if(Bottom == Top)
+		{
+			// The last piece of data, race the thieves for it on Top.
+			if(!QueueAtomicCompareExchangeStrong(&(Deque->Top), &Top, Top + 1))
+				Data = (void*)NULL;
+
+			QueueAtomicStoreRelaxed(&(Deque->Bottom), Bottom + 1);
+		}
+
+		return (void*)Data;
+	}
+
+	void *WsDequeSteal(WS_DEQUE *Deque)
+	{
+		WS_DEQUE_BUFFER *Buffer;
+		UINT32 Bottom, Top;
+		void *Data;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Deque == (WS_DEQUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Top = (UINT32)QueueAtomicLoadAcquire(&(Deque->Top));
+
+		QueueAtomicFence();
+
+		Bottom = (UINT32)QueueAtomicLoadAcquire(&(Deque->Bottom));
+
+		if((INT32)(Bottom - Top) <= (INT32)0)
+			return (void*)NULL;
+
+		Buffer = (WS_DEQUE_BUFFER*)QueueAtomicLoadAcquire(&(Deque->Buffer));
+
+		Data = (void*)QueueAtomicLoadRelaxed(&(Buffer->Data[Top & Buffer->Mask]));
+
+		// Losing the race to the owner or another thief counts as nothing stolen.
+		if(!QueueAtomicCompareExchangeStrong(&(Deque->Top), &Top, Top + 1))
+			return (void*)NULL;
+
+		return (void*)Data;
+	}
+
+	UINT32 WsDequeGetSize(WS_DEQUE *Deque)
+	{
+		UINT32 Bottom, Top;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Deque == (WS_DEQUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Top = (UINT32)QueueAtomicLoadAcquire(&(Deque->Top));
+		Bottom = (UINT32)QueueAtomicLoadAcquire(&(Deque->Bottom));
+
+		// A pop in progress can briefly put Bottom behind Top.
+		if((INT32)(Bottom - Top) < (INT32)0)
+			return (UINT32)0;
+
+		return (UINT32)(Bottom - Top);
+	}
+#endif // end of USING_QUEUE_WORK_STEALING
+
+#if (USING_QUEUE_PERSISTENT == 1)
+	#include "stdio.h"
+	#include "string.h"
+	#include "fcntl.h"
+	#include "unistd.h"
+	#include "sys/mman.h"
+
+	/*
+		A record is its length, a check over the segment number, the
+		length and the data, and then the data padded to 8 bytes.  A
+		length of QUEUE_PERSISTENT_NEXT_SEGMENT means the rest of the 
+		segment is unused and the next record starts the next segment.
+	*/
+	#define QUEUE_PERSISTENT_HEADER_SIZE				8
+	#define QUEUE_PERSISTENT_NEXT_SEGMENT				0xFFFFFFFF
+	#define QUEUE_PERSISTENT_MAGIC						0x50515545
+	#define QUEUE_PERSISTENT_MAX_NAME					(QUEUE_PERSISTENT_MAX_PATH + 32)
+
+	#define QueuePersistentRecordSize(Length)			((UINT32)QUEUE_PERSISTENT_HEADER_SIZE + (((UINT32)(Length) + (UINT32)7) & ~(UINT32)7))
+
+	/*
+		An FNV-1a hash of the segment number, the length and the data.
+		Mixing in the segment number keeps records left over in a
+		recycled segment file from ever passing as new ones.
+	*/
+	static UINT32 QueuePersistentCheck(UINT32 Segment, UINT32 Length, const BYTE *Data)
+	{
+		UINT32 Check, i;
+
+		Check = (UINT32)2166136261UL;
+
+		for(i = (UINT32)0; i < (UINT32)32; i += (UINT32)8)
+			Check = (Check ^ ((Segment >> i) & (UINT32)0xFF)) * (UINT32)16777619UL;
+
+		for(i = (UINT32)0; i < (UINT32)32; i += (UINT32)8)
+			Check = (Check ^ ((Length >> i) & (UINT32)0xFF)) * (UINT32)16777619UL;
+
+		if(Data != (const BYTE*)NULL)
+		{
+			for(i = (UINT32)0; i < Length; i++)
+				Check = (Check ^ (UINT32)Data[i]) * (UINT32)16777619UL;
+		}
+
+		return (UINT32)Check;
+	}
+
+	static void QueuePersistentSegmentName(PERSISTENT_QUEUE *Queue, UINT32 Segment, char *Name)
+	{
+		sprintf(Name, "%s/%08lX.seg", Queue->Path, (unsigned long)Segment);
+	}
+
+	/*
+		Maps a segment file.  With Create a new segment is made, out of
+		the spare file when there is one.  Returns NULL on failure.
+	*/
+	static BYTE *QueuePersistentMap(PERSISTENT_QUEUE *Queue, UINT32 Segment, BOOL Create)
+	{
+		char Name[QUEUE_PERSISTENT_MAX_NAME];
+		void *Map;
+		int File, Flags;
+
+		#if (QUEUE_PERSISTENT_RECYCLE_SEGMENTS == 1)
+			char Spare[QUEUE_PERSISTENT_MAX_NAME];
+		#endif // end of QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+
+		QueuePersistentSegmentName(Queue, Segment, Name);
+
+		Flags = O_RDWR;
+
+		if(Create)
+		{
+			// Whatever an unused file of the same name holds is thrown away.
+			Flags |= O_CREAT | O_TRUNC;
+
+			#if (QUEUE_PERSISTENT_RECYCLE_SEGMENTS == 1)
+				sprintf(Spare, "%s/spare.seg", Queue->Path);
+
+				if(rename(Spare, Name) == 0)
+					Flags = O_RDWR;
+			#endif // end of QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+		}
+
+		if((File = open(Name, Flags, 0644)) < 0)
+			return (BYTE*)NULL;
+
+		if(Create && ftruncate(File, (off_t)QUEUE_PERSISTENT_SEGMENT_SIZE) != 0)
+		{
+			close(File);
+
+			return (BYTE*)NULL;
+		}
+
+		Map = mmap(NULL, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, File, (off_t)0);
+
+		// The mapping keeps the file open.
+		close(File);
+
+		if(Map == MAP_FAILED)
+			return (BYTE*)NULL;
+
+		return (BYTE*)Map;
+	}
+
+	/*
+		Gets rid of a segment the head has left, by keeping it as the
+		spare file or deleting it.
+	*/
+	static void QueuePersistentRetire(PERSISTENT_QUEUE *Queue, UINT32 Segment)
+	{
+		char Name[QUEUE_PERSISTENT_MAX_NAME];
+
+		#if (QUEUE_PERSISTENT_RECYCLE_SEGMENTS == 1)
+			char Spare[QUEUE_PERSISTENT_MAX_NAME];
+		#endif // end of QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+
+		QueuePersistentSegmentName(Queue, Segment, Name);
+
+		#if (QUEUE_PERSISTENT_RECYCLE_SEGMENTS == 1)
+			sprintf(Spare, "%s/spare.seg", Queue->Path);
+
+			// Replaces an older spare, so there is never more than one.
+			if(rename(Name, Spare) == 0)
+				return;
+		#endif // end of QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+
+		unlink(Name);
+	}
+
+	/*
+		Writes the tail segment out and then the checkpoint, so the
+		checkpoint never points past what is on disk.  Then retires
+		the segments the head left, which no checkpoint points into
+		any more.  The lock must be held.
+	*/
+	static BOOL QueuePersistentSync(PERSISTENT_QUEUE *Queue)
+	{
+		PERSISTENT_QUEUE_CHECKPOINT Checkpoint;
+		char Name[QUEUE_PERSISTENT_MAX_NAME], Temp[QUEUE_PERSISTENT_MAX_NAME];
+		UINT32 Start;
+		BOOL Written;
+		int File;
+
+		if(Queue->TailOffset > Queue->SyncedOffset)
+		{
+			// msync() wants a page aligned address.
+			Start = Queue->SyncedOffset & ~((UINT32)sysconf(_SC_PAGESIZE) - (UINT32)1);
+
+			if(msync((void*)(Queue->TailMap + Start), (size_t)(Queue->TailOffset - Start), MS_SYNC) != 0)
+				return (BOOL)FALSE;
+
+			Queue->SyncedOffset = Queue->TailOffset;
+		}
+
+		Checkpoint.Magic = (UINT32)QUEUE_PERSISTENT_MAGIC;
+		Checkpoint.HeadSegment = Queue->HeadSegment;
+		Checkpoint.HeadOffset = Queue->HeadOffset;
+		Checkpoint.TailSegment = Queue->TailSegment;
+		Checkpoint.TailOffset = Queue->TailOffset;
+		Checkpoint.Size = Queue->Size;
+		Checkpoint.Check = QueuePersistentCheck((UINT32)QUEUE_PERSISTENT_MAGIC, (UINT32)(sizeof(Checkpoint) - sizeof(UINT32)), (const BYTE*)&Checkpoint);
+
+		sprintf(Name, "%s/checkpoint", Queue->Path);
+		sprintf(Temp, "%s/checkpoint.tmp", Queue->Path);
+
+		if((File = open(Temp, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+			return (BOOL)FALSE;
+
+		Written = (BOOL)(write(File, (const void*)&Checkpoint, sizeof(Checkpoint)) == (ssize_t)sizeof(Checkpoint) && fsync(File) == 0);
+
+		close(File);
+
+		if(!Written || rename(Temp, Name) != 0 || fsync(Queue->Directory) != 0)
+			return (BOOL)FALSE;
+
+		Queue->Unsynced = (UINT32)0;
+		Queue->LastSync = (UINT32)QueueGetTickCount();
+
+		// Segments left while a sync failed are retired by the next one that works.
+		for(; Queue->RetireSegment != Queue->HeadSegment; Queue->RetireSegment++)
+			QueuePersistentRetire(Queue, Queue->RetireSegment);
+
+		return (BOOL)TRUE;
+	}
+
+	static BOOL QueuePersistentSyncIfDue(PERSISTENT_QUEUE *Queue)
+	{
+		if(Queue->Unsynced == (UINT32)0)
+			return (BOOL)TRUE;
+
+		if(Queue->SyncRecords && Queue->Unsynced >= Queue->SyncRecords)
+			return QueuePersistentSync(Queue);
+
+		if(Queue->SyncInterval && (UINT32)QueueGetTickCount() - Queue->LastSync >= Queue->SyncInterval)
+			return QueuePersistentSync(Queue);
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Starts a new tail segment, marking the end of the old one.  The
+		old one is written out before it is unmapped, if that fails it
+		stays the tail.
+	*/
+	static BOOL QueuePersistentNextTail(PERSISTENT_QUEUE *Queue)
+	{
+		UINT32 *Header, Start;
+		BYTE *Map;
+
+		// Offsets are multiples of 8, so any room left fits a header.
+		if(Queue->TailOffset < (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE)
+		{
+			Header = (UINT32*)(Queue->TailMap + Queue->TailOffset);
+
+			Header[1] = QueuePersistentCheck(Queue->TailSegment, (UINT32)QUEUE_PERSISTENT_NEXT_SEGMENT, (const BYTE*)NULL);
+			Header[0] = (UINT32)QUEUE_PERSISTENT_NEXT_SEGMENT;
+		}
+
+		Start = Queue->SyncedOffset & ~((UINT32)sysconf(_SC_PAGESIZE) - (UINT32)1);
+
+		/*
+			A marker written out without the next segment only sends a
+			reload looking for a segment that isn't there, and a retry
+			writes the same marker again.
+		*/
+		if(msync((void*)(Queue->TailMap + Start), (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE - (size_t)Start, MS_SYNC) != 0)
+			return (BOOL)FALSE;
+
+		if((Map = QueuePersistentMap(Queue, Queue->TailSegment + (UINT32)1, (BOOL)TRUE)) == (BYTE*)NULL)
+			return (BOOL)FALSE;
+
+		munmap((void*)Queue->TailMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+		Queue->TailMap = (BYTE*)Map;
+		Queue->TailSegment++;
+		Queue->TailOffset = Queue->SyncedOffset = (UINT32)0;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Returns the header of the record at the head, first moving the
+		head to the next segment if it reached the end of its own.  The
+		lock must be held and the PERSISTENT_QUEUE must not be empty.
+	*/
+	static UINT32 *QueuePersistentHead(PERSISTENT_QUEUE *Queue)
+	{
+		BYTE *Map;
+
+		if(Queue->HeadOffset >= (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE || *(UINT32*)(Queue->HeadMap + Queue->HeadOffset) == (UINT32)QUEUE_PERSISTENT_NEXT_SEGMENT)
+		{
+			if((Map = QueuePersistentMap(Queue, Queue->HeadSegment + (UINT32)1, (BOOL)FALSE)) == (BYTE*)NULL)
+				return (UINT32*)NULL;
+
+			munmap((void*)Queue->HeadMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+			Queue->HeadMap = (BYTE*)Map;
+			Queue->HeadSegment++;
+			Queue->HeadOffset = (UINT32)0;
+
+			// The old segment can only go once no checkpoint points into it.
+			QueuePersistentSync(Queue);
+		}
+
+		return (UINT32*)(Queue->HeadMap + Queue->HeadOffset);
+	}
+
+	/*
+		Loads the checkpoint, or starts an empty PERSISTENT_QUEUE if
+		there is none, and then picks up every whole record appended
+		after the checkpoint was written.
+	*/
+	static BOOL QueuePersistentLoad(PERSISTENT_QUEUE *Queue)
+	{
+		PERSISTENT_QUEUE_CHECKPOINT Checkpoint;
+		char Name[QUEUE_PERSISTENT_MAX_NAME];
+		UINT32 *Header;
+		BYTE *Map;
+		BOOL Found;
+		int File;
+
+		sprintf(Name, "%s/checkpoint", Queue->Path);
+
+		Found = (BOOL)FALSE;
+
+		if((File = open(Name, O_RDONLY)) >= 0)
+		{
+			Found = (BOOL)(read(File, (void*)&Checkpoint, sizeof(Checkpoint)) == (ssize_t)sizeof(Checkpoint));
+
+			close(File);
+
+			if(!Found || Checkpoint.Magic != (UINT32)QUEUE_PERSISTENT_MAGIC || 
+				Checkpoint.Check != QueuePersistentCheck((UINT32)QUEUE_PERSISTENT_MAGIC, (UINT32)(sizeof(Checkpoint) - sizeof(UINT32)), (const BYTE*)&Checkpoint))
+				return (BOOL)FALSE;
+		}
+		else
+		{
+			memset((void*)&Checkpoint, 0, sizeof(Checkpoint));
+		}
+
+		if((Queue->HeadMap = QueuePersistentMap(Queue, Checkpoint.HeadSegment, (BOOL)!Found)) == (BYTE*)NULL)
+			return (BOOL)FALSE;
+
+		if((Queue->TailMap = QueuePersistentMap(Queue, Checkpoint.TailSegment, (BOOL)FALSE)) == (BYTE*)NULL)
+		{
+			munmap((void*)Queue->HeadMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+			return (BOOL)FALSE;
+		}
+
+		Queue->HeadSegment = Queue->RetireSegment = Checkpoint.HeadSegment;
+		Queue->HeadOffset = Checkpoint.HeadOffset;
+		Queue->TailSegment = Checkpoint.TailSegment;
+		Queue->TailOffset = Checkpoint.TailOffset;
+		Queue->Size = Checkpoint.Size;
+
+		for(;;)
+		{
+			if(Queue->TailOffset < (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE)
+			{
+				Header = (UINT32*)(Queue->TailMap + Queue->TailOffset);
+
+				if(Header[0] != (UINT32)QUEUE_PERSISTENT_NEXT_SEGMENT)
+				{
+					// Stop at the first record that is torn, or was never written.
+					if(Header[0] > (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE - (UINT32)16 ||
+						Queue->TailOffset + QueuePersistentRecordSize(Header[0]) > (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE ||
+						Header[1] != QueuePersistentCheck(Queue->TailSegment, Header[0], (const BYTE*)(Header + 2)))
+						break;
+
+					Queue->TailOffset += QueuePersistentRecordSize(Header[0]);
+					Queue->Size++;
+
+					continue;
+				}
+
+				if(Header[1] != QueuePersistentCheck(Queue->TailSegment, (UINT32)QUEUE_PERSISTENT_NEXT_SEGMENT, (const BYTE*)NULL))
+					break;
+
+				// The segment was closed, the next add starts a new one if it isn't there.
+				Queue->TailOffset = (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE;
+			}
+
+			if((Map = QueuePersistentMap(Queue, Queue->TailSegment + (UINT32)1, (BOOL)FALSE)) == (BYTE*)NULL)
+				break;
+
+			munmap((void*)Queue->TailMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+			Queue->TailMap = (BYTE*)Map;
+			Queue->TailSegment++;
+			Queue->TailOffset = (UINT32)0;
+		}
+
+		// What was found past the checkpoint may not be on disk yet.
+		Queue->SyncedOffset = (UINT32)0;
+
+		// A new PERSISTENT_QUEUE writes its first checkpoint right away.
+		if(!Found && !QueuePersistentSync(Queue))
+		{
+			munmap((void*)Queue->HeadMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+			munmap((void*)Queue->TailMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+			return (BOOL)FALSE;
+		}
+
+		return (BOOL)TRUE;
+	}
+
+	PERSISTENT_QUEUE *CreatePersistentQueue(PERSISTENT_QUEUE *Queue, const char *Path, UINT32 SyncRecords, UINT32 SyncInterval)
+	{
+		PERSISTENT_QUEUE *TempQueue;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Path == (const char*)NULL || strlen(Path) >= (size_t)QUEUE_PERSISTENT_MAX_PATH)
+				return (PERSISTENT_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		TempQueue = (PERSISTENT_QUEUE*)Queue;
+
+		if(TempQueue == (PERSISTENT_QUEUE*)NULL)
+		{
+			if((TempQueue = (PERSISTENT_QUEUE*)QueueMemAlloc(sizeof(PERSISTENT_QUEUE))) == (PERSISTENT_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (PERSISTENT_QUEUE*)NULL;
+			}
+		}
+
+		strcpy(TempQueue->Path, Path);
+
+		if((TempQueue->Directory = open(Path, O_RDONLY)) < 0 || !QueuePersistentLoad(TempQueue))
+		{
+			if(TempQueue->Directory >= 0)
+				close(TempQueue->Directory);
+
+			if(Queue == (PERSISTENT_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (PERSISTENT_QUEUE*)NULL;
+		}
+
+		TempQueue->SyncRecords = SyncRecords;
+		TempQueue->SyncInterval = SyncInterval;
+		TempQueue->Unsynced = (UINT32)0;
+		TempQueue->LastSync = (UINT32)QueueGetTickCount();
+
+		QueueLockInit(&(TempQueue->Lock));
+
+		return (PERSISTENT_QUEUE*)TempQueue;
+	}
+
+	BOOL DestroyPersistentQueue(PERSISTENT_QUEUE *Queue)
+	{
+		BOOL Synced;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL || Queue->HeadMap == (BYTE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Synced = QueuePersistentSync(Queue);
+
+		munmap((void*)Queue->HeadMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+		munmap((void*)Queue->TailMap, (size_t)QUEUE_PERSISTENT_SEGMENT_SIZE);
+
+		close(Queue->Directory);
+
+		Queue->HeadMap = Queue->TailMap = (BYTE*)NULL;
+		Queue->Size = (UINT32)0;
+
+		return (BOOL)Synced;
+	}
+
+	BOOL PersistentQueueAdd(PERSISTENT_QUEUE *Queue, const void *Data, UINT32 Length)
+	{
+		UINT32 *Header;
+		BOOL Added;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL || (Data == (const void*)NULL && Length) || Length > (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE - (UINT32)16)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueLock(&(Queue->Lock));
+
+		Added = (BOOL)TRUE;
+
+		if(Queue->TailOffset + QueuePersistentRecordSize(Length) > (UINT32)QUEUE_PERSISTENT_SEGMENT_SIZE)
+			Added = QueuePersistentNextTail(Queue);
+
+		if(Added)
+		{
+			Header = (UINT32*)(Queue->TailMap + Queue->TailOffset);
+
+			if(Length)
+				memcpy((void*)(Header + 2), Data, (size_t)Length);
+
+			Header[1] = QueuePersistentCheck(Queue->TailSegment, Length, (const BYTE*)(Header + 2));
+			Header[0] = Length;
+
+			Queue->TailOffset += QueuePersistentRecordSize(Length);
+			Queue->Size++;
+			Queue->Unsynced++;
+
+			// The record is in, a failed sync is retried and reported by the next one.
+			QueuePersistentSyncIfDue(Queue);
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)Added;
+	}
+
+	const void *PersistentQueuePeek(PERSISTENT_QUEUE *Queue, UINT32 *Length)
+	{
+		const void *Data;
+		UINT32 *Header;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL)
+				return (const void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Data = (const void*)NULL;
+
+		QueueLock(&(Queue->Lock));
+
+		if(Queue->Size && (Header = QueuePersistentHead(Queue)) != (UINT32*)NULL)
+		{
+			if(Length != (UINT32*)NULL)
+				*Length = Header[0];
+
+			// Straight out of the mapping, no copy.
+			Data = (const void*)(Header + 2);
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (const void*)Data;
+	}
+
+	BOOL PersistentQueueRemove(PERSISTENT_QUEUE *Queue)
+	{
+		UINT32 *Header;
+		BOOL Removed;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Removed = (BOOL)FALSE;
+
+		QueueLock(&(Queue->Lock));
+
+		if(Queue->Size && (Header = QueuePersistentHead(Queue)) != (UINT32*)NULL)
+		{
+			Queue->HeadOffset += QueuePersistentRecordSize(Header[0]);
+			Queue->Size--;
+			Queue->Unsynced++;
+
+			// A remove lost in a crash only means the record is read again.
+			QueuePersistentSyncIfDue(Queue);
+
+			Removed = (BOOL)TRUE;
+		}
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)Removed;
+	}
+
+	BOOL PersistentQueueSync(PERSISTENT_QUEUE *Queue)
+	{
+		BOOL Synced;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueLock(&(Queue->Lock));
+
+		Synced = QueuePersistentSync(Queue);
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (BOOL)Synced;
+	}
+
+	UINT32 PersistentQueueGetSize(PERSISTENT_QUEUE *Queue)
+	{
+		UINT32 Size;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (PERSISTENT_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		QueueLock(&(Queue->Lock));
+
+		Size = Queue->Size;
+
+		QueueUnlock(&(Queue->Lock));
+
+		return (UINT32)Size;
+	}
+#endif // end of USING_QUEUE_PERSISTENT
+
+#if (USING_QUEUE_SHARED == 1)
+	#include "string.h"
+	#include "fcntl.h"
+	#include "unistd.h"
+	#include "sys/mman.h"
+	#include "sys/stat.h"
+
+	#if defined(__linux__)
+		#include "sys/syscall.h"
+		#include "linux/futex.h"
+
+		/*
+			The default QueueFutexWait() and QueueFutexWake() for Linux.
+			The futexes are not private, processes share them.
+		*/
+		static void QueueLinuxFutexWait(UINT32 *Address, UINT32 Value, UINT32 Timeout)
+		{
+			struct timespec Relative;
+
+			if(Timeout == (UINT32)QUEUE_WAIT_FOREVER)
+			{
+				syscall(SYS_futex, Address, FUTEX_WAIT, Value, NULL, NULL, 0);
+
+				return;
+			}
+
+			Relative.tv_sec = (time_t)(Timeout / 1000);
+			Relative.tv_nsec = (long)(Timeout % 1000) * 1000000L;
+
+			syscall(SYS_futex, Address, FUTEX_WAIT, Value, &Relative, NULL, 0);
+		}
+
+		static void QueueLinuxFutexWake(UINT32 *Address, UINT32 Count)
+		{
+			syscall(SYS_futex, Address, FUTEX_WAKE, Count, NULL, NULL, 0);
+		}
+	#endif // end of __linux__
+
+	#define QUEUE_SHARED_MAGIC							0x53485155
+	#define SharedQueueSlot(Queue, Position)			((SHARED_QUEUE_SLOT*)((Queue)->Slots + ((Position) & (Queue)->Mask) * (Queue)->Stride))
+
+	/*
+		The slots start on the first cache line after the header.
+	*/
+	#define QUEUE_SHARED_SLOTS_OFFSET					((sizeof(SHARED_QUEUE_HEADER) + QUEUE_CACHE_LINE_SIZE - 1) / QUEUE_CACHE_LINE_SIZE * QUEUE_CACHE_LINE_SIZE)
+
+	/*
+		Claims the next slot the way MpmcQueueAdd() and MpmcQueueRemove()
+		do.  A producer passes EnqueuePos and Turn 0, a consumer passes 
+		DequeuePos and Turn 1.  Returns FALSE when the SHARED_QUEUE is 
+		full for a producer or empty for a consumer.
+	*/
+	static BOOL SharedQueueClaim(SHARED_QUEUE *Queue, UINT32 *Counter, UINT32 Turn, UINT32 *Position)
+	{
+		UINT32 Pos, Sequence;
+
+		Pos = (UINT32)QueueAtomicLoadRelaxed(Counter);
+
+		for(;;)
+		{
+			Sequence = (UINT32)QueueAtomicLoadAcquire(&(SharedQueueSlot(Queue, Pos)->Sequence));
+
+			if(Sequence == Pos + Turn)
+			{
+				if(QueueAtomicCompareExchange(Counter, &Pos, Pos + 1))
+					break;
+			}
+			else if((INT32)(Sequence - (Pos + Turn)) < (INT32)0)
+			{
+				return (BOOL)FALSE;
+			}
+			else
+			{
+				Pos = (UINT32)QueueAtomicLoadRelaxed(Counter);
+			}
+		}
+
+		*Position = (UINT32)Pos;
+
+		return (BOOL)TRUE;
+	}
+
+	/*
+		Claims a slot like SharedQueueClaim(), sleeping on the futex Event
+		for up to Timeout milliseconds while there is none.  Waiters lets
+		the other side know it has to wake somebody up.
+	*/
+	static BOOL SharedQueueWait(SHARED_QUEUE *Queue, UINT32 *Counter, UINT32 Turn, UINT32 *Event, UINT32 *Waiters, UINT32 Timeout, UINT32 *Position)
+	{
+		UINT32 Start, Elapsed, Seen;
+		BOOL Claimed;
+
+		Start = (UINT32)QueueGetTickCount();
+
+		for(;;)
+		{
+			// The fast path, no system call at all.
+			if(SharedQueueClaim(Queue, Counter, Turn, Position))
+				return (BOOL)TRUE;
+
+			Elapsed = (UINT32)QueueGetTickCount() - Start;
+
+			if(Timeout != (UINT32)QUEUE_WAIT_FOREVER && Elapsed >= Timeout)
+				return (BOOL)FALSE;
+
+			Seen = (UINT32)QueueAtomicLoadAcquire(Event);
+
+			QueueAtomicAddRelaxed(Waiters, (UINT32)1);
+			QueueAtomicFence();
+
+			/*
+				Try again now that the other side can see the waiter.  If it
+				published a slot in between it also changed Event, and the
+				futex doesn't sleep.
+			*/
+			if((Claimed = SharedQueueClaim(Queue, Counter, Turn, Position)) == (BOOL)FALSE)
+				QueueFutexWait(Event, Seen, (Timeout == (UINT32)QUEUE_WAIT_FOREVER) ? Timeout : Timeout - Elapsed);
+
+			QueueAtomicAddRelaxed(Waiters, (UINT32)-1);
+
+			if(Claimed)
+				return (BOOL)TRUE;
+		}
+	}
+
+	/*
+		Wakes one process waiting on Event, if there is one.
+	*/
+	static void SharedQueueSignal(UINT32 *Event, UINT32 *Waiters)
+	{
+		QueueAtomicFence();
+
+		if(QueueAtomicLoadRelaxed(Waiters))
+		{
+			QueueAtomicAddRelaxed(Event, (UINT32)1);
+
+			QueueFutexWake(Event, (UINT32)1);
+		}
+	}
+
+	SHARED_QUEUE *CreateSharedQueue(SHARED_QUEUE *Queue, const char *Name, UINT32 Capacity, UINT32 SlotSize)
+	{
+		SHARED_QUEUE *TempQueue;
+		SHARED_QUEUE_HEADER *Header;
+		UINT32 Size, Stride, Bytes, i;
+		void *Map;
+		int File;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Name == (const char*)NULL || strlen(Name) >= (size_t)QUEUE_SHARED_MAX_NAME || Capacity == (UINT32)0 || Capacity > (UINT32)0x80000000)
+				return (SHARED_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// Round the capacity up to a power of two, a single slot can't tell full from empty.
+		for(Size = (UINT32)2; Size < Capacity; Size <<= 1);
+
+		// Slots are kept 8 byte aligned.
+		Stride = (UINT32)sizeof(SHARED_QUEUE_SLOT) + ((SlotSize + (UINT32)7) & ~(UINT32)7);
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Stride < SlotSize || (UINT32)0xFFFFFFFF / Size <= Stride)
+				return (SHARED_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Bytes = (UINT32)QUEUE_SHARED_SLOTS_OFFSET + Size * Stride;
+
+		TempQueue = (SHARED_QUEUE*)Queue;
+
+		if(TempQueue == (SHARED_QUEUE*)NULL)
+		{
+			if((TempQueue = (SHARED_QUEUE*)QueueMemAlloc(sizeof(SHARED_QUEUE))) == (SHARED_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (SHARED_QUEUE*)NULL;
+			}
+		}
+
+		Map = MAP_FAILED;
+
+		// Never take over a name that is in use, UnlinkSharedQueue() clears a stale one.
+		if((File = shm_open(Name, O_RDWR | O_CREAT | O_EXCL, 0600)) >= 0)
+		{
+			if(ftruncate(File, (off_t)Bytes) == 0)
+				Map = mmap(NULL, (size_t)Bytes, PROT_READ | PROT_WRITE, MAP_SHARED, File, (off_t)0);
+
+			close(File);
+
+			if(Map == MAP_FAILED)
+				shm_unlink(Name);
+		}
+
+		if(Map == MAP_FAILED)
+		{
+			if(Queue == (SHARED_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (SHARED_QUEUE*)NULL;
+		}
+
+		TempQueue->Header = Header = (SHARED_QUEUE_HEADER*)Map;
+		TempQueue->Slots = (BYTE*)Map + QUEUE_SHARED_SLOTS_OFFSET;
+		TempQueue->Mask = Header->Mask = (UINT32)(Size - 1);
+		TempQueue->SlotSize = Header->SlotSize = SlotSize;
+		TempQueue->Stride = Header->Stride = Stride;
+		TempQueue->Bytes = Bytes;
+		TempQueue->Owner = (BOOL)TRUE;
+
+		strcpy(TempQueue->Name, Name);
+
+		// The new memory is zeroed, only the sequences need setting.
+		for(i = 0; i < Size; i++)
+			SharedQueueSlot(TempQueue, i)->Sequence = (UINT32)i;
+
+		// Other processes may attach from here on.
+		QueueAtomicStoreRelease(&(Header->Magic), (UINT32)QUEUE_SHARED_MAGIC);
+
+		return (SHARED_QUEUE*)TempQueue;
+	}
+
+	SHARED_QUEUE *OpenSharedQueue(SHARED_QUEUE *Queue, const char *Name)
+	{
+		SHARED_QUEUE *TempQueue;
+		SHARED_QUEUE_HEADER *Header;
+		struct stat Status;
+		void *Map;
+		int File;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Name == (const char*)NULL || strlen(Name) >= (size_t)QUEUE_SHARED_MAX_NAME)
+				return (SHARED_QUEUE*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((File = shm_open(Name, O_RDWR, 0600)) < 0)
+			return (SHARED_QUEUE*)NULL;
+
+		Map = MAP_FAILED;
+
+		// The creator may not have sized it yet.
+		if(fstat(File, &Status) == 0 && (size_t)Status.st_size >= (size_t)QUEUE_SHARED_SLOTS_OFFSET)
+			Map = mmap(NULL, (size_t)Status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, File, (off_t)0);
+
+		close(File);
+
+		if(Map == MAP_FAILED)
+			return (SHARED_QUEUE*)NULL;
+
+		Header = (SHARED_QUEUE_HEADER*)Map;
+
+		// Not ready yet, or not a SHARED_QUEUE of this size.
+		if(QueueAtomicLoadAcquire(&(Header->Magic)) != (UINT32)QUEUE_SHARED_MAGIC ||
+			(size_t)QUEUE_SHARED_SLOTS_OFFSET + ((size_t)Header->Mask + 1) * (size_t)Header->Stride != (size_t)Status.st_size)
+		{
+			munmap(Map, (size_t)Status.st_size);
+
+			return (SHARED_QUEUE*)NULL;
+		}
+
+		TempQueue = (SHARED_QUEUE*)Queue;
+
+		if(TempQueue == (SHARED_QUEUE*)NULL)
+		{
+			if((TempQueue = (SHARED_QUEUE*)QueueMemAlloc(sizeof(SHARED_QUEUE))) == (SHARED_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				munmap(Map, (size_t)Status.st_size);
+
+				return (SHARED_QUEUE*)NULL;
+			}
+		}
+
+		TempQueue->Header = Header;
+		TempQueue->Slots = (BYTE*)Map + QUEUE_SHARED_SLOTS_OFFSET;
+		TempQueue->Mask = Header->Mask;
+		TempQueue->SlotSize = Header->SlotSize;
+		TempQueue->Stride = Header->Stride;
+		TempQueue->Bytes = (UINT32)Status.st_size;
+		TempQueue->Owner = (BOOL)FALSE;
+
+		strcpy(TempQueue->Name, Name);
+
+		return (SHARED_QUEUE*)TempQueue;
+	}
+
+	BOOL DestroySharedQueue(SHARED_QUEUE *Queue)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Queue->Header == (SHARED_QUEUE_HEADER*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		munmap((void*)Queue->Header, (size_t)Queue->Bytes);
+
+		// Processes still attached keep their mapping, only the name goes.
+		if(Queue->Owner)
+			shm_unlink(Queue->Name);
+
+		Queue->Header = (SHARED_QUEUE_HEADER*)NULL;
+		Queue->Slots = (BYTE*)NULL;
+
+		return (BOOL)TRUE;
+	}
+
+	BOOL UnlinkSharedQueue(const char *Name)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Name == (const char*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		return (BOOL)(shm_unlink(Name) == 0);
+	}
+
+	void *SharedQueueReserve(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 Timeout)
+	{
+		SHARED_QUEUE_HEADER *Header;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Position == (UINT32*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Header = Queue->Header;
+
+		if(!SharedQueueWait(Queue, &(Header->EnqueuePos), (UINT32)0, &(Header->NotFull), &(Header->FullWaiters), Timeout, Position))
+			return (void*)NULL;
+
+		return (void*)(SharedQueueSlot(Queue, *Position) + 1);
+	}
+
+	BOOL SharedQueueCommit(SHARED_QUEUE *Queue, UINT32 Position, UINT32 Length)
+	{
+		SHARED_QUEUE_SLOT *Slot;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Length > Queue->SlotSize)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
 
-	// If the user didn't pass in a pointer, allocate memory for the QUEUE structure.
-	if(QueueIsNull(Queue))
+		Slot = SharedQueueSlot(Queue, Position);
+
+		Slot->Length = Length;
+
+		// Hand the slot to the consumer of this position.
+		QueueAtomicStoreRelease(&(Slot->Sequence), Position + 1);
+
+		SharedQueueSignal(&(Queue->Header->NotEmpty), &(Queue->Header->EmptyWaiters));
+
+		return (BOOL)TRUE;
+	}
+
+	void *SharedQueueAcquire(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 *Length, UINT32 Timeout)
 	{
-		if((TempQueue = (QUEUE*)QueueMemAlloc(sizeof(QUEUE))) == (QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
-		{
-			return (QUEUE*)NULL;
-		}
+		SHARED_QUEUE_HEADER *Header;
+		SHARED_QUEUE_SLOT *Slot;
 
-		Queue = (QUEUE*)TempQueue;
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Position == (UINT32*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
+
+		Header = Queue->Header;
+
+		if(!SharedQueueWait(Queue, &(Header->DequeuePos), (UINT32)1, &(Header->NotEmpty), &(Header->EmptyWaiters), Timeout, Position))
+			return (void*)NULL;
+
+		Slot = SharedQueueSlot(Queue, *Position);
+
+		if(Length != (UINT32*)NULL)
+			*Length = Slot->Length;
+
+		return (void*)(Slot + 1);
 	}
 
-	// Initialize the Queue.
-	Queue->Head = Queue->Tail = (QUEUE_NODE*)NULL;
-	Queue->Size = (UINT32)0;
+	BOOL SharedQueueRelease(SHARED_QUEUE *Queue, UINT32 Position)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
 
-	#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
-		Queue->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
-	#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+		// Hand the slot to the producer of the next lap.
+		QueueAtomicStoreRelease(&(SharedQueueSlot(Queue, Position)->Sequence), Position + Queue->Mask + 1);
 
-	return (QUEUE*)Queue;
-}
+		SharedQueueSignal(&(Queue->Header->NotFull), &(Queue->Header->FullWaiters));
 
-BOOL QueueAdd(QUEUE *Queue, const void *Data)
-{
-	QUEUE_NODE *TempQueueNode;
+		return (BOOL)TRUE;
+	}
 
-	#if (QUEUE_SAFE_MODE == 1)
-		if(QueueIsNull(Queue))
+	BOOL SharedQueueAdd(SHARED_QUEUE *Queue, const void *Data, UINT32 Length, UINT32 Timeout)
+	{
+		UINT32 Position;
+		void *Slot;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Length > Queue->SlotSize || (Data == (const void*)NULL && Length))
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((Slot = SharedQueueReserve(Queue, &Position, Timeout)) == (void*)NULL)
 			return (BOOL)FALSE;
-	#endif // end of QUEUE_SAFE_MODE
 
-	// Allocate memory for the new node
-	if((TempQueueNode = (QUEUE_NODE*)QueueMemAlloc(sizeof(QUEUE_NODE))) == (QUEUE_NODE*)NULL) // MemAlloc defined in QueueConfig.h
+		if(Length)
+			memcpy(Slot, Data, (size_t)Length);
+
+		return SharedQueueCommit(Queue, Position, Length);
+	}
+
+	BOOL SharedQueueRemove(SHARED_QUEUE *Queue, void *Data, UINT32 *Length, UINT32 Timeout)
 	{
-		return (BOOL)FALSE;
+		UINT32 Position, Size;
+		void *Slot;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL || Data == (void*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
+
+		if((Slot = SharedQueueAcquire(Queue, &Position, &Size, Timeout)) == (void*)NULL)
+			return (BOOL)FALSE;
+
+		if(Size)
+			memcpy(Data, (const void*)Slot, (size_t)Size);
+
+		if(Length != (UINT32*)NULL)
+			*Length = Size;
+
+		return SharedQueueRelease(Queue, Position);
 	}
 
-	// Initialize the new node.
-	TempQueueNode->Data = (void*)Data;
-	TempQueueNode->Next = (QUEUE_NODE*)NULL;
+	UINT32 SharedQueueGetSize(SHARED_QUEUE *Queue)
+	{
+		UINT32 DequeuePos, EnqueuePos;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (SHARED_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		DequeuePos = (UINT32)QueueAtomicLoadAcquire(&(Queue->Header->DequeuePos));
+		EnqueuePos = (UINT32)QueueAtomicLoadAcquire(&(Queue->Header->EnqueuePos));
+
+		// Claimed but unfinished removes can briefly put DequeuePos ahead.
+		if((INT32)(EnqueuePos - DequeuePos) < (INT32)0)
+			return (UINT32)0;
+
+		return (UINT32)(EnqueuePos - DequeuePos);
+	}
+#endif // end of USING_QUEUE_SHARED
+
+#if (USING_QUEUE_MULTI == 1)
+	#include "unistd.h"
 
 	/*
-		Test for empty edge case, if so Tail and Head both point to the node.
-		Otherwise just append it to the end of the QUEUE.
+		The calling thread's state for every MULTI_QUEUE.  Threads are
+		numbered from 1 in the order they first use a MULTI_QUEUE, which
+		picks the shard they add to, and MultiQueueSeed drives their
+		random choices.  Both stay 0 until the thread's first call.
 	*/
-	if(QueueIsEmpty(Queue))
+	static UINT32 MultiQueueThreads;
+	static QUEUE_THREAD_LOCAL UINT32 MultiQueueThread;
+	static QUEUE_THREAD_LOCAL UINT32 MultiQueueSeed;
+
+	/*
+		The next number of the calling thread's xorshift generator.
+	*/
+	static UINT32 MultiQueueRandom(void)
 	{
-		Queue->Head = Queue->Tail = (QUEUE_NODE*)TempQueueNode;
+		UINT32 Seed;
+
+		if((Seed = MultiQueueSeed) == (UINT32)0)
+		{
+			MultiQueueThread = (UINT32)QueueAtomicAddRelaxed(&MultiQueueThreads, (UINT32)1) + (UINT32)1;
+
+			// Spread consecutive thread numbers apart, a seed of 0 would stay 0.
+			Seed = (UINT32)(MultiQueueThread * (UINT32)0x9E3779B9) | (UINT32)1;
+		}
+
+		Seed ^= Seed << 13;
+		Seed ^= Seed >> 17;
+		Seed ^= Seed << 5;
+
+		MultiQueueSeed = Seed;
+
+		return (UINT32)Seed;
 	}
-	else
+
+	/*
+		Adds Data to the back of a shard whose lock is held, doubling
+		the ring first if it is full.
+	*/
+	static BOOL MultiQueueShardPush(MULTI_QUEUE_SHARD *Shard, const void *Data)
 	{
-		Queue->Tail->Next = (QUEUE_NODE*)TempQueueNode;
-		Queue->Tail = (QUEUE_NODE*)TempQueueNode;
-	}
+		MULTI_QUEUE_ENTRY *Entries, *Entry;
+		UINT32 i;
 
-	// Increment the size.
-	Queue->Size++;
+		if(Shard->Size > Shard->Mask)
+		{
+			if(Shard->Mask >= (UINT32)0x7FFFFFFF / (UINT32)sizeof(MULTI_QUEUE_ENTRY))
+				return (BOOL)FALSE;
 
-	return (BOOL)TRUE;
-}
+			if((Entries = (MULTI_QUEUE_ENTRY*)QueueMemAlloc((Shard->Mask + 1) * 2 * sizeof(MULTI_QUEUE_ENTRY))) == (MULTI_QUEUE_ENTRY*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (BOOL)FALSE;
+			}
 
-void *QueueRemove(QUEUE *Queue)
-{
-	void *Data;
-	QUEUE_NODE *TempQueueNode;
+			// Unwrap the old ring into the front of the new one.
+			for(i = (UINT32)0; i < Shard->Size; i++)
+				Entries[i] = Shard->Entries[(Shard->First + i) & Shard->Mask];
 
-	#if (QUEUE_SAFE_MODE == 1)
-		if(QueueIsNull(Queue))
-			return (void*)NULL;
+			QueueMemDealloc((void*)(Shard->Entries)); // MemDealloc defined in QueueConfig.h
 
-		if(QueueIsEmpty(Queue))
-			return (void*)NULL;
-	#endif // end of QUEUE_SAFE_MODE
+			Shard->Entries = (MULTI_QUEUE_ENTRY*)Entries;
+			Shard->Mask = (Shard->Mask << 1) | (UINT32)1;
+			Shard->First = (UINT32)0;
+		}
+
+		Entry = &(Shard->Entries[(Shard->First + Shard->Size) & Shard->Mask]);
 
-	// Set the temp node to the QUEUE's Head.
-	TempQueueNode = (QUEUE_NODE*)(Queue->Head);
+		Entry->Data = (void*)Data;
+		Entry->Stamp = (UINT64)QueueGetTimestamp();
 
-	// Iterate the QUEUE's Head to the next node (We don't know if it's NULL yet).
-	Queue->Head = (QUEUE_NODE*)(Queue->Head->Next);
+		if(Shard->Size == (UINT32)0)
+			QueueAtomicStoreRelaxed(&(Shard->Oldest), Entry->Stamp);
+
+		QueueAtomicStoreRelaxed(&(Shard->Size), Shard->Size + 1);
+
+		return (BOOL)TRUE;
+	}
 
-	// Get a handle on the data of the node we're about to remove.
-	Data = (void*)(TempQueueNode->Data);
+	/*
+		Removes the front of a shard whose lock is held and which isn't empty.
+	*/
+	static void *MultiQueueShardPop(MULTI_QUEUE_SHARD *Shard)
+	{
+		void *Data;
 
-	// Free the old node.
-	QueueMemDealloc(TempQueueNode); // MemDealloc defined in QueueConfig.h
+		Data = (void*)(Shard->Entries[Shard->First].Data);
 
-	// Check to see if the Queue is now empty.
-	if(Queue->Head == (QUEUE_NODE*)NULL)
-		Queue->Tail = (QUEUE_NODE*)NULL;
+		Shard->First = (Shard->First + 1) & Shard->Mask;
 
-	// No matter what, decrement the QUEUE's size by one.
-	Queue->Size--;
+		QueueAtomicStoreRelaxed(&(Shard->Size), Shard->Size - 1);
+		QueueAtomicStoreRelaxed(&(Shard->Oldest), (Shard->Size) ? Shard->Entries[Shard->First].Stamp : (UINT64)QUEUE_MULTI_EMPTY);
 
-	return (void*)Data;
-}
+		return (void*)Data;
+	}
 
-#if (USING_QUEUE_PEEK_METHOD == 1)
-	void *QueuePeek(QUEUE *Queue)
+	MULTI_QUEUE *CreateMultiQueue(MULTI_QUEUE *Queue, UINT32 Shards, void (*CustomFreeMethod)(void *Data))
 	{
+		MULTI_QUEUE *TempQueue;
+		MULTI_QUEUE_SHARD *Shard;
+		long Processors;
+		UINT32 i;
+
+		// By default two shards per processor, so two threads seldom want the same one.
+		if(Shards == (UINT32)0)
+		{
+			Processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+			Shards = (Processors > 0L) ? (UINT32)Processors * (UINT32)2 : (UINT32)2;
+		}
+
 		#if (QUEUE_SAFE_MODE == 1)
-			if(QueueIsNull(Queue))
-				return (void*)NULL;
-	
-			if(QueueIsEmpty(Queue))	
-				return (void*)NULL;
+			if(Shards > (UINT32)0xFFFF)
+				return (MULTI_QUEUE*)NULL;
 		#endif // end of QUEUE_SAFE_MODE
 
-		return (void*)(Queue->Head->Data);
+		TempQueue = (MULTI_QUEUE*)Queue;
+
+		if(TempQueue == (MULTI_QUEUE*)NULL)
+		{
+			if((TempQueue = (MULTI_QUEUE*)QueueMemAlloc(sizeof(MULTI_QUEUE))) == (MULTI_QUEUE*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				return (MULTI_QUEUE*)NULL;
+			}
+		}
+
+		if((TempQueue->Shards = (MULTI_QUEUE_SHARD*)QueueMemAlloc(Shards * sizeof(MULTI_QUEUE_SHARD))) == (MULTI_QUEUE_SHARD*)NULL) // MemAlloc defined in QueueConfig.h
+		{
+			if(Queue == (MULTI_QUEUE*)NULL)
+				QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+			return (MULTI_QUEUE*)NULL;
+		}
+
+		for(i = (UINT32)0; i < Shards; i++)
+		{
+			Shard = &(TempQueue->Shards[i]);
+
+			if((Shard->Entries = (MULTI_QUEUE_ENTRY*)QueueMemAlloc((UINT32)QUEUE_MULTI_INITIAL_CAPACITY * sizeof(MULTI_QUEUE_ENTRY))) == (MULTI_QUEUE_ENTRY*)NULL) // MemAlloc defined in QueueConfig.h
+			{
+				while(i--)
+					QueueMemDealloc((void*)(TempQueue->Shards[i].Entries)); // MemDealloc defined in QueueConfig.h
+
+				QueueMemDealloc((void*)(TempQueue->Shards)); // MemDealloc defined in QueueConfig.h
+
+				if(Queue == (MULTI_QUEUE*)NULL)
+					QueueMemDealloc((void*)TempQueue); // MemDealloc defined in QueueConfig.h
+
+				return (MULTI_QUEUE*)NULL;
+			}
+
+			QueueLockInit(&(Shard->Lock));
+
+			Shard->Mask = (UINT32)QUEUE_MULTI_INITIAL_CAPACITY - 1;
+			Shard->First = Shard->Size = (UINT32)0;
+			Shard->Oldest = (UINT64)QUEUE_MULTI_EMPTY;
+		}
+
+		TempQueue->Count = (UINT32)Shards;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			TempQueue->QueueFreeMethod = (void(*)(void*))CustomFreeMethod;
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		return (MULTI_QUEUE*)TempQueue;
 	}
-#endif // end of USING_QUEUE_PEEK_METHOD
 
-#if (USING_QUEUE_CLEAR_METHOD == 1)
-	BOOL QueueClear(QUEUE *Queue)
+	BOOL DestroyMultiQueue(MULTI_QUEUE *Queue)
 	{
+		MULTI_QUEUE_SHARD *Shard;
+		void *Data;
+		UINT32 i;
+
 		#if (QUEUE_SAFE_MODE == 1)
-			if(QueueIsNull(Queue))
+			if(Queue == (MULTI_QUEUE*)NULL)
 				return (BOOL)FALSE;
-	
-			if(QueueIsEmpty(Queue))
-				return (BOOL)TRUE;
 		#endif // end of QUEUE_SAFE_MODE
 
-		while(Queue->Head != (QUEUE_NODE*)NULL)
+		for(i = (UINT32)0; i < Queue->Count; i++)
 		{
-			// Iterate the Tail pointer to the node after the Head.
-			Queue->Tail = (QUEUE_NODE*)(Queue->Head->Next);
-	
-			#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
-				if(Queue->QueueFreeMethod)
-				{
-					Queue->QueueFreeMethod((void*)(Queue->Head->Data));
-				}
-			#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
-	
-			QueueMemDealloc((void*)(Queue->Head)); // MemDealloc defined in QueueConfig.h
+			Shard = &(Queue->Shards[i]);
+
+			while(Shard->Size)
+			{
+				Data = MultiQueueShardPop(Shard);
+
+				#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+					if(Queue->QueueFreeMethod)
+						Queue->QueueFreeMethod(Data);
+				#else
+					(void)Data;
+				#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+			}
 
-			// Iterate the Head to the Tail.
-			Queue->Head = (QUEUE_NODE*)(Queue->Tail);
+			QueueMemDealloc((void*)(Shard->Entries)); // MemDealloc defined in QueueConfig.h
 		}
-	
-		// The size is now 0 since the QUEUE is empty.
-		Queue->Size = (UINT32)0;	
+
+		QueueMemDealloc((void*)(Queue->Shards)); // MemDealloc defined in QueueConfig.h
+
+		Queue->Shards = (MULTI_QUEUE_SHARD*)NULL;
+		Queue->Count = (UINT32)0;
 
 		return (BOOL)TRUE;
 	}
-#endif // end of USING_QUEUE_CLEAR_METHOD
 
-#if (USING_QUEUE_GET_SIZE_METHOD == 1)
-	UINT32 QueueGetSize(QUEUE *Queue)
+	BOOL MultiQueueAdd(MULTI_QUEUE *Queue, const void *Data)
 	{
+		MULTI_QUEUE_SHARD *Shard;
+		UINT32 Tries;
+		BOOL Added;
+
 		#if (QUEUE_SAFE_MODE == 1)
-			if(QueueIsNull(Queue))
-				return (UINT32)0;
+			if(Queue == (MULTI_QUEUE*)NULL)
+				return (BOOL)FALSE;
 		#endif // end of QUEUE_SAFE_MODE
 
-		return (UINT32)(Queue->Size);
+		// The first call numbers the thread.
+		if(MultiQueueThread == (UINT32)0)
+			(void)MultiQueueRandom();
+
+		Shard = &(Queue->Shards[(MultiQueueThread - 1) % Queue->Count]);
+
+		for(Tries = (UINT32)0; ; Tries++)
+		{
+			if(QueueTryLock(&(Shard->Lock)))
+				break;
+
+			// Somebody else is using the shard, rather than wait try another one.
+			if(Tries == Queue->Count)
+			{
+				QueueLock(&(Shard->Lock));
+
+				break;
+			}
+
+			Shard = &(Queue->Shards[MultiQueueRandom() % Queue->Count]);
+		}
+
+		Added = MultiQueueShardPush(Shard, Data);
+
+		QueueUnlock(&(Shard->Lock));
+
+		return (BOOL)Added;
 	}
-#endif // end of USING_QUEUE_GET_SIZE_METHOD
 
-UINT32 QueueGetSizeInBytes(QUEUE *Queue, UINT32 DataSizeInBytes)
-{
-	UINT32 Size;
+	void *MultiQueueRemove(MULTI_QUEUE *Queue)
+	{
+		MULTI_QUEUE_SHARD *Shard, *Other;
+		UINT64 Oldest, OtherOldest;
+		UINT32 Tries, Start, i;
+		void *Data;
 
-	#if (QUEUE_SAFE_MODE == 1)
-		if(QueueIsNull(Queue))
-			return (UINT32)0;
-	#endif // end of QUEUE_SAFE_MODE
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MULTI_QUEUE*)NULL)
+				return (void*)NULL;
+		#endif // end of QUEUE_SAFE_MODE
 
-	Size = (UINT32)sizeof(QUEUE);
+		for(Tries = (UINT32)0; Tries < Queue->Count; Tries++)
+		{
+			Shard = &(Queue->Shards[MultiQueueRandom() % Queue->Count]);
+			Other = &(Queue->Shards[MultiQueueRandom() % Queue->Count]);
+
+			Oldest = (UINT64)QueueAtomicLoadRelaxed(&(Shard->Oldest));
+			OtherOldest = (UINT64)QueueAtomicLoadRelaxed(&(Other->Oldest));
+
+			// Of the two fronts take the one added first.
+			if(OtherOldest < Oldest)
+			{
+				Shard = Other;
+				Oldest = OtherOldest;
+			}
+
+			if(Oldest == (UINT64)QUEUE_MULTI_EMPTY || !QueueTryLock(&(Shard->Lock)))
+				continue;
+
+			if(Shard->Size)
+			{
+				Data = MultiQueueShardPop(Shard);
+
+				QueueUnlock(&(Shard->Lock));
+
+				return (void*)Data;
+			}
+
+			QueueUnlock(&(Shard->Lock));
+		}
+
+		// The random choices kept missing, steal from any shard that has data.
+		Start = MultiQueueRandom() % Queue->Count;
+
+		for(i = (UINT32)0; i < Queue->Count; i++)
+		{
+			Shard = &(Queue->Shards[(Start + i) % Queue->Count]);
+
+			if(QueueAtomicLoadRelaxed(&(Shard->Size)) == (UINT32)0)
+				continue;
+
+			QueueLock(&(Shard->Lock));
+
+			if(Shard->Size)
+			{
+				Data = MultiQueueShardPop(Shard);
+
+				QueueUnlock(&(Shard->Lock));
+
+				return (void*)Data;
+			}
+
+			QueueUnlock(&(Shard->Lock));
+		}
+
+		return (void*)NULL;
+	}
+
+	UINT32 MultiQueueGetSize(MULTI_QUEUE *Queue)
+	{
+		UINT32 Size, i;
+
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Queue == (MULTI_QUEUE*)NULL)
+				return (UINT32)0;
+		#endif // end of QUEUE_SAFE_MODE
+
+		// No lock is taken, so the sum may be off by whatever is in flight.
+		for(Size = i = (UINT32)0; i < Queue->Count; i++)
+			Size += (UINT32)QueueAtomicLoadRelaxed(&(Queue->Shards[i].Size));
 
-	if(QueueIsEmpty(Queue))
 		return (UINT32)Size;
+	}
+#endif // end of USING_QUEUE_MULTI
 
-	/*
-		If the user provided us with the size of their data in bytes
-		then we must use it to calculate the size of the QUEUE in bytes.
-		Otherwise we just don't include it in the calculation.
-	*/
-	if(DataSizeInBytes)
-		Size += (Queue->Size * (DataSizeInBytes + (UINT32)sizeof(QUEUE_NODE)));
-	else
-		Size += (UINT32)(Queue->Size * (UINT32)sizeof(QUEUE_NODE));
+#if (USING_QUEUE_ALLOCATION_COUNTERS == 1)
+	BOOL QueueGetAllocationStats(QUEUE_ALLOCATION_STATS *Stats)
+	{
+		#if (QUEUE_SAFE_MODE == 1)
+			if(Stats == (QUEUE_ALLOCATION_STATS*)NULL)
+				return (BOOL)FALSE;
+		#endif // end of QUEUE_SAFE_MODE
 
-	return (UINT32)Size;
-}
+		Stats->Allocations = (UINT32)QueueAtomicLoadRelaxed(&(QueueAllocationStats.Allocations));
+		Stats->FailedAllocations = (UINT32)QueueAtomicLoadRelaxed(&(QueueAllocationStats.FailedAllocations));
+		Stats->Deallocations = (UINT32)QueueAtomicLoadRelaxed(&(QueueAllocationStats.Deallocations));
+
+		return (BOOL)TRUE;
+	}
+
+	void QueueResetAllocationStats(void)
+	{
+		QueueAtomicStoreRelease(&(QueueAllocationStats.Allocations), (UINT32)0);
+		QueueAtomicStoreRelease(&(QueueAllocationStats.FailedAllocations), (UINT32)0);
+		QueueAtomicStoreRelease(&(QueueAllocationStats.Deallocations), (UINT32)0);
+	}
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
 
 #if (USING_QUEUE_GET_LIBRARY_VERSION == 1)
 
-	const BYTE QueueLibraryVersion[] = {"Queue Lib v1.03\0"};
+	const BYTE QueueLibraryVersion[] = {"Queue Lib v1.04\0"};
 	
 	const BYTE *QueueGetLibraryVersion(void)
 	{
@@ -1,7 +1,7 @@
 /*
 	Date: June 24, 2011
 	File Name: Queue.h
-	Version: 1.03
+	Version: 1.04
 	IDE: Visual Studio 2010 Professional
 	Compiler: C89
 
@@ -19,7 +19,7 @@
 /*! \mainpage Queue Library
  *  \brief This is a Library written in C for manipulating a Queue Data Structure.
  *  \author brodie
- *  \version 1.03
+ *  \version 1.04
  *  \date   April 4, 2011
  */
 
@@ -61,6 +61,352 @@
 */
 QUEUE *CreateQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data));
 
+/*
+	Function: QUEUE *CreateIntrusiveQueue(QUEUE *Queue, UINT32 NodeOffset, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 NodeOffset - The offset in bytes of the QUEUE_NODE embedded in
+		the data that will be added to the QUEUE, see QueueGetNodeOffset().
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created then (QUEUE*)NULL is returned.
+
+	Description: Creates a new QUEUE that links the QUEUE_NODE embedded in 
+	each piece of data instead of allocating one.  QueueAdd(), QueueRemove()
+	and QueueClear() never call QueueMemAlloc() or QueueMemDealloc() for it.
+
+	Notes: A piece of data can only be in one intrusive QUEUE per embedded 
+	QUEUE_NODE at a time, and QueueAdd() fails for NULL data.  QueueClear()
+	still hands each piece of data to CustomFreeMethod, which may free it.
+	USING_QUEUE_INTRUSIVE must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes an intrusive QUEUE, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @param NodeOffset - The offset of the QUEUE_NODE embedded in the data.
+		* @return *QUEUE - The address of the QUEUE in memory, or NULL.
+		* @note USING_QUEUE_INTRUSIVE must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateQueue(), QueueGetNodeOffset()
+		* @since v1.04
+*/
+#if (USING_QUEUE_INTRUSIVE == 1)
+	QUEUE *CreateIntrusiveQueue(QUEUE *Queue, UINT32 NodeOffset, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_INTRUSIVE
+
+/*
+	Function: QUEUE *CreateCopyQueue(QUEUE *Queue, UINT32 ElementSize, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 ElementSize - The size in bytes of every element stored in the QUEUE.
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created, or ElementSize is 0,
+		then (QUEUE*)NULL is returned.
+
+	Description: Creates a new QUEUE that stores elements by value.  Each
+	element is copied in by QueueAddCopy() and out by QueueRemoveInto(), and
+	lives in the same allocation as its QUEUE_NODE, so the caller never has
+	to allocate the element itself.
+
+	Notes: QueueRemove(), QueueRemoveBatch(), QueueDrain() and QueueRemoveWait()
+	refuse a copy QUEUE, and QueuePeek() returns a pointer that is only valid
+	until the element is removed.  QueueClear() passes CustomFreeMethod a pointer
+	to each stored copy, which it must not free.  USING_QUEUE_COPY must be 
+	defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a copy QUEUE, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @param ElementSize - The size in bytes of every element.
+		* @return *QUEUE - The address of the QUEUE in memory, or NULL.
+		* @note USING_QUEUE_COPY must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAddCopy(), QueueRemoveInto()
+		* @since v1.04
+*/
+#if (USING_QUEUE_COPY == 1)
+	QUEUE *CreateCopyQueue(QUEUE *Queue, UINT32 ElementSize, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_COPY
+
+/*
+	Function: QUEUE *CreateRingQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Capacity - The most pieces of data the QUEUE can hold.  This is
+		rounded up to the next power of two.
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created then (QUEUE*)NULL is returned.
+
+	Description: Creates a new QUEUE whose data is stored in one array
+	allocated with QueueMemAlloc().  QueueAdd() will never allocate for
+	this QUEUE, instead it returns FALSE once the QUEUE is full.
+
+	Notes: The array must be given back with DestroyRingQueue().  
+	USING_QUEUE_RING_BUFFER must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a fixed capacity ring QUEUE, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @param Capacity - The most pieces of data the QUEUE can hold, rounded
+		up to a power of two.
+		* @return *QUEUE - The address of the QUEUE in memory.  If a QUEUE could
+		not be allocated or Capacity was 0, returns a NULL QUEUE pointer.
+		* @note USING_QUEUE_RING_BUFFER must be defined as 1 in QueueConfig.h to use method.
+		* @sa DestroyRingQueue(), QueueMemAlloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RING_BUFFER == 1)
+	QUEUE *CreateRingQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_RING_BUFFER
+
+/*
+	Function: BOOL DestroyRingQueue(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the ring QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the array of the QUEUE was freed, FALSE if the QUEUE
+		was NULL or was not created with CreateRingQueue().
+
+	Description: Removes every piece of data from a ring QUEUE, handing each
+	to the QUEUE's free method, then frees the array of the QUEUE.  The QUEUE
+	itself is not freed.
+
+	Notes: USING_QUEUE_RING_BUFFER must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Clears a ring QUEUE and frees its array.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_RING_BUFFER must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateRingQueue(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RING_BUFFER == 1)
+	BOOL DestroyRingQueue(QUEUE *Queue);
+#endif // end of USING_QUEUE_RING_BUFFER
+
+/*
+	Function: QUEUE *CreateBoundedQueue(QUEUE *Queue, UINT32 Limit, BYTE Policy, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Limit - The most pieces of data the QUEUE will hold.
+		BYTE Policy - What happens to data added while the QUEUE is at its
+		limit, one of the QUEUE_OVERFLOW_* defines in QueueObject.h.
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created then (QUEUE*)NULL is returned.
+
+	Description: Creates a new linked QUEUE which never holds more than
+	Limit pieces of data.  At the limit QUEUE_OVERFLOW_REJECT makes QueueAdd()
+	return FALSE, QUEUE_OVERFLOW_BLOCK makes QueueAdd() wait for room,
+	QUEUE_OVERFLOW_DROP_OLDEST removes the front of the QUEUE to make room and
+	QUEUE_OVERFLOW_DROP_NEWEST throws away the data being added.  Dropped data
+	is handed to the QUEUE's free method and counted, see QueueGetDropCount().
+
+	Notes: A dropped piece of data still makes QueueAdd() return TRUE.
+	QueueAddBatch() with a batch that doesn't fit fails as a whole under
+	QUEUE_OVERFLOW_REJECT, and waits until all of it fits under 
+	QUEUE_OVERFLOW_BLOCK.  A batch larger than Limit always fails.  The
+	front of the QUEUE thrown away by QUEUE_OVERFLOW_DROP_OLDEST counts as
+	cleared, not as removed, in the QUEUE_STATS.  QUEUE_OVERFLOW_BLOCK needs
+	USING_QUEUE_BLOCKING_METHODS.  USING_QUEUE_BOUNDED must be defined as 1 
+	in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a QUEUE with a size limit, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @param Limit - The most pieces of data the QUEUE will hold.
+		* @param Policy - One of the QUEUE_OVERFLOW_* defines.
+		* @return *QUEUE - The address of the QUEUE in memory.  If a QUEUE could
+		not be allocated, Limit was 0 or Policy is not known, returns a NULL 
+		QUEUE pointer.
+		* @note USING_QUEUE_BOUNDED must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueGetDropCount(), QueueAddWait()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BOUNDED == 1)
+	QUEUE *CreateBoundedQueue(QUEUE *Queue, UINT32 Limit, BYTE Policy, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_BOUNDED
+
+/*
+	Function: UINT32 QueueGetDropCount(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of pieces of data the overflow policy of the 
+		QUEUE has thrown away.
+
+	Description: Returns how many pieces of data a QUEUE created with
+	CreateBoundedQueue() has dropped, oldest and newest together.
+
+	Notes: USING_QUEUE_BOUNDED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of pieces of data a bounded QUEUE dropped.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return UINT32 - The drop count, 0 for a NULL QUEUE.
+		* @note USING_QUEUE_BOUNDED must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateBoundedQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BOUNDED == 1)
+	UINT32 QueueGetDropCount(QUEUE *Queue);
+#endif // end of USING_QUEUE_BOUNDED
+
+/*
+	Function: QUEUE *CreatePriorityQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Capacity - The number of pieces of data the heap starts with 
+		room for, it doubles whenever it runs out.
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created then (QUEUE*)NULL is returned.
+
+	Description: Creates a new QUEUE ordered by priority.  QueueRemove() and
+	QueuePeek() return the data with the highest priority and, among equal 
+	priorities, the data that was added first.  Adding and removing are 
+	O(log n) on a QUEUE_PRIORITY_HEAP_ARITY-ary heap kept in one array.
+
+	Notes: QueueAdd() adds with priority 0.  The heap only shrinks when 
+	DestroyPriorityQueue() frees it.  USING_QUEUE_PRIORITY must be defined 
+	as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a priority QUEUE, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @param Capacity - The initial room of the heap.
+		* @return *QUEUE - The address of the QUEUE in memory, or NULL.
+		* @note USING_QUEUE_PRIORITY must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAddWithPriority(), DestroyPriorityQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PRIORITY == 1)
+	QUEUE *CreatePriorityQueue(QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_PRIORITY
+
+/*
+	Function: BOOL DestroyPriorityQueue(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the priority QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the heap was freed, FALSE if the QUEUE was NULL or not 
+		a priority QUEUE.
+
+	Description: Hands every piece of data still in the QUEUE to the free
+	method and frees the heap.  The QUEUE itself is not freed.
+
+	Notes: USING_QUEUE_PRIORITY must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees the heap of a priority QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_PRIORITY must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreatePriorityQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PRIORITY == 1)
+	BOOL DestroyPriorityQueue(QUEUE *Queue);
+#endif // end of USING_QUEUE_PRIORITY
+
+/*
+	Function: QUEUE *CreateTimerQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE will be inititalized.
+		If NULL is passed in then this method will create a QUEUE out of
+		the heap with a call to QueueMemAlloc().
+
+	Returns:
+		QUEUE* - The address at which the newly initialized QUEUE resides
+		in memory.  If a new QUEUE could not be created then (QUEUE*)NULL is returned.
+
+	Description: Creates a new QUEUE whose data only comes out once it is 
+	due.  Data added with QueueAddAt() waits on a hierarchical timing wheel 
+	of QUEUE_TIMER_LEVELS levels of QUEUE_TIMER_SLOTS slots, so adding and
+	expiring a timer costs the same no matter how many are pending.  Data
+	that is due is moved to the end of the QUEUE, in the order it came due, 
+	by the next call that looks at the QUEUE.  QueueAdd() adds data that is 
+	due right away.
+
+	Notes: Deadlines are in the milliseconds of QueueGetTickCount() and have 
+	a resolution of one millisecond.  QueueGetSize() counts only the data that
+	was due at the last call.  USING_QUEUE_TIMER must be defined as 1 in 
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a timer QUEUE, and can create a QUEUE.
+		* @param *Queue - A pointer to an already allocate QUEUE or a NULL QUEUE 
+		pointer to create a QUEUE from QueueMemAlloc().
+		* @return *QUEUE - The address of the QUEUE in memory, or NULL.
+		* @note USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAddAt(), QueueGetNextDeadline(), DestroyTimerQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_TIMER == 1)
+	QUEUE *CreateTimerQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_TIMER
+
+/*
+	Function: BOOL DestroyTimerQueue(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the timer QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the wheel was freed, FALSE if the QUEUE was NULL or not 
+		a timer QUEUE.
+
+	Description: Hands every piece of data in the QUEUE, due or not, to the 
+	free method and frees the wheel and its timers.  The QUEUE itself is not 
+	freed, it is left as an empty linked QUEUE.
+
+	Notes: USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees the wheel of a timer QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateTimerQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_TIMER == 1)
+	BOOL DestroyTimerQueue(QUEUE *Queue);
+#endif // end of USING_QUEUE_TIMER
+
 /*
 	Function: BOOL QueueAdd(QUEUE *Queue, const void *Data)
 
@@ -94,6 +440,102 @@ QUEUE *CreateQueue(QUEUE *Queue, void (*CustomFreeMethod)(void *Data));
 */
 BOOL QueueAdd(QUEUE *Queue, const void *Data);
 
+/*
+	Function: BOOL QueueAddWithPriority(QUEUE *Queue, const void *Data, UINT32 Priority)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the priority QUEUE resides in memory.
+		const void *Data - The data to store in the QUEUE.
+		UINT32 Priority - The priority of the data, higher is removed first.
+
+	Returns:
+		BOOL - TRUE if the data was stored, FALSE if the QUEUE is not a
+		priority QUEUE, was closed or the heap could not grow.
+
+	Description: Adds data to a priority QUEUE in O(log n).  Data added 
+	with equal priorities is removed in the order it was added.
+
+	Notes: USING_QUEUE_PRIORITY must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data into a priority QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Data - The data to store.
+		* @param Priority - The priority of the data, higher is removed first.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_PRIORITY must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreatePriorityQueue(), QueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PRIORITY == 1)
+	BOOL QueueAddWithPriority(QUEUE *Queue, const void *Data, UINT32 Priority);
+#endif // end of USING_QUEUE_PRIORITY
+
+/*
+	Function: BOOL QueueAddAt(QUEUE *Queue, const void *Data, UINT32 Deadline)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the timer QUEUE resides in memory.
+		const void *Data - The data to store in the QUEUE.
+		UINT32 Deadline - The QueueGetTickCount() at which the data is due.
+
+	Returns:
+		BOOL - TRUE if the data was stored, FALSE if the QUEUE is not a
+		timer QUEUE, was closed or a timer could not be allocated.
+
+	Description: Adds data to a timer QUEUE that QueueRemove() will not 
+	return before Deadline.  A Deadline that has already passed makes the
+	data due right away.  Deadlines wrap with QueueGetTickCount() and may 
+	be up to 2^31 - 1 milliseconds away.  Timers are reused once they fire, 
+	so a busy QUEUE stops allocating.
+
+	Notes: USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data into a timer QUEUE that is due at Deadline.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Data - The data to store.
+		* @param Deadline - The QueueGetTickCount() at which the data is due.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateTimerQueue(), QueueGetNextDeadline(), QueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_TIMER == 1)
+	BOOL QueueAddAt(QUEUE *Queue, const void *Data, UINT32 Deadline);
+#endif // end of USING_QUEUE_TIMER
+
+/*
+	Function: BOOL QueueGetNextDeadline(QUEUE *Queue, UINT32 *Deadline)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the timer QUEUE resides in memory.
+		UINT32 *Deadline - Receives the QueueGetTickCount() at which the 
+		next piece of data is due.
+
+	Returns:
+		BOOL - TRUE if Deadline was set, FALSE if nothing is due or pending
+		or the QUEUE is not a timer QUEUE.
+
+	Description: Tells a caller how long it can sleep before QueueRemove()
+	has something to return.  If data is due already Deadline is the 
+	current tick.  QueueRemoveWait() on a timer QUEUE does this on its own.
+
+	Notes: USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Gets the tick at which the next data in a timer QUEUE is due.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Deadline - Receives the deadline.
+		* @return BOOL - TRUE if there is a deadline, FALSE otherwise.
+		* @note USING_QUEUE_TIMER must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAddAt(), QueueRemoveWait()
+		* @since v1.04
+*/
+#if (USING_QUEUE_TIMER == 1)
+	BOOL QueueGetNextDeadline(QUEUE *Queue, UINT32 *Deadline);
+#endif // end of USING_QUEUE_TIMER
+
 /*
 	Function: void *QueueRemove(QUEUE *Queue)
 
@@ -123,6 +565,64 @@ BOOL QueueAdd(QUEUE *Queue, const void *Data);
 */
 void *QueueRemove(QUEUE *Queue);
 
+/*
+	Function: BOOL QueueAddCopy(QUEUE *Queue, const void *Element)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the copy QUEUE resides in memory.
+		const void *Element - The element to copy to the end of the QUEUE.
+
+	Returns:
+		BOOL - TRUE if the element was copied into the QUEUE, FALSE if the QUEUE
+		is not a copy QUEUE or a QUEUE_NODE could not be allocated.
+
+	Description: Copies ElementSize bytes from Element into a new QUEUE_NODE 
+	at the end of the QUEUE with a single call to QueueMemAlloc().
+
+	Notes: USING_QUEUE_COPY must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Copies an element to the end of a copy QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Element - The element to copy.
+		* @return BOOL - TRUE if the operation was successful.
+		* @note USING_QUEUE_COPY must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateCopyQueue(), QueueRemoveInto()
+		* @since v1.04
+*/
+#if (USING_QUEUE_COPY == 1)
+	BOOL QueueAddCopy(QUEUE *Queue, const void *Element);
+#endif // end of USING_QUEUE_COPY
+
+/*
+	Function: BOOL QueueRemoveInto(QUEUE *Queue, void *Element)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the copy QUEUE resides in memory.
+		void *Element - Where to copy the element removed from the QUEUE.
+
+	Returns:
+		BOOL - TRUE if an element was copied out, FALSE if the QUEUE is empty
+		or is not a copy QUEUE.
+
+	Description: Copies the element at the beginning of the QUEUE into Element
+	and frees its QUEUE_NODE.
+
+	Notes: USING_QUEUE_COPY must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the next element of a copy QUEUE into the caller's memory.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Element - Receives ElementSize bytes.
+		* @return BOOL - TRUE if an element was removed.
+		* @note USING_QUEUE_COPY must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateCopyQueue(), QueueAddCopy()
+		* @since v1.04
+*/
+#if (USING_QUEUE_COPY == 1)
+	BOOL QueueRemoveInto(QUEUE *Queue, void *Element);
+#endif // end of USING_QUEUE_COPY
+
 /*
 	Function: void *QueuePeek(QUEUE *Queue)
 
@@ -189,6 +689,95 @@ void *QueueRemove(QUEUE *Queue);
 	BOOL QueueClear(QUEUE *Queue);
 #endif // end of USING_QUEUE_CLEAR_METHOD
 
+/*
+	Function: BOOL QueueClearDeferred(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the QUEUE is now empty, FALSE if a NULL referenced
+		QUEUE was passed in.
+
+	Description: Empties the QUEUE like QueueClear(), but a linked QUEUE
+	only has its QUEUE_NODE's detached, in constant time, while the
+	reclaimer thread calls the free method on the data and frees the
+	QUEUE_NODE's later.  Ring and priority QUEUE's, and every QUEUE while
+	the reclaimer isn't running, are cleared right away by QueueClear().
+
+	Notes: The data must not be used once handed over.  USING_QUEUE_DEFERRED_CLEAR 
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Empties a QUEUE at once and frees its contents on the reclaimer thread.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if the QUEUE was emptied, FALSE otherwise.
+		* @note Falls back to QueueClear() when the reclaimer isn't running.
+		USING_QUEUE_DEFERRED_CLEAR must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueClear(), QueueStartReclaimer()
+		* @since v1.04
+*/
+#if (USING_QUEUE_DEFERRED_CLEAR == 1)
+	BOOL QueueClearDeferred(QUEUE *Queue);
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
+/*
+	Function: BOOL QueueStartReclaimer(void)
+
+	Parameters: 
+		None
+
+	Returns:
+		BOOL - TRUE if the reclaimer thread was started, FALSE if it is
+		already running or the thread could not be created.
+
+	Description: Starts the background thread which frees everything 
+	handed over by QueueClearDeferred().
+
+	Notes: QueueClearDeferred() may run on any thread at any time, but
+	QueueStartReclaimer() and QueueStopReclaimer() must be called from one 
+	thread at a time.  USING_QUEUE_DEFERRED_CLEAR must be defined as 1 in
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Starts the reclaimer thread used by QueueClearDeferred().
+		* @return BOOL - TRUE if the thread was started, FALSE otherwise.
+		* @note USING_QUEUE_DEFERRED_CLEAR must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueStopReclaimer(), QueueClearDeferred()
+		* @since v1.04
+*/
+#if (USING_QUEUE_DEFERRED_CLEAR == 1)
+	BOOL QueueStartReclaimer(void);
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
+/*
+	Function: BOOL QueueStopReclaimer(void)
+
+	Parameters: 
+		None
+
+	Returns:
+		BOOL - TRUE if the reclaimer thread was stopped, FALSE if it 
+		wasn't running.
+
+	Description: Waits for the reclaimer thread to free everything handed
+	over so far and then stops it.  QueueClearDeferred() calls racing with
+	the stop free their data themselves.  QueueStartReclaimer() may start
+	it again afterwards.
+
+	Notes: USING_QUEUE_DEFERRED_CLEAR must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees everything still pending and stops the reclaimer thread.
+		* @return BOOL - TRUE if the thread was stopped, FALSE otherwise.
+		* @note USING_QUEUE_DEFERRED_CLEAR must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueStartReclaimer(), QueueClearDeferred()
+		* @since v1.04
+*/
+#if (USING_QUEUE_DEFERRED_CLEAR == 1)
+	BOOL QueueStopReclaimer(void);
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
 /*
 	Function: UINT32 QueueGetSize(QUEUE *Queue)
 
@@ -235,8 +824,9 @@ void *QueueRemove(QUEUE *Queue);
 	Description: Returns the size of the referenced QUEUE in bytes.
 
 	Notes: This method does not take into account how much memory is used to allocate 
-	memory through QueueMemAlloc().  USING_QUEUE_GET_SIZE_IN_BYTES_METHOD must be defined as
-	1 in QueueConfig.h to use method
+	memory through QueueMemAlloc().  For a copy QUEUE DataSizeInBytes is ignored and the
+	elements stored inline are counted instead.  USING_QUEUE_GET_SIZE_IN_BYTES_METHOD must
+	be defined as 1 in QueueConfig.h to use method
 */
 /**
 		* @brief Returns how much memory in bytes a QUEUE consumes.
@@ -285,24 +875,2019 @@ void *QueueRemove(QUEUE *Queue);
 #endif // end of USING_QUEUE_GET_LIBRARY_VERSION
 
 /*
-	Macro: UINT32 QueueGetSizeOfNodeInBytes(UINT32 DataSizeInBytes)
+	Function: BOOL QueueAddBatch(QUEUE *Queue, const void **Items, UINT32 Count)
 
 	Parameters: 
-		UINT32 DataSizeInBytes - The size in bytes of the data being stored in a QUEUE.
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		const void **Items - The data to store at the end of the QUEUE, 
+		Items[0] is the first to be removed.
+		UINT32 Count - The number of pieces of data in Items.
 
 	Returns:
-		UINT32 - The size in bytes that the QUEUE_NODE takes up with it's accompaning
-		data.
+		BOOL - TRUE if every piece of data was stored.  FALSE if the QUEUE 
+		pointer was NULL, there was not enough room or memory for all of them,
+		in which case none of them were stored.
 
-	Description: Returns the size of a QUEUE_NODE and it's data in bytes.
+	Description: Pushes Count items onto the QUEUE at once.  The QUEUE_NODE's
+	are linked into a chain first and then appended to the QUEUE in a single
+	step, so the QUEUE's size, tail and lock are only touched once.
 
-	Notes: This method does not take into account how much memory is used to allocate 
-	memory through QueueMemAlloc().
+	Notes: With the node pool every node of the batch is taken from the pool
+	under one lock.  USING_QUEUE_BATCH_METHODS must be defined as 1 in 
+	QueueConfig.h to use method.
 */
-#define QueueGetSizeOfNodeInBytes(Size)			(UINT32)(Size + sizeof(QUEUE_NODE))
+/**
+		* @brief Puts many pieces of data at the end of a QUEUE at once.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param **Items - The data to store, in order.
+		* @param Count - The number of pieces of data in Items.
+		* @return BOOL - TRUE if all of them were stored, FALSE if none were.
+		* @note USING_QUEUE_BATCH_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAdd(), QueueRemoveBatch()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	BOOL QueueAddBatch(QUEUE *Queue, const void **Items, UINT32 Count);
+#endif // end of USING_QUEUE_BATCH_METHODS
 
 /*
-	Macro: BOOL QueueIsNull(QUEUE *Queue)
+	Function: UINT32 QueueRemoveBatch(QUEUE *Queue, void **Items, UINT32 Max)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		void **Items - The array the removed data is stored into, in order.
+		UINT32 Max - The most pieces of data to remove.
+
+	Returns:
+		UINT32 - The number of pieces of data removed and stored into Items.
+
+	Description: Removes up to Max items from the beginning of the QUEUE at 
+	once.  The emptied QUEUE_NODE's come off as one chain and are freed 
+	together.
+
+	Notes: USING_QUEUE_BATCH_METHODS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes many pieces of data from the beginning of a QUEUE at once.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param **Items - The array the removed data is stored into.
+		* @param Max - The most pieces of data to remove.
+		* @return UINT32 - The number of pieces of data removed.
+		* @note USING_QUEUE_BATCH_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueRemove(), QueueAddBatch()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	UINT32 QueueRemoveBatch(QUEUE *Queue, void **Items, UINT32 Max);
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+/*
+	Function: void **QueueDrain(QUEUE *Queue, UINT32 *Count)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		UINT32 *Count - The address at which the number of pieces of data
+		removed is stored.
+
+	Returns:
+		void** - An array allocated with QueueMemAlloc() holding every piece
+		of data that was in the QUEUE, in order.  (void**)NULL if the QUEUE
+		was empty or NULL, or if the array could not be allocated in which
+		case the QUEUE is left untouched.
+
+	Description: Removes everything from the QUEUE at once.  A linked QUEUE
+	is detached in one step, so with USING_QUEUE_BLOCKING_METHODS the lock
+	is only held while the Head and Tail are taken.  Producers waiting for
+	room are woken and an event file descriptor is rearmed, as when a
+	remove finds the QUEUE empty.
+
+	Notes: The array must be freed by the user with QueueMemDealloc().
+	USING_QUEUE_BATCH_METHODS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes every piece of data of a QUEUE into a new array.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Count - Set to the number of pieces of data removed.
+		* @return void** - The array of removed data, or (void**)NULL.
+		* @note The array is allocated with QueueMemAlloc().  USING_QUEUE_BATCH_METHODS 
+		must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueRemoveBatch(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BATCH_METHODS == 1)
+	void **QueueDrain(QUEUE *Queue, UINT32 *Count);
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+/*
+	Function: BOOL QueueAppendQueue(QUEUE *Destination, QUEUE *Source)
+
+	Parameters: 
+		QUEUE *Destination - The address at which the QUEUE that receives
+		the data resides in memory.
+		QUEUE *Source - The address at which the QUEUE that is emptied
+		resides in memory.
+
+	Returns:
+		BOOL - TRUE if everything in Source now follows the data of
+		Destination, FALSE otherwise.
+
+	Description: Moves every piece of data of Source onto the end of 
+	Destination, in order, by linking the QUEUE_NODE's of Source behind
+	the Tail of Destination.  Takes constant time and never allocates or
+	frees a QUEUE_NODE.
+
+	Notes: Both QUEUE's must be linked QUEUE's of the same kind, ring and
+	priority QUEUE's are refused.  Intrusive QUEUE's need the same node
+	offset and copy QUEUE's the same element size.  With
+	USING_QUEUE_BLOCKING_METHODS a closed Destination is refused.
+	USING_QUEUE_SPLICE_METHODS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Moves everything from one QUEUE onto the end of another in constant time.
+		* @param *Destination - The address at which the receiving QUEUE resides in memory.
+		* @param *Source - The address at which the QUEUE to empty resides in memory.
+		* @return BOOL - TRUE on success, FALSE otherwise.
+		* @note Only linked QUEUE's of the same kind can be appended.  USING_QUEUE_SPLICE_METHODS 
+		must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueSwap(), QueueSplitAfter()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPLICE_METHODS == 1)
+	BOOL QueueAppendQueue(QUEUE *Destination, QUEUE *Source);
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+/*
+	Function: BOOL QueueSwap(QUEUE *First, QUEUE *Second)
+
+	Parameters: 
+		QUEUE *First - The address at which the first QUEUE resides in memory.
+		QUEUE *Second - The address at which the second QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the contents were swapped, FALSE otherwise.
+
+	Description: Exchanges the contents of two QUEUE's in constant time.
+	Only the data trades places, each QUEUE keeps its own lock, waiters,
+	free method and statistics.  The data swapped counts as neither added
+	nor removed, only the high water mark can change.
+
+	Notes: Both QUEUE's must be of the same kind, any kind works including
+	ring and priority QUEUE's.  With USING_QUEUE_BLOCKING_METHODS closed
+	QUEUE's are refused.  USING_QUEUE_SPLICE_METHODS must be defined as 1 
+	in QueueConfig.h to use method.
+*/
+/**
+		* @brief Exchanges the contents of two QUEUE's in constant time.
+		* @param *First - The address at which the first QUEUE resides in memory.
+		* @param *Second - The address at which the second QUEUE resides in memory.
+		* @return BOOL - TRUE on success, FALSE otherwise.
+		* @note Both QUEUE's must be of the same kind.  USING_QUEUE_SPLICE_METHODS 
+		must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAppendQueue(), QueueSplitAfter()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPLICE_METHODS == 1)
+	BOOL QueueSwap(QUEUE *First, QUEUE *Second);
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+/*
+	Function: BOOL QueueSplitAfter(QUEUE *Queue, UINT32 Count, QUEUE *Out)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE to split resides in memory.
+		UINT32 Count - The number of pieces of data to keep in Queue.
+		QUEUE *Out - The address at which the QUEUE that receives the rest
+		resides in memory.
+
+	Returns:
+		BOOL - TRUE if Queue now holds at most Count pieces of data,
+		FALSE otherwise.
+
+	Description: Keeps the first Count pieces of data in Queue and moves
+	the rest, in order, onto the end of Out.  Finding the split takes one
+	step per QUEUE_NODE kept, the move itself takes constant time.  
+	Nothing moves if Queue holds Count pieces of data or fewer.
+
+	Notes: The same kinds of QUEUE's as QueueAppendQueue() are accepted.
+	With USING_QUEUE_SEGMENTED_NODES a split inside a QUEUE_NODE needs 
+	one new QUEUE_NODE for its end, FALSE is returned if it can't be 
+	allocated.  USING_QUEUE_SPLICE_METHODS must be defined as 1 in 
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Moves everything after the first Count pieces of data onto the end of another QUEUE.
+		* @param *Queue - The address at which the QUEUE to split resides in memory.
+		* @param Count - The number of pieces of data to keep.
+		* @param *Out - The address at which the receiving QUEUE resides in memory.
+		* @return BOOL - TRUE on success, FALSE otherwise.
+		* @note USING_QUEUE_SPLICE_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAppendQueue(), QueueSwap()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPLICE_METHODS == 1)
+	BOOL QueueSplitAfter(QUEUE *Queue, UINT32 Count, QUEUE *Out);
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+/*
+	Function: void *QueueRemoveWait(QUEUE *Queue, UINT32 Timeout)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		UINT32 Timeout - The most milliseconds to wait for data, 0 to not
+		wait at all or QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		void* - The data of the next item that was removed from the QUEUE.  
+		If no item arrived in time, the QUEUE was closed and empty, or if the
+		Queue is a NULL reference then this method returns (void*)NULL.
+
+	Description: Removes one item from the beginning of the QUEUE, waiting
+	for one to be added if the QUEUE is empty.
+
+	Notes: The waiting thread sleeps on a condition variable, QueueAdd() only
+	signals it when a thread is actually waiting.  USING_QUEUE_BLOCKING_METHODS
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the next data of a QUEUE, waiting for it if needed.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param Timeout - The most milliseconds to wait, or QUEUE_WAIT_FOREVER.
+		* @return void* - The data removed, or (void*)NULL on timeout or close.
+		* @note USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueRemove(), QueueClose()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	void *QueueRemoveWait(QUEUE *Queue, UINT32 Timeout);
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+/*
+	Function: BOOL QueueAddWait(QUEUE *Queue, const void *Data, UINT32 Timeout)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		const void *Data - The data to store at the end of the QUEUE.
+		UINT32 Timeout - The most milliseconds to wait for room, 0 to not
+		wait at all or QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		BOOL - TRUE if the data was stored.  FALSE if no room was made in 
+		time, the QUEUE was closed, the Queue was NULL or memory ran out.
+
+	Description: Pushes one item onto the QUEUE, waiting for room if the
+	QUEUE is full.  Only a bounded QUEUE, such as a ring QUEUE, can be full,
+	for any other QUEUE this method behaves like QueueAdd().
+
+	Notes: USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data at the end of a QUEUE, waiting for room if needed.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Data - The data to store.
+		* @param Timeout - The most milliseconds to wait, or QUEUE_WAIT_FOREVER.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueAdd(), QueueClose()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	BOOL QueueAddWait(QUEUE *Queue, const void *Data, UINT32 Timeout);
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+/*
+	Function: BOOL QueueClose(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the QUEUE was closed, FALSE if the Queue was NULL.
+
+	Description: Closes the QUEUE and releases every thread waiting in
+	QueueRemoveWait() or QueueAddWait().  Afterwards QueueAdd() and 
+	QueueAddWait() fail, while the data already in the QUEUE can still be
+	removed.  QueueRemoveWait() no longer waits once the QUEUE is empty.
+
+	Notes: USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Closes a QUEUE and wakes every waiting thread.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueRemoveWait(), QueueAddWait()
+		* @since v1.04
+*/
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	BOOL QueueClose(QUEUE *Queue);
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+/*
+	Function: int QueueOpenEventFd(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+
+	Returns:
+		int - The event file descriptor of the QUEUE, or -1 if the QUEUE was
+		NULL or the descriptor could not be created.
+
+	Description: Gives the QUEUE an event file descriptor, or returns the
+	one it already has.  The descriptor becomes readable when data is added
+	to a QUEUE a consumer last found empty, and stays readable until a
+	consumer finds it empty again.  The consumer therefore waits for the 
+	descriptor with poll() or epoll(), then removes until QueueRemove() 
+	returns NULL or QueueRemoveBatch() returns fewer than it asked for.
+	Producers only make a system call for the first add after that, 
+	however many they add before the consumer comes back.
+
+	Notes: Only a remove which finds the QUEUE empty, or QueueDrain(), makes 
+	the descriptor unreadable, QueueClear() does not.  Without USING_QUEUE_BLOCKING_METHODS 
+	or QUEUE_SAFE_MODE, QueueRemove() never checks for an empty QUEUE, so 
+	use QueueRemoveBatch() instead.  The descriptor must be closed with 
+	QueueCloseEventFd().  USING_QUEUE_EVENT_FD must be defined as 1 in 
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns an event file descriptor which signals data in a QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return int - The descriptor, or -1 on failure.
+		* @note USING_QUEUE_EVENT_FD must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueCloseEventFd(), QueueRemoveBatch()
+		* @since v1.04
+*/
+#if (USING_QUEUE_EVENT_FD == 1)
+	int QueueOpenEventFd(QUEUE *Queue);
+#endif // end of USING_QUEUE_EVENT_FD
+
+/*
+	Function: BOOL QueueCloseEventFd(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the QUEUE no longer has an event file descriptor, FALSE 
+		if the QUEUE was NULL.
+
+	Description: Closes the event file descriptor of QueueOpenEventFd(), 
+	after which adding to the QUEUE makes no system call again.
+
+	Notes: USING_QUEUE_EVENT_FD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Closes the event file descriptor of a QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_EVENT_FD must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueOpenEventFd()
+		* @since v1.04
+*/
+#if (USING_QUEUE_EVENT_FD == 1)
+	BOOL QueueCloseEventFd(QUEUE *Queue);
+#endif // end of USING_QUEUE_EVENT_FD
+
+/*
+	Function: BOOL QueueGetStats(QUEUE *Queue, QUEUE_STATS *Stats)
+
+	Parameters: 
+		QUEUE *Queue - The address at which the QUEUE resides in memory.
+		QUEUE_STATS *Stats - Where to copy the statistics of the QUEUE.
+
+	Returns:
+		BOOL - TRUE if the statistics were copied, FALSE if either pointer was NULL.
+
+	Description: Copies out a consistent snapshot of the statistics of the
+	QUEUE, how much data went through it, the largest it got, how often
+	adding ran out of memory and how often a remove found it empty.  With
+	USING_QUEUE_WAIT_TIME_STATISTICS, TotalWaitTime / WaitSamples is the 
+	average time data waited in the QUEUE.
+
+	Notes: The counters wrap around once they pass 0xFFFFFFFF, take the
+	difference between two snapshots to get a rate.  USING_QUEUE_STATISTICS
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns a snapshot of the statistics of a QUEUE.
+		* @param *Queue - The address at which the QUEUE resides in memory.
+		* @param *Stats - Where to copy the statistics.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_STATISTICS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueGetSize(), QueueGetTickCount()
+		* @since v1.04
+*/
+#if (USING_QUEUE_STATISTICS == 1)
+	BOOL QueueGetStats(QUEUE *Queue, QUEUE_STATS *Stats);
+#endif // end of USING_QUEUE_STATISTICS
+
+/*
+	Function: BOOL QueueNodePoolGetStats(QUEUE_NODE_POOL_STATS *Stats)
+
+	Parameters:
+		QUEUE_NODE_POOL_STATS *Stats - The address at which the snapshot of
+		the node pool will be stored.
+
+	Returns:
+		BOOL - TRUE if the snapshot was stored, FALSE if Stats was NULL.
+
+	Description: Takes a snapshot of the node pool shared by every QUEUE.
+
+	Notes: USING_QUEUE_NODE_POOL must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Takes a snapshot of the node pool.
+		* @param *Stats - The address at which the snapshot will be stored.
+		* @return BOOL - TRUE if successful, FALSE if Stats was NULL.
+		* @note USING_QUEUE_NODE_POOL must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueNodePoolShrink()
+		* @since v1.04
+*/
+#if (USING_QUEUE_NODE_POOL == 1)
+	BOOL QueueNodePoolGetStats(QUEUE_NODE_POOL_STATS *Stats);
+#endif // end of USING_QUEUE_NODE_POOL
+
+/*
+	Function: UINT32 QueueNodePoolShrink(UINT32 MaxFreeNodes)
+
+	Parameters:
+		UINT32 MaxFreeNodes - The number of idle QUEUE_NODE's the pool may
+		keep once this method returns.  Pass 0 to release every idle slab.
+
+	Returns:
+		UINT32 - The number of slabs that were handed back with QueueMemDealloc().
+
+	Description: Releases slabs whose QUEUE_NODE's are all idle until the
+	pool holds no more than MaxFreeNodes idle nodes, or until no idle slab
+	is left.
+
+	Notes: A slab is only released when none of its QUEUE_NODE's are in a
+	QUEUE.  USING_QUEUE_NODE_POOL must be defined as 1 in QueueConfig.h to 
+	use method.
+*/
+/**
+		* @brief Hands idle slabs of the node pool back to QueueMemDealloc().
+		* @param MaxFreeNodes - The number of idle QUEUE_NODE's the pool may keep.
+		* @return UINT32 - The number of slabs released.
+		* @note Only slabs with no QUEUE_NODE in use are released.
+		USING_QUEUE_NODE_POOL must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueNodePoolGetStats(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_NODE_POOL == 1)
+	UINT32 QueueNodePoolShrink(UINT32 MaxFreeNodes);
+#endif // end of USING_QUEUE_NODE_POOL
+
+/*
+	Function: BOOL QueueNodeCacheRelease(void)
+
+	Parameters:
+		None
+
+	Returns:
+		BOOL - TRUE if the calling thread had a node cache, FALSE otherwise.
+
+	Description: Gives up the node cache of the calling thread.  The 
+	QUEUE_NODE's it freed for other threads are sent back to them, and its
+	idle QUEUE_NODE's go back to the node pool.  The cache itself is kept
+	for the next thread that needs one, while QUEUE_NODE's other threads
+	free for it from now on go straight to the node pool.
+
+	Notes: Call this before a thread that added to or removed from a QUEUE
+	exits, or its idle nodes stay out of reach of every other thread until
+	a new thread adopts its cache.  The thread gets a new cache if it uses
+	a QUEUE again.  USING_QUEUE_NODE_CACHE must be defined as 1 in 
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Hands the calling thread's node cache back for another thread.
+		* @return BOOL - TRUE if the thread had a node cache, FALSE otherwise.
+		* @note USING_QUEUE_NODE_CACHE must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueNodePoolShrink(), QueueNodePoolGetStats()
+		* @since v1.04
+*/
+#if (USING_QUEUE_NODE_CACHE == 1)
+	BOOL QueueNodeCacheRelease(void);
+#endif // end of USING_QUEUE_NODE_CACHE
+
+/*
+	Function: BOOL QueueGetAllocationStats(QUEUE_ALLOCATION_STATS *Stats)
+
+	Parameters: 
+		QUEUE_ALLOCATION_STATS *Stats - Where to copy the allocation counters.
+
+	Returns:
+		BOOL - TRUE if the counters were copied, FALSE if Stats was NULL.
+
+	Description: Copies out how many times the Queue library called 
+	QueueMemAlloc() and QueueMemDealloc() since the program started or
+	QueueResetAllocationStats() was last called.  Dividing the difference
+	across a run by the number of operations gives the allocations per
+	operation of the configuration in QueueConfig.h.
+
+	Notes: Every QUEUE type is counted, including node pool slabs and the
+	arrays returned by QueueDrain().  USING_QUEUE_ALLOCATION_COUNTERS must
+	be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns how many allocations the Queue library made.
+		* @param *Stats - Where to copy the counters.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_ALLOCATION_COUNTERS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueResetAllocationStats(), QueueMemAlloc(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_ALLOCATION_COUNTERS == 1)
+	BOOL QueueGetAllocationStats(QUEUE_ALLOCATION_STATS *Stats);
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
+
+/*
+	Function: void QueueResetAllocationStats(void)
+
+	Parameters: 
+		None
+
+	Returns:
+		None
+
+	Description: Sets every allocation counter back to 0, typically right
+	before the part of a run being measured.
+
+	Notes: USING_QUEUE_ALLOCATION_COUNTERS must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Sets the allocation counters back to 0.
+		* @note USING_QUEUE_ALLOCATION_COUNTERS must be defined as 1 in QueueConfig.h to use method.
+		* @sa QueueGetAllocationStats()
+		* @since v1.04
+*/
+#if (USING_QUEUE_ALLOCATION_COUNTERS == 1)
+	void QueueResetAllocationStats(void);
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
+
+/*
+	Function: SPSC_QUEUE *CreateSpscQueue(SPSC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE will be inititalized.
+		If NULL is passed in then this method will create an SPSC_QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Capacity - The most pieces of data the SPSC_QUEUE can hold.  This
+		is rounded up to the next power of two.
+
+	Returns:
+		SPSC_QUEUE* - The address at which the newly initialized SPSC_QUEUE resides
+		in memory.  If it could not be created then (SPSC_QUEUE*)NULL is returned.
+
+	Description: Creates a new single producer, single consumer QUEUE.  
+	SpscQueueAdd() may be called from one thread while SpscQueueRemove() and
+	SpscQueuePeek() are called from another, without any lock.
+
+	Notes: The array must be given back with DestroySpscQueue().  
+	USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes an SPSC_QUEUE, and can create an SPSC_QUEUE.
+		* @param *Queue - A pointer to an already allocated SPSC_QUEUE or NULL.
+		* @param Capacity - The most pieces of data the SPSC_QUEUE can hold, rounded
+		up to a power of two.
+		* @return *SPSC_QUEUE - The address of the SPSC_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+		* @sa DestroySpscQueue(), QueueMemAlloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	SPSC_QUEUE *CreateSpscQueue(SPSC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: BOOL DestroySpscQueue(SPSC_QUEUE *Queue)
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if successful, FALSE if the SPSC_QUEUE was NULL.
+
+	Description: Hands every piece of data still in the SPSC_QUEUE to its free
+	method and frees its array.  The SPSC_QUEUE itself is not freed.
+
+	Notes: Neither the producer nor the consumer may be using the SPSC_QUEUE.
+	USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Clears an SPSC_QUEUE and frees its array.
+		* @param *Queue - The address at which the SPSC_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateSpscQueue(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	BOOL DestroySpscQueue(SPSC_QUEUE *Queue);
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: BOOL SpscQueueAdd(SPSC_QUEUE *Queue, const void *Data)
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE resides in memory.
+		const void *Data - The data to store at the end of the SPSC_QUEUE.
+
+	Returns:
+		BOOL - TRUE if the data was stored, FALSE if the SPSC_QUEUE was full.
+
+	Description: Pushes one item onto the SPSC_QUEUE.  Only the producer
+	thread may call this method.
+
+	Notes: USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data at the end of an SPSC_QUEUE without taking a lock.
+		* @param *Queue - The address at which the SPSC_QUEUE resides in memory.
+		* @param *Data - The data to store.
+		* @return BOOL - TRUE if successful, FALSE if the SPSC_QUEUE was full.
+		* @note Producer thread only.  USING_QUEUE_SPSC must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa SpscQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	BOOL SpscQueueAdd(SPSC_QUEUE *Queue, const void *Data);
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: void *SpscQueueRemove(SPSC_QUEUE *Queue)
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE resides in memory.
+
+	Returns:
+		void* - The data of the next item that was removed from the SPSC_QUEUE.  
+		If no items are available then this method returns (void*)NULL.
+
+	Description: Removes one item from the beginning of the SPSC_QUEUE.  Only
+	the consumer thread may call this method.
+
+	Notes: USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes and returns the next data of an SPSC_QUEUE without taking a lock.
+		* @param *Queue - The address at which the SPSC_QUEUE resides in memory.
+		* @return void* - The data removed, or (void*)NULL if the SPSC_QUEUE was empty.
+		* @note Consumer thread only.  USING_QUEUE_SPSC must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa SpscQueueAdd()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	void *SpscQueueRemove(SPSC_QUEUE *Queue);
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: void *SpscQueuePeek(SPSC_QUEUE *Queue)
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE resides in memory.
+
+	Returns:
+		void* - The data of the next item to be removed from the SPSC_QUEUE, or
+		(void*)NULL if no items are available.
+
+	Description: Returns but does not remove the next piece of data in the
+	SPSC_QUEUE.  Only the consumer thread may call this method.
+
+	Notes: USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the next data of an SPSC_QUEUE.
+		* @param *Queue - The address at which the SPSC_QUEUE resides in memory.
+		* @return void* - The next data, or (void*)NULL if the SPSC_QUEUE was empty.
+		* @note Consumer thread only.  USING_QUEUE_SPSC must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa SpscQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	void *SpscQueuePeek(SPSC_QUEUE *Queue);
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: UINT32 SpscQueueGetSize(SPSC_QUEUE *Queue)
+
+	Parameters: 
+		SPSC_QUEUE *Queue - The address at which the SPSC_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of elements in the SPSC_QUEUE at the time of the call.
+
+	Description: Returns the size of the SPSC_QUEUE.  While the producer and 
+	consumer are running the value may already be stale when it is returned.
+
+	Notes: USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of elements in an SPSC_QUEUE.
+		* @param *Queue - The address at which the SPSC_QUEUE resides in memory.
+		* @return UINT32 - The number of elements, or 0 if the SPSC_QUEUE was NULL.
+		* @note USING_QUEUE_SPSC must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_SPSC == 1)
+	UINT32 SpscQueueGetSize(SPSC_QUEUE *Queue);
+#endif // end of USING_QUEUE_SPSC
+
+/*
+	Function: RECORD_QUEUE *CreateRecordQueue(RECORD_QUEUE *Queue, UINT32 Size)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE will be inititalized.
+		If NULL is passed in then this method will create a RECORD_QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Size - The bytes of the buffer the records are kept in.  This 
+		is rounded up to a power of two, of at least 64.
+
+	Returns:
+		RECORD_QUEUE* - The address at which the newly initialized RECORD_QUEUE resides
+		in memory.  If it could not be created then (RECORD_QUEUE*)NULL is returned.
+
+	Description: Creates a RECORD_QUEUE with one buffer of Size bytes.  Each
+	record takes its length rounded up to QUEUE_RECORD_ALIGNMENT plus a 
+	QUEUE_RECORD_HEADER_SIZE byte header, and a record holds at most half 
+	the buffer less the header.  The producer thread may call 
+	RecordQueueReserve() and RecordQueueCommit() while the consumer thread 
+	calls RecordQueuePeek() and RecordQueueRelease(), without any lock.
+
+	Notes: The buffer must be given back with DestroyRecordQueue().  
+	USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a RECORD_QUEUE, and can create a RECORD_QUEUE.
+		* @param *Queue - A pointer to an already allocated RECORD_QUEUE or NULL.
+		* @param Size - The bytes of the buffer, rounded up to a power of two.
+		* @return *RECORD_QUEUE - The address of the RECORD_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+		* @sa DestroyRecordQueue(), QueueMemAlloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	RECORD_QUEUE *CreateRecordQueue(RECORD_QUEUE *Queue, UINT32 Size);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: BOOL DestroyRecordQueue(RECORD_QUEUE *Queue)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if successful, FALSE if the RECORD_QUEUE was NULL.
+
+	Description: Frees the buffer of the RECORD_QUEUE along with any records
+	still in it.  The RECORD_QUEUE itself is not freed.
+
+	Notes: Neither the producer nor the consumer may be using the RECORD_QUEUE.
+	USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees the buffer of a RECORD_QUEUE.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateRecordQueue(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	BOOL DestroyRecordQueue(RECORD_QUEUE *Queue);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: void *RecordQueueReserve(RECORD_QUEUE *Queue, UINT32 Length)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+		UINT32 Length - The most bytes the next record will hold.
+
+	Returns:
+		void* - Where in the buffer the bytes of the record are written, 
+		QUEUE_RECORD_ALIGNMENT aligned.  (void*)NULL if the RECORD_QUEUE was 
+		full or Length was too long.
+
+	Description: Reserves room for the next record at the end of the 
+	RECORD_QUEUE.  The record is written in place and only seen by the 
+	consumer once RecordQueueCommit() is called.  A record never wraps 
+	around the end of the buffer, if it doesn't fit there the rest of the 
+	buffer is skipped.  Calling it again before committing reserves again
+	in place of the first reservation.  Only the producer thread may call
+	this method.
+
+	Notes: USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Reserves room for a record in a RECORD_QUEUE without taking a lock.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @param Length - The most bytes the record will hold.
+		* @return void* - Where to write the record, or (void*)NULL if there was no room.
+		* @note Producer thread only.  USING_QUEUE_RECORD must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa RecordQueueCommit()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	void *RecordQueueReserve(RECORD_QUEUE *Queue, UINT32 Length);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: BOOL RecordQueueCommit(RECORD_QUEUE *Queue, UINT32 Length)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+		UINT32 Length - The bytes the record ended up holding, at most the
+		Length that was reserved.
+
+	Returns:
+		BOOL - TRUE if the record was committed, FALSE if nothing was reserved
+		or Length was longer than the reservation.
+
+	Description: Hands the record written after RecordQueueReserve() to the
+	consumer.  Reserving the longest a record can be and committing what 
+	was actually written suits serializers that don't know the length up
+	front.  Only the producer thread may call this method.
+
+	Notes: USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Commits the reserved record of a RECORD_QUEUE.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @param Length - The bytes the record holds.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note Producer thread only.  USING_QUEUE_RECORD must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa RecordQueueReserve(), RecordQueuePeek()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	BOOL RecordQueueCommit(RECORD_QUEUE *Queue, UINT32 Length);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: void *RecordQueuePeek(RECORD_QUEUE *Queue, UINT32 *Length)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+		UINT32 *Length - Receives the bytes the record holds, may be NULL.
+
+	Returns:
+		void* - Where in the buffer the bytes of the first record are, or 
+		(void*)NULL if the RECORD_QUEUE was empty.
+
+	Description: Returns the first record of the RECORD_QUEUE in place.  The
+	bytes stay valid until RecordQueueRelease() is called.  Only the 
+	consumer thread may call this method.
+
+	Notes: USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the first record of a RECORD_QUEUE without taking a lock.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @param *Length - Receives the bytes of the record.
+		* @return void* - The record, or (void*)NULL if the RECORD_QUEUE was empty.
+		* @note Consumer thread only.  USING_QUEUE_RECORD must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa RecordQueueRelease()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	void *RecordQueuePeek(RECORD_QUEUE *Queue, UINT32 *Length);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: BOOL RecordQueueRelease(RECORD_QUEUE *Queue)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if a record was released, FALSE if the RECORD_QUEUE was empty.
+
+	Description: Removes the first record of the RECORD_QUEUE and hands its
+	bytes back to the producer.  Only the consumer thread may call this 
+	method.
+
+	Notes: USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the first record of a RECORD_QUEUE.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE if the RECORD_QUEUE was empty.
+		* @note Consumer thread only.  USING_QUEUE_RECORD must be defined as 1 in 
+		QueueConfig.h to use method.
+		* @sa RecordQueuePeek()
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	BOOL RecordQueueRelease(RECORD_QUEUE *Queue);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: UINT32 RecordQueueGetSize(RECORD_QUEUE *Queue)
+
+	Parameters: 
+		RECORD_QUEUE *Queue - The address at which the RECORD_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of records in the RECORD_QUEUE at the time of the call.
+
+	Description: Returns the number of committed records that were not yet
+	released.  While the producer and consumer are running the value may 
+	already be stale when it is returned.
+
+	Notes: USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of records in a RECORD_QUEUE.
+		* @param *Queue - The address at which the RECORD_QUEUE resides in memory.
+		* @return UINT32 - The number of records, or 0 if the RECORD_QUEUE was NULL.
+		* @note USING_QUEUE_RECORD must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_RECORD == 1)
+	UINT32 RecordQueueGetSize(RECORD_QUEUE *Queue);
+#endif // end of USING_QUEUE_RECORD
+
+/*
+	Function: MPMC_QUEUE *CreateMpmcQueue(MPMC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		MPMC_QUEUE *Queue - The address at which the MPMC_QUEUE will be inititalized.
+		If NULL is passed in then this method will create an MPMC_QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Capacity - The most pieces of data the MPMC_QUEUE can hold.  This
+		is rounded up to the next power of two, and is at least 2.
+
+	Returns:
+		MPMC_QUEUE* - The address at which the newly initialized MPMC_QUEUE resides
+		in memory.  If it could not be created then (MPMC_QUEUE*)NULL is returned.
+
+	Description: Creates a new multi producer, multi consumer QUEUE.  Any
+	number of threads may call MpmcQueueAdd() and MpmcQueueRemove() at the
+	same time without any lock.
+
+	Notes: The slots must be given back with DestroyMpmcQueue().  
+	USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes an MPMC_QUEUE, and can create an MPMC_QUEUE.
+		* @param *Queue - A pointer to an already allocated MPMC_QUEUE or NULL.
+		* @param Capacity - The most pieces of data the MPMC_QUEUE can hold, rounded
+		up to a power of two.
+		* @return *MPMC_QUEUE - The address of the MPMC_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+		* @sa DestroyMpmcQueue(), QueueMemAlloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MPMC == 1)
+	MPMC_QUEUE *CreateMpmcQueue(MPMC_QUEUE *Queue, UINT32 Capacity, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_MPMC
+
+/*
+	Function: BOOL DestroyMpmcQueue(MPMC_QUEUE *Queue)
+
+	Parameters: 
+		MPMC_QUEUE *Queue - The address at which the MPMC_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if successful, FALSE if the MPMC_QUEUE was NULL.
+
+	Description: Hands every piece of data still in the MPMC_QUEUE to its free
+	method and frees its slots.  The MPMC_QUEUE itself is not freed.
+
+	Notes: No other thread may be using the MPMC_QUEUE.
+	USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Clears an MPMC_QUEUE and frees its slots.
+		* @param *Queue - The address at which the MPMC_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateMpmcQueue(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MPMC == 1)
+	BOOL DestroyMpmcQueue(MPMC_QUEUE *Queue);
+#endif // end of USING_QUEUE_MPMC
+
+/*
+	Function: BOOL MpmcQueueAdd(MPMC_QUEUE *Queue, const void *Data)
+
+	Parameters: 
+		MPMC_QUEUE *Queue - The address at which the MPMC_QUEUE resides in memory.
+		const void *Data - The data to store at the end of the MPMC_QUEUE.
+
+	Returns:
+		BOOL - TRUE if the data was stored, FALSE if the MPMC_QUEUE was full.
+
+	Description: Pushes one item onto the MPMC_QUEUE.  Any thread may call
+	this method.
+
+	Notes: USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data at the end of an MPMC_QUEUE without taking a lock.
+		* @param *Queue - The address at which the MPMC_QUEUE resides in memory.
+		* @param *Data - The data to store.
+		* @return BOOL - TRUE if successful, FALSE if the MPMC_QUEUE was full.
+		* @note USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+		* @sa MpmcQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MPMC == 1)
+	BOOL MpmcQueueAdd(MPMC_QUEUE *Queue, const void *Data);
+#endif // end of USING_QUEUE_MPMC
+
+/*
+	Function: void *MpmcQueueRemove(MPMC_QUEUE *Queue)
+
+	Parameters: 
+		MPMC_QUEUE *Queue - The address at which the MPMC_QUEUE resides in memory.
+
+	Returns:
+		void* - The data of the next item that was removed from the MPMC_QUEUE.  
+		If no items are available then this method returns (void*)NULL.
+
+	Description: Removes one item from the beginning of the MPMC_QUEUE.  Any
+	thread may call this method.
+
+	Notes: USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes and returns the next data of an MPMC_QUEUE without taking a lock.
+		* @param *Queue - The address at which the MPMC_QUEUE resides in memory.
+		* @return void* - The data removed, or (void*)NULL if the MPMC_QUEUE was empty.
+		* @note USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+		* @sa MpmcQueueAdd()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MPMC == 1)
+	void *MpmcQueueRemove(MPMC_QUEUE *Queue);
+#endif // end of USING_QUEUE_MPMC
+
+/*
+	Function: UINT32 MpmcQueueGetSize(MPMC_QUEUE *Queue)
+
+	Parameters: 
+		MPMC_QUEUE *Queue - The address at which the MPMC_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of elements in the MPMC_QUEUE at the time of the call.
+
+	Description: Returns the size of the MPMC_QUEUE.  While other threads are
+	using the MPMC_QUEUE the value is only an estimate.
+
+	Notes: USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of elements in an MPMC_QUEUE.
+		* @param *Queue - The address at which the MPMC_QUEUE resides in memory.
+		* @return UINT32 - The number of elements, or 0 if the MPMC_QUEUE was NULL.
+		* @note USING_QUEUE_MPMC must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_MPMC == 1)
+	UINT32 MpmcQueueGetSize(MPMC_QUEUE *Queue);
+#endif // end of USING_QUEUE_MPMC
+
+/*
+	Function: WS_DEQUE *CreateWsDeque(WS_DEQUE *Deque, UINT32 Capacity, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE will be inititalized.
+		If NULL is passed in then this method will create a WS_DEQUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Capacity - The number of pieces of data the WS_DEQUE starts with
+		room for, rounded up to a power of two.  It doubles whenever it runs out.
+
+	Returns:
+		WS_DEQUE* - The address at which the newly initialized WS_DEQUE resides
+		in memory.  If it could not be created then (WS_DEQUE*)NULL is returned.
+
+	Description: Creates a new work stealing deque for one worker of a thread
+	pool.  The worker pushes and pops its own tasks at the bottom, newest first,
+	while idle workers steal the oldest tasks from the top.
+
+	Notes: Arrays outgrown by the WS_DEQUE are kept until DestroyWsDeque(), since
+	a thief may still be reading one.  USING_QUEUE_WORK_STEALING must be defined
+	as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a WS_DEQUE, and can create a WS_DEQUE.
+		* @param *Deque - A pointer to an already allocated WS_DEQUE or NULL.
+		* @param Capacity - The initial room of the WS_DEQUE.
+		* @return *WS_DEQUE - The address of the WS_DEQUE in memory, or NULL.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa WsDequePush(), WsDequePop(), WsDequeSteal(), DestroyWsDeque()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	WS_DEQUE *CreateWsDeque(WS_DEQUE *Deque, UINT32 Capacity, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: BOOL DestroyWsDeque(WS_DEQUE *Deque)
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the WS_DEQUE was torn down, FALSE if it was NULL.
+
+	Description: Hands every piece of data still in the WS_DEQUE to the free
+	method and frees every array it used.  The WS_DEQUE itself is not freed.
+
+	Notes: No other thread may be using the WS_DEQUE.  USING_QUEUE_WORK_STEALING
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees the arrays of a WS_DEQUE.
+		* @param *Deque - The address at which the WS_DEQUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateWsDeque()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	BOOL DestroyWsDeque(WS_DEQUE *Deque);
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: BOOL WsDequePush(WS_DEQUE *Deque, const void *Data)
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE resides in memory.
+		const void *Data - The data to store at the bottom of the WS_DEQUE.
+
+	Returns:
+		BOOL - TRUE if the data was stored, FALSE if the WS_DEQUE was NULL or 
+		could not grow.
+
+	Description: Pushes one item onto the bottom of the WS_DEQUE without a lock.
+
+	Notes: Only the owner of the WS_DEQUE may call this method.  
+	USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Puts data at the bottom of a WS_DEQUE, owner only.
+		* @param *Deque - The address at which the WS_DEQUE resides in memory.
+		* @param *Data - The data to store.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa WsDequePop(), WsDequeSteal()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	BOOL WsDequePush(WS_DEQUE *Deque, const void *Data);
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: void *WsDequePop(WS_DEQUE *Deque)
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE resides in memory.
+
+	Returns:
+		void* - The newest data in the WS_DEQUE, or (void*)NULL if it was empty
+		or a thief took the last piece of data first.
+
+	Description: Removes one item from the bottom of the WS_DEQUE.  Only the
+	removal of the last item can race a thief, everything else is lock free
+	and free of compare and exchange.
+
+	Notes: Only the owner of the WS_DEQUE may call this method.  
+	USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the newest data of a WS_DEQUE, owner only.
+		* @param *Deque - The address at which the WS_DEQUE resides in memory.
+		* @return void* - The data removed, or (void*)NULL.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa WsDequePush(), WsDequeSteal()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	void *WsDequePop(WS_DEQUE *Deque);
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: void *WsDequeSteal(WS_DEQUE *Deque)
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE resides in memory.
+
+	Returns:
+		void* - The oldest data in the WS_DEQUE, or (void*)NULL if it was empty 
+		or another thread took that data first.
+
+	Description: Removes one item from the top of the WS_DEQUE with a single
+	compare and exchange.  Any thread may call this method.
+
+	Notes: A (void*)NULL return after losing a race does not mean the WS_DEQUE
+	is empty, a thief would usually move on to another victim.
+	USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Steals the oldest data of a WS_DEQUE, any thread.
+		* @param *Deque - The address at which the WS_DEQUE resides in memory.
+		* @return void* - The data stolen, or (void*)NULL.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa WsDequePush(), WsDequePop()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	void *WsDequeSteal(WS_DEQUE *Deque);
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: UINT32 WsDequeGetSize(WS_DEQUE *Deque)
+
+	Parameters: 
+		WS_DEQUE *Deque - The address at which the WS_DEQUE resides in memory.
+
+	Returns:
+		UINT32 - The number of elements in the WS_DEQUE at the time of the call.
+
+	Description: Returns the size of the WS_DEQUE.  While other threads are
+	using the WS_DEQUE the value is only an estimate.
+
+	Notes: USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of elements in a WS_DEQUE.
+		* @param *Deque - The address at which the WS_DEQUE resides in memory.
+		* @return UINT32 - The number of elements, or 0 if Deque is NULL.
+		* @note USING_QUEUE_WORK_STEALING must be defined as 1 in QueueConfig.h to use method.
+		* @sa WsDequePush(), WsDequeSteal()
+		* @since v1.04
+*/
+#if (USING_QUEUE_WORK_STEALING == 1)
+	UINT32 WsDequeGetSize(WS_DEQUE *Deque);
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/*
+	Function: PERSISTENT_QUEUE *CreatePersistentQueue(PERSISTENT_QUEUE *Queue, const char *Path, UINT32 SyncRecords, UINT32 SyncInterval)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE will
+		be inititalized.  If NULL is passed in then this method will create a 
+		PERSISTENT_QUEUE out of the heap with a call to QueueMemAlloc().
+		const char *Path - The directory which holds the segment files, it must
+		already exist.
+		UINT32 SyncRecords - Write everything out after this many adds and
+		removes, 1 for every record or 0 to not sync by count.
+		UINT32 SyncInterval - Write everything out once this many milliseconds
+		passed since the last time, or 0 to not sync by time.
+
+	Returns:
+		PERSISTENT_QUEUE* - The address at which the PERSISTENT_QUEUE resides in
+		memory.  If it could not be opened then (PERSISTENT_QUEUE*)NULL is returned.
+
+	Description: Opens the PERSISTENT_QUEUE kept in Path, or starts a new one if
+	there is no checkpoint there.  Every whole record added after the last 
+	checkpoint is picked up again, a record torn by a crash and everything
+	after it is dropped.
+
+	Notes: Records removed after the last checkpoint come back, so a consumer
+	must handle seeing a record twice.  The interval is only checked by the
+	add and remove methods.  USING_QUEUE_PERSISTENT must be defined as 1 in 
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Opens or creates a PERSISTENT_QUEUE in a directory.
+		* @param *Queue - A pointer to an already allocated PERSISTENT_QUEUE or NULL.
+		* @param *Path - The directory holding the segment files.
+		* @param SyncRecords - The number of adds and removes between syncs, or 0.
+		* @param SyncInterval - The milliseconds between syncs, or 0.
+		* @return *PERSISTENT_QUEUE - The address of the PERSISTENT_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa PersistentQueueAdd(), PersistentQueuePeek(), PersistentQueueRemove(), DestroyPersistentQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	PERSISTENT_QUEUE *CreatePersistentQueue(PERSISTENT_QUEUE *Queue, const char *Path, UINT32 SyncRecords, UINT32 SyncInterval);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: BOOL DestroyPersistentQueue(PERSISTENT_QUEUE *Queue)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if everything was written out and the PERSISTENT_QUEUE was
+		closed, FALSE if it was NULL or the last sync failed.
+
+	Description: Syncs the PERSISTENT_QUEUE and closes it.  The files stay in
+	the directory for the next CreatePersistentQueue().  The PERSISTENT_QUEUE
+	itself is not freed.
+
+	Notes: USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Syncs and closes a PERSISTENT_QUEUE.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreatePersistentQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	BOOL DestroyPersistentQueue(PERSISTENT_QUEUE *Queue);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: BOOL PersistentQueueAdd(PERSISTENT_QUEUE *Queue, const void *Data, UINT32 Length)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		const void *Data - The record to copy into the PERSISTENT_QUEUE.
+		UINT32 Length - The size of the record in bytes.
+
+	Returns:
+		BOOL - TRUE if the record was appended, FALSE if it could not be, in
+		which case it is not in the PERSISTENT_QUEUE.
+
+	Description: Appends one record to the tail segment, starting a new segment
+	when it doesn't fit, and syncs when the sync settings say it is due.
+
+	Notes: A record holds at most QUEUE_PERSISTENT_SEGMENT_SIZE less 16 bytes.
+	TRUE does not mean the record is on disk, a sync that fails here is tried
+	again by the next one, and PersistentQueueSync() reports whether it worked.
+	USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Appends a record to a PERSISTENT_QUEUE.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @param *Data - The record.
+		* @param Length - The size of the record in bytes.
+		* @return BOOL - TRUE if the record was appended, FALSE otherwise.
+		* @note Call PersistentQueueSync() to know the record is on disk.
+		USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa PersistentQueuePeek(), PersistentQueueRemove(), PersistentQueueSync()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	BOOL PersistentQueueAdd(PERSISTENT_QUEUE *Queue, const void *Data, UINT32 Length);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: const void *PersistentQueuePeek(PERSISTENT_QUEUE *Queue, UINT32 *Length)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		UINT32 *Length - Where the size of the record in bytes is stored, or NULL.
+
+	Returns:
+		const void* - The record at the head of the PERSISTENT_QUEUE, or NULL
+		if it is empty or its segment could not be mapped.
+
+	Description: Returns the oldest record in place, straight out of the mapped
+	segment file, without copying it.
+
+	Notes: The record stays valid until it is removed.  Only one thread may
+	consume records.  USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h
+	to use method.
+*/
+/**
+		* @brief Returns the oldest record of a PERSISTENT_QUEUE without copying it.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @param *Length - Set to the size of the record, may be NULL.
+		* @return const void* - The record, or NULL.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa PersistentQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	const void *PersistentQueuePeek(PERSISTENT_QUEUE *Queue, UINT32 *Length);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: BOOL PersistentQueueRemove(PERSISTENT_QUEUE *Queue)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if a record was removed, FALSE if the PERSISTENT_QUEUE was
+		NULL or empty.
+
+	Description: Drops the oldest record, usually once the record returned by
+	PersistentQueuePeek() has been handled.  Segments the head leaves are
+	recycled or deleted.
+
+	Notes: USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the oldest record of a PERSISTENT_QUEUE.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @return BOOL - TRUE if a record was removed, FALSE otherwise.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa PersistentQueuePeek()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	BOOL PersistentQueueRemove(PERSISTENT_QUEUE *Queue);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: BOOL PersistentQueueSync(PERSISTENT_QUEUE *Queue)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if everything was written out, FALSE otherwise.
+
+	Description: Writes every record added so far to disk and then a new
+	checkpoint, whatever the sync settings say.  Segments the head left
+	while a sync failed are recycled or deleted once one works.
+
+	Notes: The only way to learn that a sync due in PersistentQueueAdd() or
+	PersistentQueueRemove() failed.  USING_QUEUE_PERSISTENT must be defined
+	as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Writes a PERSISTENT_QUEUE and its checkpoint to disk.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreatePersistentQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	BOOL PersistentQueueSync(PERSISTENT_QUEUE *Queue);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: UINT32 PersistentQueueGetSize(PERSISTENT_QUEUE *Queue)
+
+	Parameters: 
+		PERSISTENT_QUEUE *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of records in the PERSISTENT_QUEUE.
+
+	Description: Returns the number of records between the head and the tail.
+
+	Notes: USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of records in a PERSISTENT_QUEUE.
+		* @param *Queue - The address at which the PERSISTENT_QUEUE resides in memory.
+		* @return UINT32 - The number of records, or 0 if the PERSISTENT_QUEUE was NULL.
+		* @note USING_QUEUE_PERSISTENT must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_PERSISTENT == 1)
+	UINT32 PersistentQueueGetSize(PERSISTENT_QUEUE *Queue);
+#endif // end of USING_QUEUE_PERSISTENT
+
+/*
+	Function: SHARED_QUEUE *CreateSharedQueue(SHARED_QUEUE *Queue, const char *Name, UINT32 Capacity, UINT32 SlotSize)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which this process's view of the
+		SHARED_QUEUE will be inititalized.  If NULL is passed in then this method
+		will create it out of the heap with a call to QueueMemAlloc().
+		const char *Name - The name of the POSIX shared memory object, such as
+		"/jobs".
+		UINT32 Capacity - The number of messages the SHARED_QUEUE can hold,
+		rounded up to a power of two.
+		UINT32 SlotSize - The most bytes one message can hold.
+
+	Returns:
+		SHARED_QUEUE* - The address at which the SHARED_QUEUE resides in memory.
+		If it could not be created then (SHARED_QUEUE*)NULL is returned.
+
+	Description: Creates a shared memory object holding a fixed number of
+	fixed size slots, which any number of producer and consumer processes can
+	use at the same time.  Messages are stored in the slots themselves, and 
+	positions in the object are kept as indexes, never as pointers.
+
+	Notes: Fails if the name is already taken, even by a SHARED_QUEUE left
+	behind by a crashed creator.  Call UnlinkSharedQueue() first to replace
+	one known to be stale.  USING_QUEUE_SHARED must be defined as 1 in
+	QueueConfig.h to use method.
+*/
+/**
+		* @brief Creates a SHARED_QUEUE in a new POSIX shared memory object.
+		* @param *Queue - A pointer to an already allocated SHARED_QUEUE or NULL.
+		* @param *Name - The name of the shared memory object.
+		* @param Capacity - The number of messages the SHARED_QUEUE can hold.
+		* @param SlotSize - The most bytes one message can hold.
+		* @return *SHARED_QUEUE - The address of the SHARED_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa OpenSharedQueue(), DestroySharedQueue(), UnlinkSharedQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	SHARED_QUEUE *CreateSharedQueue(SHARED_QUEUE *Queue, const char *Name, UINT32 Capacity, UINT32 SlotSize);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: SHARED_QUEUE *OpenSharedQueue(SHARED_QUEUE *Queue, const char *Name)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which this process's view of the
+		SHARED_QUEUE will be inititalized, or NULL to allocate it with
+		QueueMemAlloc().
+		const char *Name - The name the SHARED_QUEUE was created with.
+
+	Returns:
+		SHARED_QUEUE* - The address at which the SHARED_QUEUE resides in memory.
+		(SHARED_QUEUE*)NULL if there is no such SHARED_QUEUE or its creator
+		has not finished setting it up, in which case the call can be retried.
+
+	Description: Attaches this process to a SHARED_QUEUE made by CreateSharedQueue().
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Attaches to an existing SHARED_QUEUE.
+		* @param *Queue - A pointer to an already allocated SHARED_QUEUE or NULL.
+		* @param *Name - The name of the shared memory object.
+		* @return *SHARED_QUEUE - The address of the SHARED_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateSharedQueue(), DestroySharedQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	SHARED_QUEUE *OpenSharedQueue(SHARED_QUEUE *Queue, const char *Name);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL DestroySharedQueue(SHARED_QUEUE *Queue)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the SHARED_QUEUE was detached, FALSE if it was NULL.
+
+	Description: Detaches this process from the SHARED_QUEUE.  When called by
+	the creator the name is removed as well, and the memory goes once every
+	process has detached.  The SHARED_QUEUE struct itself is not freed.
+
+	Notes: Messages still in the SHARED_QUEUE are not touched, they are only
+	bytes.  USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Detaches from a SHARED_QUEUE.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateSharedQueue(), OpenSharedQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL DestroySharedQueue(SHARED_QUEUE *Queue);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL UnlinkSharedQueue(const char *Name)
+
+	Parameters: 
+		const char *Name - The name the SHARED_QUEUE was created with.
+
+	Returns:
+		BOOL - TRUE if the name was removed, FALSE if there was no such name.
+
+	Description: Removes the name of a SHARED_QUEUE whose creator exited
+	without calling DestroySharedQueue(), so CreateSharedQueue() can use the
+	name again.  Processes still attached keep using the old memory.
+
+	Notes: Only call this for a SHARED_QUEUE known to be stale, a live one
+	loses every process that would have opened it.  USING_QUEUE_SHARED must
+	be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes the name of a stale SHARED_QUEUE.
+		* @param *Name - The name of the shared memory object.
+		* @return BOOL - TRUE if the name was removed, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateSharedQueue(), DestroySharedQueue()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL UnlinkSharedQueue(const char *Name);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: void *SharedQueueReserve(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 Timeout)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		UINT32 *Position - Where the position of the claimed slot is stored.
+		UINT32 Timeout - The most milliseconds to wait, 0 to not wait at all or
+		QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		void* - Where to write the message, SlotSize bytes inside the shared
+		memory, or NULL if the SHARED_QUEUE stayed full.
+
+	Description: Claims the next free slot so the message can be written straight
+	into the shared memory.  The slot is handed to consumers by
+	SharedQueueCommit().  Only waiting makes a system call.
+
+	Notes: Every reserved slot must be committed, consumers behind it wait 
+	until it is.  USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Claims a free slot of a SHARED_QUEUE to write a message into.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param *Position - Set to the position of the slot.
+		* @param Timeout - The most milliseconds to wait.
+		* @return void* - The slot, or NULL.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueCommit(), SharedQueueAdd()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	void *SharedQueueReserve(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 Timeout);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL SharedQueueCommit(SHARED_QUEUE *Queue, UINT32 Position, UINT32 Length)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		UINT32 Position - The position returned by SharedQueueReserve().
+		UINT32 Length - The size in bytes of the message written into the slot.
+
+	Returns:
+		BOOL - TRUE if the message was handed to the consumers, FALSE if the
+		SHARED_QUEUE was NULL or Length is larger than a slot.
+
+	Description: Publishes a reserved slot and wakes a waiting consumer, if any.
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Publishes a slot claimed by SharedQueueReserve().
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param Position - The position of the slot.
+		* @param Length - The size of the message.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueReserve()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL SharedQueueCommit(SHARED_QUEUE *Queue, UINT32 Position, UINT32 Length);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: void *SharedQueueAcquire(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 *Length, UINT32 Timeout)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		UINT32 *Position - Where the position of the claimed slot is stored.
+		UINT32 *Length - Where the size of the message is stored, or NULL.
+		UINT32 Timeout - The most milliseconds to wait, 0 to not wait at all or
+		QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		void* - The oldest message, read in place from the shared memory, or
+		NULL if the SHARED_QUEUE stayed empty.
+
+	Description: Claims the oldest message without copying it.  The slot goes
+	back to the producers with SharedQueueRelease().  Only waiting makes a 
+	system call.
+
+	Notes: Every acquired slot must be released, producers wait for it once
+	they come around to it again.  USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Claims the oldest message of a SHARED_QUEUE in place.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param *Position - Set to the position of the slot.
+		* @param *Length - Set to the size of the message, may be NULL.
+		* @param Timeout - The most milliseconds to wait.
+		* @return void* - The message, or NULL.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueRelease(), SharedQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	void *SharedQueueAcquire(SHARED_QUEUE *Queue, UINT32 *Position, UINT32 *Length, UINT32 Timeout);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL SharedQueueRelease(SHARED_QUEUE *Queue, UINT32 Position)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		UINT32 Position - The position returned by SharedQueueAcquire().
+
+	Returns:
+		BOOL - TRUE if the slot was freed, FALSE if the SHARED_QUEUE was NULL.
+
+	Description: Frees a slot claimed by SharedQueueAcquire() and wakes a waiting
+	producer, if any.
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Frees a slot claimed by SharedQueueAcquire().
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param Position - The position of the slot.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueAcquire()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL SharedQueueRelease(SHARED_QUEUE *Queue, UINT32 Position);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL SharedQueueAdd(SHARED_QUEUE *Queue, const void *Data, UINT32 Length, UINT32 Timeout)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		const void *Data - The message to copy into the SHARED_QUEUE.
+		UINT32 Length - The size of the message in bytes.
+		UINT32 Timeout - The most milliseconds to wait, 0 to not wait at all or
+		QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		BOOL - TRUE if the message was added, FALSE otherwise.
+
+	Description: Copies a message into the next free slot, SharedQueueReserve()
+	and SharedQueueCommit() in one call.
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Copies a message into a SHARED_QUEUE.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param *Data - The message.
+		* @param Length - The size of the message.
+		* @param Timeout - The most milliseconds to wait.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueRemove(), SharedQueueReserve()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL SharedQueueAdd(SHARED_QUEUE *Queue, const void *Data, UINT32 Length, UINT32 Timeout);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: BOOL SharedQueueRemove(SHARED_QUEUE *Queue, void *Data, UINT32 *Length, UINT32 Timeout)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+		void *Data - Where the message is copied to, with room for SlotSize bytes.
+		UINT32 *Length - Where the size of the message is stored, or NULL.
+		UINT32 Timeout - The most milliseconds to wait, 0 to not wait at all or
+		QUEUE_WAIT_FOREVER to wait as long as it takes.
+
+	Returns:
+		BOOL - TRUE if a message was removed, FALSE otherwise.
+
+	Description: Copies the oldest message out and frees its slot, 
+	SharedQueueAcquire() and SharedQueueRelease() in one call.
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Copies the oldest message out of a SHARED_QUEUE.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @param *Data - Where the message is copied to.
+		* @param *Length - Set to the size of the message, may be NULL.
+		* @param Timeout - The most milliseconds to wait.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa SharedQueueAdd(), SharedQueueAcquire()
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	BOOL SharedQueueRemove(SHARED_QUEUE *Queue, void *Data, UINT32 *Length, UINT32 Timeout);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: UINT32 SharedQueueGetSize(SHARED_QUEUE *Queue)
+
+	Parameters: 
+		SHARED_QUEUE *Queue - The address at which the SHARED_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of claimed slots, which may already be outdated.
+
+	Description: Returns roughly how many messages the SHARED_QUEUE holds.
+
+	Notes: USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns the number of messages in a SHARED_QUEUE.
+		* @param *Queue - The address at which the SHARED_QUEUE resides in memory.
+		* @return UINT32 - The number of messages, or 0 if the SHARED_QUEUE was NULL.
+		* @note USING_QUEUE_SHARED must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_SHARED == 1)
+	UINT32 SharedQueueGetSize(SHARED_QUEUE *Queue);
+#endif // end of USING_QUEUE_SHARED
+
+/*
+	Function: MULTI_QUEUE *CreateMultiQueue(MULTI_QUEUE *Queue, UINT32 Shards, void (*CustomFreeMethod)(void *Data))
+
+	Parameters: 
+		MULTI_QUEUE *Queue - The address at which the MULTI_QUEUE will be inititalized.
+		If NULL is passed in then this method will create a MULTI_QUEUE out of
+		the heap with a call to QueueMemAlloc().
+		UINT32 Shards - The number of shards, or 0 for two per online processor.
+
+	Returns:
+		MULTI_QUEUE* - The address at which the newly initialized MULTI_QUEUE resides
+		in memory.  If it could not be created then (MULTI_QUEUE*)NULL is returned.
+
+	Description: Creates a new MULTI_QUEUE, a QUEUE for many threads made of
+	Shards locked rings.  Each thread adds to a shard of its own and only 
+	moves on to another one when that is busy, and removes take the older
+	front of two random shards.  Threads therefore seldom share a lock or a
+	cache line, at the price of a first in, first out order which only holds
+	roughly.
+
+	Notes: The shards must be given back with DestroyMultiQueue().  Each shard
+	starts with QUEUE_MULTI_INITIAL_CAPACITY entries.  USING_QUEUE_MULTI must 
+	be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Initializes a MULTI_QUEUE, and can create a MULTI_QUEUE.
+		* @param *Queue - A pointer to an already allocated MULTI_QUEUE or NULL.
+		* @param Shards - The number of shards, 0 for two per online processor.
+		* @return *MULTI_QUEUE - The address of the MULTI_QUEUE in memory, or NULL.
+		* @note USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+		* @sa DestroyMultiQueue(), QueueMemAlloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MULTI == 1)
+	MULTI_QUEUE *CreateMultiQueue(MULTI_QUEUE *Queue, UINT32 Shards, void (*CustomFreeMethod)(void *Data));
+#endif // end of USING_QUEUE_MULTI
+
+/*
+	Function: BOOL DestroyMultiQueue(MULTI_QUEUE *Queue)
+
+	Parameters: 
+		MULTI_QUEUE *Queue - The address at which the MULTI_QUEUE resides in memory.
+
+	Returns:
+		BOOL - TRUE if the shards were freed, FALSE if the MULTI_QUEUE was NULL.
+
+	Description: Hands every piece of data left in the MULTI_QUEUE to its
+	free method, then frees the shards.  The MULTI_QUEUE itself is not freed.
+
+	Notes: No other thread may be using the MULTI_QUEUE.  USING_QUEUE_MULTI 
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Empties a MULTI_QUEUE and frees its shards.
+		* @param *Queue - The address at which the MULTI_QUEUE resides in memory.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+		* @sa CreateMultiQueue(), QueueMemDealloc()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MULTI == 1)
+	BOOL DestroyMultiQueue(MULTI_QUEUE *Queue);
+#endif // end of USING_QUEUE_MULTI
+
+/*
+	Function: BOOL MultiQueueAdd(MULTI_QUEUE *Queue, const void *Data)
+
+	Parameters: 
+		MULTI_QUEUE *Queue - The address at which the MULTI_QUEUE resides in memory.
+		const void *Data - The data to add.
+
+	Returns:
+		BOOL - TRUE if the data was added, FALSE if a shard had to grow and 
+		could not.
+
+	Description: Adds Data to the calling thread's shard of the MULTI_QUEUE,
+	or to a random other shard if another thread holds that one.
+
+	Notes: USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Adds data to a MULTI_QUEUE.
+		* @param *Queue - The address at which the MULTI_QUEUE resides in memory.
+		* @param *Data - The data to add.
+		* @return BOOL - TRUE if successful, FALSE otherwise.
+		* @note USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+		* @sa MultiQueueRemove()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MULTI == 1)
+	BOOL MultiQueueAdd(MULTI_QUEUE *Queue, const void *Data);
+#endif // end of USING_QUEUE_MULTI
+
+/*
+	Function: void *MultiQueueRemove(MULTI_QUEUE *Queue)
+
+	Parameters: 
+		MULTI_QUEUE *Queue - The address at which the MULTI_QUEUE resides in memory.
+
+	Returns:
+		void* - The data removed, or NULL if the MULTI_QUEUE was empty.
+
+	Description: Looks at the fronts of two random shards and removes the
+	one added first.  When that keeps finding empty or busy shards it goes
+	through every shard in turn, so data is never left behind.
+
+	Notes: Data added by different threads may come out in a slightly 
+	different order than it went in.  Data added by one thread comes out in
+	order as long as that thread always got its own shard.  USING_QUEUE_MULTI
+	must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Removes roughly the oldest data from a MULTI_QUEUE.
+		* @param *Queue - The address at which the MULTI_QUEUE resides in memory.
+		* @return void* - The data, or NULL if the MULTI_QUEUE was empty.
+		* @note USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+		* @sa MultiQueueAdd()
+		* @since v1.04
+*/
+#if (USING_QUEUE_MULTI == 1)
+	void *MultiQueueRemove(MULTI_QUEUE *Queue);
+#endif // end of USING_QUEUE_MULTI
+
+/*
+	Function: UINT32 MultiQueueGetSize(MULTI_QUEUE *Queue)
+
+	Parameters: 
+		MULTI_QUEUE *Queue - The address at which the MULTI_QUEUE resides in memory.
+
+	Returns:
+		UINT32 - The number of pieces of data in the MULTI_QUEUE, which may 
+		already be outdated.
+
+	Description: Adds up the sizes of the shards without taking their locks.
+
+	Notes: USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+*/
+/**
+		* @brief Returns roughly the number of pieces of data in a MULTI_QUEUE.
+		* @param *Queue - The address at which the MULTI_QUEUE resides in memory.
+		* @return UINT32 - The size, or 0 if the MULTI_QUEUE was NULL.
+		* @note USING_QUEUE_MULTI must be defined as 1 in QueueConfig.h to use method.
+		* @sa None
+		* @since v1.04
+*/
+#if (USING_QUEUE_MULTI == 1)
+	UINT32 MultiQueueGetSize(MULTI_QUEUE *Queue);
+#endif // end of USING_QUEUE_MULTI
+
+/*
+	Macro: UINT32 QueueGetSizeOfNodeInBytes(UINT32 DataSizeInBytes)
+
+	Parameters: 
+		UINT32 DataSizeInBytes - The size in bytes of the data being stored in a QUEUE.
+
+	Returns:
+		UINT32 - The size in bytes that the QUEUE_NODE takes up with it's accompaning
+		data.
+
+	Description: Returns the size of a QUEUE_NODE and it's data in bytes.
+
+	Notes: This method does not take into account how much memory is used to allocate 
+	memory through QueueMemAlloc().
+*/
+#define QueueGetSizeOfNodeInBytes(Size)			(UINT32)(Size + sizeof(QUEUE_NODE))
+
+/*
+	Macro: UINT32 QueueGetNodeOffset(Type, Member)
+
+	Parameters: 
+		Type - The struct type of the data added to an intrusive QUEUE.
+		Member - The name of the QUEUE_NODE member embedded in Type.
+
+	Returns:
+		UINT32 - The offset in bytes of Member within Type.
+
+	Description: Returns the offset to pass to CreateIntrusiveQueue().
+
+	Notes: USING_QUEUE_INTRUSIVE must be defined as 1 in QueueConfig.h to use macro.
+*/
+#if (USING_QUEUE_INTRUSIVE == 1)
+	#define QueueGetNodeOffset(Type, Member)		(UINT32)((BYTE*)&(((Type*)0)->Member) - (BYTE*)0)
+#endif // end of USING_QUEUE_INTRUSIVE
+
+/*
+	Macro: BOOL QueueIsNull(QUEUE *Queue)
 
 	Parameters: 
 		QUEUE *Queue - The QUEUE to check if it's NULL or not.
@@ -331,4 +2916,38 @@ void *QueueRemove(QUEUE *Queue);
 */
 #define QueueIsEmpty(Queue)						(Queue->Size == (unsigned int)0)
 
+/*
+	Macro: BOOL QueueIsFull(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The QUEUE to check if it's full or not.
+
+	Returns:
+		BOOL - TRUE if the QUEUE is a ring QUEUE with no room left, FALSE otherwise.
+
+	Description: Checks to see if QueueAdd() would fail because the QUEUE is full.
+
+	Notes: USING_QUEUE_RING_BUFFER must be defined as 1 in QueueConfig.h to use macro.
+*/
+#if (USING_QUEUE_RING_BUFFER == 1)
+	#define QueueIsFull(Queue)						(Queue->Type == QUEUE_TYPE_RING && Queue->Size > Queue->Mask)
+#endif // end of USING_QUEUE_RING_BUFFER
+
+/*
+	Macro: BOOL QueueIsClosed(QUEUE *Queue)
+
+	Parameters: 
+		QUEUE *Queue - The QUEUE to check if it's closed or not.
+
+	Returns:
+		BOOL - TRUE if QueueClose() was called on the QUEUE, FALSE otherwise.
+
+	Description: Checks to see if the QUEUE was closed.
+
+	Notes: USING_QUEUE_BLOCKING_METHODS must be defined as 1 in QueueConfig.h to use macro.
+*/
+#if (USING_QUEUE_BLOCKING_METHODS == 1)
+	#define QueueIsClosed(Queue)					(Queue->Closed)
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
 #endif // end of QUEUE_H
@@ -0,0 +1,863 @@
+/*
+	Date: October 17, 2026
+	File Name: Queue.hpp
+	Version: 1.04
+	IDE: None
+	Compiler: C++11
+
+	Description:
+	This file contains a header only, typed C++ version of
+	the Queue library.  Queue<T, Policy> follows the same
+	design as QUEUE in Queue.c, a singly linked list of
+	QUEUE_NODE's or, with a fixed capacity, a power of two
+	ring, but each T is stored inline in its node or slot
+	instead of behind a void pointer.
+
+	The allocator, the capacity and the locking are picked at
+	compile time through the Policy, so nothing that isn't used
+	is compiled in.  There is no QUEUE_SAFE_MODE here, a Queue
+	can never be NULL and every method reports failure through
+	its return value instead.
+
+	With USING_QUEUE_COROUTINES, AsyncQueue<T, Policy, Resumer>
+	wraps the same storage for C++20 coroutines, consumers
+	co_await pop() rather than polling try_pop().
+*/
+
+#ifndef QUEUE_HPP
+	#define QUEUE_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <mutex>
+
+#include "GenericTypes.h"
+#include "QueueConfig.h"
+
+#if (USE_MALLOC == 1)
+	#include <cstdlib>
+#endif // end of USE_MALLOC
+
+#if (USING_QUEUE_COROUTINES == 1)
+	#include <chrono>
+	#include <coroutine>
+	#include <iterator>
+	#include <optional>
+	#include <stop_token>
+	#include <vector>
+#endif // end of USING_QUEUE_COROUTINES
+
+/*
+	The default allocator policy, every node comes from
+	QueueMemAlloc() and goes back through QueueMemDealloc(),
+	exactly like a QUEUE_NODE of a QUEUE.
+*/
+struct QueueHeapAllocator
+{
+	static void *Alloc(std::size_t Size)
+	{
+		return QueueMemAlloc(Size); // MemAlloc defined in QueueConfig.h
+	}
+
+	static void Dealloc(void *Mem)
+	{
+		QueueMemDealloc(Mem); // MemDealloc defined in QueueConfig.h
+	}
+};
+
+/*
+	The locking policy for a Queue only ever used by one thread.
+	Every call compiles away.
+*/
+struct QueueNoLock
+{
+	void lock(void) { }
+	void unlock(void) { }
+};
+
+/*
+	The locking policy for a Queue shared between threads.
+*/
+struct QueueMutexLock
+{
+	std::mutex Mutex;
+
+	void lock(void) { Mutex.lock(); }
+	void unlock(void) { Mutex.unlock(); }
+};
+
+/*
+	Collects the compile time choices of a Queue.  A Capacity
+	of 0 gives an unbounded linked Queue which allocates one
+	node per element through Allocator.  Any other Capacity,
+	which must be a power of two, gives a ring which keeps all
+	of its slots inside the Queue and never allocates.
+*/
+template<UINT32 QueueCapacity = 0, class QueueAllocator = QueueHeapAllocator, class QueueLocking = QueueNoLock>
+struct QueuePolicy
+{
+	static const UINT32 Capacity = QueueCapacity;
+
+	typedef QueueAllocator Allocator;
+	typedef QueueLocking Lock;
+};
+
+/*
+	The linked storage behind a Queue, see QueueRingStorage for
+	the ring.  None of these methods lock, Queue<T, Policy> does that.
+*/
+template<class T, class Allocator>
+class QueueStorage
+{
+	struct Node
+	{
+		Node *Next;
+		alignas(T) BYTE Data[sizeof(T)];
+
+		T *Get(void) { return reinterpret_cast<T*>(Data); }
+	};
+
+	/*
+		Hands the node back to the allocator unless Release()
+		was called, so a throwing constructor of T leaks nothing.
+	*/
+	struct NodeHolder
+	{
+		Node *Held;
+
+		explicit NodeHolder(Node *NewNode) : Held(NewNode) { }
+		~NodeHolder() { if(Held) Allocator::Dealloc(Held); }
+
+		Node *Release(void) { Node *Temp = Held; Held = nullptr; return Temp; }
+	};
+
+	Node *Head;
+	Node *Tail;
+	std::size_t Size;
+
+public:
+	QueueStorage() : Head(nullptr), Tail(nullptr), Size(0) { }
+
+	std::size_t GetSize(void) const { return Size; }
+
+	/*
+		Builds the T in a new node outside of the lock, it is linked
+		in afterwards by Link().
+	*/
+	template<class... Args>
+	void *Prepare(Args&&... Arguments)
+	{
+		NodeHolder Holder(static_cast<Node*>(Allocator::Alloc(sizeof(Node))));
+
+		if(Holder.Held == nullptr)
+			return nullptr;
+
+		::new (static_cast<void*>(Holder.Held->Data)) T(std::forward<Args>(Arguments)...);
+
+		Holder.Held->Next = nullptr;
+
+		return Holder.Release();
+	}
+
+	void Discard(void *Prepared)
+	{
+		Node *Temp = static_cast<Node*>(Prepared);
+
+		Temp->Get()->~T();
+
+		Allocator::Dealloc(Temp);
+	}
+
+	bool Link(void *Prepared)
+	{
+		Node *Temp = static_cast<Node*>(Prepared);
+
+		if(Size == 0)
+			Head = Tail = Temp;
+		else
+			Tail = Tail->Next = Temp;
+
+		Size++;
+
+		return true;
+	}
+
+	/*
+		Unlinks up to Max nodes from the front as one chain, the T's
+		are moved out and the nodes freed by Finish() outside of the lock.
+	*/
+	void *Detach(std::size_t Max, std::size_t *Count)
+	{
+		Node *First, *Last;
+		std::size_t i;
+
+		if(Max > Size)
+			Max = Size;
+
+		*Count = Max;
+
+		if(Max == 0)
+			return nullptr;
+
+		First = Last = Head;
+
+		for(i = 1; i < Max; i++)
+			Last = Last->Next;
+
+		Head = Last->Next;
+
+		if(Head == nullptr)
+			Tail = nullptr;
+
+		Size -= Max;
+
+		return First;
+	}
+
+	template<class OutputIt>
+	OutputIt Finish(void *Detached, std::size_t Count, OutputIt Out)
+	{
+		Node *Temp = static_cast<Node*>(Detached), *Next;
+
+		for(; Count; Count--, ++Out)
+		{
+			Next = Temp->Next;
+
+			*Out = std::move(*Temp->Get());
+
+			Discard(Temp);
+
+			Temp = Next;
+		}
+
+		return Out;
+	}
+
+	void Clear(void)
+	{
+		Node *Temp, *Next;
+		std::size_t Count;
+
+		for(Temp = static_cast<Node*>(Detach(Size, &Count)); Count; Count--, Temp = Next)
+		{
+			Next = Temp->Next;
+
+			Discard(Temp);
+		}
+	}
+};
+
+/*
+	The ring storage.  Slot i of the ring is used by the
+	element at position i & Mask, just like a ring QUEUE.
+*/
+template<class T, UINT32 Capacity>
+class QueueRingStorage
+{
+	static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "The capacity of a ring Queue must be a power of two.");
+
+	static const UINT32 Mask = Capacity - 1;
+
+	alignas(T) BYTE Slots[Capacity * sizeof(T)];
+	UINT32 First;
+	UINT32 Size;
+
+	T *Slot(UINT32 Index) { return reinterpret_cast<T*>(Slots) + (Index & Mask); }
+
+public:
+	QueueRingStorage() : First(0), Size(0) { }
+
+	std::size_t GetSize(void) const { return Size; }
+
+	/*
+		The T is constructed straight into its slot, so there is
+		nothing to prepare outside of the lock.
+	*/
+	template<class... Args>
+	bool Emplace(Args&&... Arguments)
+	{
+		if(Size > Mask)
+			return false;
+
+		::new (static_cast<void*>(Slot(First + Size))) T(std::forward<Args>(Arguments)...);
+
+		Size++;
+
+		return true;
+	}
+
+	template<class OutputIt>
+	OutputIt Take(std::size_t Max, std::size_t *Count, OutputIt Out)
+	{
+		T *Temp;
+
+		if(Max > Size)
+			Max = Size;
+
+		for(*Count = Max; Max; Max--, ++Out)
+		{
+			Temp = Slot(First);
+
+			*Out = std::move(*Temp);
+
+			Temp->~T();
+
+			First = (First + 1) & Mask;
+			Size--;
+		}
+
+		return Out;
+	}
+
+	void Clear(void)
+	{
+		for(; Size; Size--, First = (First + 1) & Mask)
+			Slot(First)->~T();
+
+		First = 0;
+	}
+};
+
+/*
+	A FIFO of T's.  Policy is a QueuePolicy<Capacity, Allocator, Lock>.
+*/
+template<class T, class Policy = QueuePolicy<> >
+class Queue : private Policy::Lock
+{
+	typedef typename Policy::Lock Lock;
+
+	/*
+		Holds the lock for as long as it is in scope.
+	*/
+	struct Guard
+	{
+		Lock &Held;
+
+		explicit Guard(Lock &ToHold) : Held(ToHold) { Held.lock(); }
+		~Guard() { Held.unlock(); }
+	};
+
+	/*
+		A one element output iterator for try_pop().
+	*/
+	struct Single
+	{
+		T *Target;
+
+		Single &operator*(void) { return *this; }
+		Single &operator++(void) { return *this; }
+		Single &operator=(T &&Value) { *Target = std::move(Value); return *this; }
+	};
+
+	template<class P, bool IsRing = (P::Capacity != 0)>
+	struct Dispatch;
+
+	template<class P>
+	struct Dispatch<P, false>
+	{
+		typedef QueueStorage<T, typename P::Allocator> Storage;
+
+		template<class... Args>
+		static bool Emplace(Queue &Self, Args&&... Arguments)
+		{
+			// Allocate and construct before taking the lock.
+			void *Prepared = Self.Store.Prepare(std::forward<Args>(Arguments)...);
+
+			if(Prepared == nullptr)
+				return false;
+
+			Guard Held(Self);
+
+			return Self.Store.Link(Prepared);
+		}
+
+		template<class OutputIt>
+		static std::size_t Pop(Queue &Self, OutputIt Out, std::size_t Max)
+		{
+			void *Detached;
+			std::size_t Count;
+
+			{
+				Guard Held(Self);
+
+				Detached = Self.Store.Detach(Max, &Count);
+			}
+
+			// Move the T's out and free the nodes once the lock is released.
+			Self.Store.Finish(Detached, Count, Out);
+
+			return Count;
+		}
+	};
+
+	template<class P>
+	struct Dispatch<P, true>
+	{
+		typedef QueueRingStorage<T, P::Capacity> Storage;
+
+		template<class... Args>
+		static bool Emplace(Queue &Self, Args&&... Arguments)
+		{
+			Guard Held(Self);
+
+			return Self.Store.Emplace(std::forward<Args>(Arguments)...);
+		}
+
+		template<class OutputIt>
+		static std::size_t Pop(Queue &Self, OutputIt Out, std::size_t Max)
+		{
+			std::size_t Count;
+
+			Guard Held(Self);
+
+			Self.Store.Take(Max, &Count, Out);
+
+			return Count;
+		}
+	};
+
+	typedef Dispatch<Policy> Backend;
+
+	typename Backend::Storage Store;
+
+	Queue(const Queue&) = delete;
+	Queue &operator=(const Queue&) = delete;
+
+public:
+	Queue() { }
+
+	~Queue() { clear(); }
+
+	/*
+		Moves Value onto the end of the Queue.  Returns false when a
+		node could not be allocated or a ring Queue is full, in which
+		case Value is left untouched.
+	*/
+	bool push(T &&Value) { return Backend::Emplace(*this, std::move(Value)); }
+
+	bool push(const T &Value) { return Backend::Emplace(*this, Value); }
+
+	/*
+		Constructs a T from Arguments in place at the end of the Queue.
+	*/
+	template<class... Args>
+	bool emplace(Args&&... Arguments) { return Backend::Emplace(*this, std::forward<Args>(Arguments)...); }
+
+	/*
+		Moves the front T into Value.  Returns false if the Queue is empty.
+	*/
+	bool try_pop(T &Value)
+	{
+		Single Out;
+
+		Out.Target = &Value;
+
+		return Backend::Pop(*this, Out, 1) != 0;
+	}
+
+	/*
+		Moves up to Max T's, front first, through the output iterator
+		Out.  Returns how many were moved.  The whole batch costs a
+		single lock.
+	*/
+	template<class OutputIt>
+	std::size_t pop_batch(OutputIt Out, std::size_t Max) { return Backend::Pop(*this, Out, Max); }
+
+	/*
+		Destroys every T in the Queue.
+	*/
+	void clear(void) { Guard Held(*this); Store.Clear(); }
+
+	std::size_t size(void) { Guard Held(*this); return Store.GetSize(); }
+
+	bool empty(void) { return size() == 0; }
+};
+
+#if (USING_QUEUE_COROUTINES == 1)
+/*
+	The default Resumer of an AsyncQueue.  The consumer runs on
+	the thread which completed it, before that call returns.  An
+	executor passes its own Resumer to run it on one of its threads.
+*/
+struct QueueResumeInline
+{
+	void operator()(std::coroutine_handle<> Handle) const { Handle.resume(); }
+};
+
+/*
+	A Queue whose consumers are coroutines.  co_await pop() suspends
+	the consumer until a T is there, and push() hands its T straight to
+	the longest suspended consumer, which the Resumer then resumes.  The
+	T never enters the Queue and no thread is woken in between.
+
+	Nothing in here owns a thread or a timer, so the deadlines of 
+	pop_batch() are only noticed when the executor calls expire(),
+	next_deadline() tells it when.  Every consumer has to be resumed,
+	by close() if nothing else, before the AsyncQueue is destroyed.
+*/
+template<class T, class Policy = QueuePolicy<0, QueueHeapAllocator, QueueMutexLock>, class Resumer = QueueResumeInline>
+class AsyncQueue : private Policy::Lock
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	typedef typename Policy::Lock Lock;
+	typedef std::unique_lock<Lock> Guard;
+
+	/*
+		A suspended consumer.  It lives in the consumer's coroutine
+		frame, inside its awaiter, and is linked in while suspended.
+	*/
+	struct Waiter
+	{
+		Waiter *Next;
+		Waiter *Previous;
+		std::coroutine_handle<> Handle;
+
+		/*
+			Exactly one of Single and Batch is set.
+		*/
+		T *Single;
+		std::vector<T> *Batch;
+
+		std::size_t Want;
+		std::size_t Got;
+		Clock::time_point Deadline;
+		bool Linked;
+		bool Cancelled;
+	};
+
+	/*
+		What pop() and pop_batch() return.  The Waiter is only
+		touched under the lock until the consumer is resumed.
+	*/
+	class Awaiter
+	{
+		/*
+			Runs on the thread which requested the stop, or right
+			away in await_suspend() if the stop was already requested.
+		*/
+		struct OnStop
+		{
+			Awaiter *Self;
+
+			void operator()(void) noexcept { Self->Owner.Cancel(Self->Wait); }
+		};
+
+		AsyncQueue &Owner;
+		Waiter Wait;
+		std::stop_token Token;
+		std::optional<std::stop_callback<OnStop> > Callback;
+
+	public:
+		Awaiter(AsyncQueue &Queue, T *Single, std::vector<T> *Batch, std::size_t Want, Clock::time_point Deadline, std::stop_token StopToken) : Owner(Queue), Token(std::move(StopToken))
+		{
+			Wait.Next = Wait.Previous = nullptr;
+			Wait.Single = Single;
+			Wait.Batch = Batch;
+			Wait.Want = Want;
+			Wait.Got = 0;
+			Wait.Deadline = Deadline;
+			Wait.Linked = Wait.Cancelled = false;
+		}
+
+		bool await_ready(void) const noexcept { return false; }
+
+		/*
+			Returns false, so the consumer goes on at once, when
+			everything it wants is already there.
+		*/
+		bool await_suspend(std::coroutine_handle<> Handle)
+		{
+			Wait.Handle = Handle;
+
+			if(Token.stop_possible())
+				Callback.emplace(Token, OnStop{this});
+
+			return Owner.Suspend(Wait);
+		}
+
+		/*
+			The number of T's the consumer got.  Dropping the callback
+			first waits out a stop racing with the last push().
+		*/
+		std::size_t Result(void)
+		{
+			Callback.reset();
+
+			return Wait.Got;
+		}
+	};
+
+	class PopAwaiter : public Awaiter
+	{
+	public:
+		using Awaiter::Awaiter;
+
+		bool await_resume(void) { return this->Result() != 0; }
+	};
+
+	class BatchAwaiter : public Awaiter
+	{
+	public:
+		using Awaiter::Awaiter;
+
+		std::size_t await_resume(void) { return this->Result(); }
+	};
+
+	Queue<T, QueuePolicy<Policy::Capacity, typename Policy::Allocator, QueueNoLock> > Store;
+	Waiter *First;
+	Waiter *Last;
+	Resumer Resume;
+	bool Closed;
+
+	AsyncQueue(const AsyncQueue&) = delete;
+	AsyncQueue &operator=(const AsyncQueue&) = delete;
+
+	void Link(Waiter &Wait)
+	{
+		Wait.Next = nullptr;
+		Wait.Previous = Last;
+
+		if(Last)
+			Last->Next = &Wait;
+		else
+			First = &Wait;
+
+		Last = &Wait;
+		Wait.Linked = true;
+	}
+
+	void Unlink(Waiter &Wait)
+	{
+		if(Wait.Previous)
+			Wait.Previous->Next = Wait.Next;
+		else
+			First = Wait.Next;
+
+		if(Wait.Next)
+			Wait.Next->Previous = Wait.Previous;
+		else
+			Last = Wait.Previous;
+
+		Wait.Linked = false;
+	}
+
+	/*
+		Takes what Wait wants out of the Queue and links it in if 
+		that wasn't enough.  Returns true if the consumer suspends.
+	*/
+	bool Suspend(Waiter &Wait)
+	{
+		Guard Held(*this);
+
+		if(Wait.Cancelled)
+			return false;
+
+		if(Wait.Single)
+			Wait.Got = Store.try_pop(*Wait.Single) ? 1 : 0;
+		else
+			Wait.Got = Store.pop_batch(std::back_inserter(*Wait.Batch), Wait.Want);
+
+		if(Wait.Got == Wait.Want || Closed)
+			return false;
+
+		if(Wait.Deadline != Clock::time_point::max() && Wait.Deadline <= Clock::now())
+			return false;
+
+		Link(Wait);
+
+		return true;
+	}
+
+	void Cancel(Waiter &Wait)
+	{
+		std::coroutine_handle<> Handle;
+		Guard Held(*this);
+
+		Wait.Cancelled = true;
+
+		if(Wait.Linked)
+		{
+			Unlink(Wait);
+
+			Handle = Wait.Handle;
+
+			Held.unlock();
+
+			Resume(Handle);
+		}
+	}
+
+	/*
+		Resumes a chain of unlinked Waiters, outside of the lock.
+		Each one may be gone once resumed, so Next is read first.
+	*/
+	std::size_t ResumeChain(Waiter *Wait)
+	{
+		Waiter *Next;
+		std::size_t Count;
+
+		for(Count = 0; Wait; Wait = Next, Count++)
+		{
+			Next = Wait->Next;
+
+			Resume(Wait->Handle);
+		}
+
+		return Count;
+	}
+
+public:
+	explicit AsyncQueue(Resumer NewResumer = Resumer()) : First(nullptr), Last(nullptr), Resume(std::move(NewResumer)), Closed(false) { }
+
+	~AsyncQueue() { clear(); }
+
+	/*
+		Hands Value to the longest suspended consumer, or adds it to
+		the Queue if there is none.  Returns false if the AsyncQueue
+		was closed, a node could not be allocated or a ring is full.
+	*/
+	bool push(T &&Value) { return emplace(std::move(Value)); }
+
+	bool push(const T &Value) { return emplace(Value); }
+
+	template<class... Args>
+	bool emplace(Args&&... Arguments)
+	{
+		std::coroutine_handle<> Handle;
+		Waiter *Wait;
+		Guard Held(*this);
+
+		if(Closed)
+			return false;
+
+		if((Wait = First) == nullptr)
+			return Store.emplace(std::forward<Args>(Arguments)...);
+
+		// A batch consumer stays first until it has all it wants.
+		if(Wait->Single)
+			*Wait->Single = T(std::forward<Args>(Arguments)...);
+		else
+			Wait->Batch->emplace_back(std::forward<Args>(Arguments)...);
+
+		if(++Wait->Got == Wait->Want)
+		{
+			Unlink(*Wait);
+
+			Handle = Wait->Handle;
+
+			Held.unlock();
+
+			Resume(Handle);
+		}
+
+		return true;
+	}
+
+	/*
+		co_await pop(Value) moves the front T into Value, suspending
+		until there is one.  It gives true, or false without touching
+		Value when Token was stopped or the AsyncQueue was closed first.
+	*/
+	PopAwaiter pop(T &Value, std::stop_token Token = std::stop_token())
+	{
+		return PopAwaiter(*this, &Value, nullptr, 1, Clock::time_point::max(), std::move(Token));
+	}
+
+	/*
+		co_await pop_batch(Out, Count, Deadline) appends T's to Out and
+		resumes once there are Count of them, Deadline passed, Token was
+		stopped or the AsyncQueue was closed.  It gives the number appended.
+	*/
+	BatchAwaiter pop_batch(std::vector<T> &Out, std::size_t Count, Clock::time_point Deadline = Clock::time_point::max(), std::stop_token Token = std::stop_token())
+	{
+		return BatchAwaiter(*this, nullptr, &Out, Count, Deadline, std::move(Token));
+	}
+
+	/*
+		Moves the front T into Value without suspending.  Returns false
+		if the AsyncQueue is empty.
+	*/
+	bool try_pop(T &Value) { Guard Held(*this); return Store.try_pop(Value); }
+
+	/*
+		Resumes every batch consumer whose deadline is at or before Now,
+		with whatever it got so far.  Returns how many were resumed.
+	*/
+	std::size_t expire(Clock::time_point Now = Clock::now())
+	{
+		Waiter *Wait, *Next, *Expired;
+		Guard Held(*this);
+
+		for(Expired = nullptr, Wait = First; Wait; Wait = Next)
+		{
+			Next = Wait->Next;
+
+			if(Wait->Deadline <= Now)
+			{
+				Unlink(*Wait);
+
+				Wait->Next = Expired;
+				Expired = Wait;
+			}
+		}
+
+		Held.unlock();
+
+		return ResumeChain(Expired);
+	}
+
+	/*
+		The earliest deadline of a suspended consumer, or
+		Clock::time_point::max() if there is none.
+	*/
+	Clock::time_point next_deadline(void)
+	{
+		Clock::time_point Earliest = Clock::time_point::max();
+		Waiter *Wait;
+		Guard Held(*this);
+
+		for(Wait = First; Wait; Wait = Wait->Next)
+		{
+			if(Wait->Deadline < Earliest)
+				Earliest = Wait->Deadline;
+		}
+
+		return Earliest;
+	}
+
+	/*
+		Fails every later push() and resumes every suspended consumer.
+		T's already in the AsyncQueue can still be popped.
+	*/
+	void close(void)
+	{
+		Waiter *Wait;
+		Guard Held(*this);
+
+		Closed = true;
+
+		// Unlinked one by one, so a later stop can't resume them twice.
+		for(Wait = First; Wait; Wait = Wait->Next)
+			Wait->Linked = false;
+
+		Wait = First;
+		First = Last = nullptr;
+
+		Held.unlock();
+
+		ResumeChain(Wait);
+	}
+
+	void clear(void) { Guard Held(*this); Store.clear(); }
+
+	std::size_t size(void) { Guard Held(*this); return Store.size(); }
+
+	bool empty(void) { return size() == 0; }
+};
+#endif // end of USING_QUEUE_COROUTINES
+
+#endif // end of QUEUE_HPP
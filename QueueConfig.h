@@ -1,7 +1,7 @@
 /*
 	Date: June 24, 2011
 	File Name: QueueConfig.h
-	Version: 1.03
+	Version: 1.04
 	IDE: Visual Studio 2010 Professional
 	Compiler: C89
 
@@ -17,6 +17,17 @@
 	QueueCreate, QueueAdd, QueueRemove, and QueueClear.  The reason
 	for this is that it all depends on how the user defines the 
 	way the Queue library will allocate, deallocate memory.
+
+	The SPSC_QUEUE and RECORD_QUEUE methods may be called by one producer
+	and one consumer thread at the same time without any lock.  The MPMC_QUEUE methods may 
+	be called by any number of threads at the same time without any lock.
+	WsDequePush and WsDequePop may only be called by the owner of a WS_DEQUE,
+	WsDequeSteal by any thread at the same time.
+
+	Each switch below is only defined if it isn't defined already, so a
+	build can also set it on the compiler's command line, for example
+	-DUSING_QUEUE_NODE_POOL=1.  The tests and benchmarks build the library
+	once per configuration that way.
 */
 
 #ifndef QUEUE_CONFIG_H
@@ -26,38 +37,85 @@
 	*Set USING_QUEUE_PEEK_METHOD to 1 to enable the
 	QueuePeek method.
 */
-#define USING_QUEUE_PEEK_METHOD							1
+#ifndef USING_QUEUE_PEEK_METHOD
+	#define USING_QUEUE_PEEK_METHOD						1
+#endif // end of USING_QUEUE_PEEK_METHOD
 
 /**
 	*Set USING_QUEUE_CLEAR_METHOD to 1 to enable the
 	QueueClear method.
 */ 
-#define USING_QUEUE_CLEAR_METHOD						1
+#ifndef USING_QUEUE_CLEAR_METHOD
+	#define USING_QUEUE_CLEAR_METHOD					1
+#endif // end of USING_QUEUE_CLEAR_METHOD
 
 /**
 	*Set USING_QUEUE_GET_SIZE_METHOD to 1 to enable the
 	QueueGetSize method.
 */
-#define USING_QUEUE_GET_SIZE_METHOD						1
+#ifndef USING_QUEUE_GET_SIZE_METHOD
+	#define USING_QUEUE_GET_SIZE_METHOD					1
+#endif // end of USING_QUEUE_GET_SIZE_METHOD
 
 /**
 	*Set USING_QUEUE_GET_SIZE_IN_BYTES_METHOD to 1 to enable the
 	QueueGetSizeInBytes method.
 */
-#define USING_QUEUE_GET_SIZE_IN_BYTES_METHOD			1
+#ifndef USING_QUEUE_GET_SIZE_IN_BYTES_METHOD
+	#define USING_QUEUE_GET_SIZE_IN_BYTES_METHOD		1
+#endif // end of USING_QUEUE_GET_SIZE_IN_BYTES_METHOD
 
 /**
 	*Set USING_QUEUE_GET_LIBRARY_VERSION to 1 to enable getting
 	the current version of the QUEUE Library.
 */
-#define USING_QUEUE_GET_LIBRARY_VERSION					1
+#ifndef USING_QUEUE_GET_LIBRARY_VERSION
+	#define USING_QUEUE_GET_LIBRARY_VERSION				1
+#endif // end of USING_QUEUE_GET_LIBRARY_VERSION
+
+/**
+	*Set USING_QUEUE_BATCH_METHODS to 1 to enable the QueueAddBatch,
+	QueueRemoveBatch and QueueDrain methods.
+*/
+#ifndef USING_QUEUE_BATCH_METHODS
+	#define USING_QUEUE_BATCH_METHODS					1
+#endif // end of USING_QUEUE_BATCH_METHODS
+
+/**
+	*Set USING_QUEUE_SPLICE_METHODS to 1 to enable the QueueAppendQueue,
+	QueueSwap and QueueSplitAfter methods, which move whole chains of
+	QUEUE_NODE's between QUEUE's without freeing or allocating them.
+*/
+#ifndef USING_QUEUE_SPLICE_METHODS
+	#define USING_QUEUE_SPLICE_METHODS					1
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+/**
+	*Set USING_QUEUE_STATISTICS to 1 to have every QUEUE count what is
+	added, removed and cleared, its largest size, failed allocations and
+	removes from an empty QUEUE.  Read them with QueueGetStats().
+*/
+#ifndef USING_QUEUE_STATISTICS
+	#define USING_QUEUE_STATISTICS						0
+#endif // end of USING_QUEUE_STATISTICS
+
+/**
+	*Set USING_QUEUE_WAIT_TIME_STATISTICS to 1, along with USING_QUEUE_STATISTICS,
+	to also time how long data waits in a QUEUE.  One piece of data at a time
+	is timed with QueueGetTickCount(), so the cost is one tick read per sample.
+*/
+#ifndef USING_QUEUE_WAIT_TIME_STATISTICS
+	#define USING_QUEUE_WAIT_TIME_STATISTICS			0
+#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
 
 /**
 	*Set QUEUE_SAFE_MODE to 1 to enable the portions of code
 	inside the QUEUE Library that check to make sure all passed
 	in parameters are of a valid nature.
 */
-#define QUEUE_SAFE_MODE									1
+#ifndef QUEUE_SAFE_MODE
+	#define QUEUE_SAFE_MODE								1
+#endif // end of QUEUE_SAFE_MODE
 
 /**
 	*The below defines what method the Queue library will use to 
@@ -75,13 +133,465 @@
 	*Define USE_MALLOC as 1 to enable the stdlib.h file included
 	with Queue.c.
 */
-#define USE_MALLOC										1
+#ifndef USE_MALLOC
+	#define USE_MALLOC									1
+#endif // end of USE_MALLOC
 
 /*
 	*Define the below as 1 if each QUEUE is to store a custom
 	method for freeing a QUEUE_NODE.
 */
-#define USING_QUEUE_DEPENDENT_FREE_METHOD				1
+#ifndef USING_QUEUE_DEPENDENT_FREE_METHOD
+	#define USING_QUEUE_DEPENDENT_FREE_METHOD			1
+#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+/**
+	*Set USING_QUEUE_NODE_POOL to 1 to have the Queue library carve
+	QUEUE_NODE's out of slabs instead of calling QueueMemAlloc() for
+	every QueueAdd().  Nodes given back by QueueRemove() and QueueClear()
+	are recycled through the slabs they came from, shared by every QUEUE.
+	Each QUEUE_NODE grows by a pointer to its slab.
+*/
+#ifndef USING_QUEUE_NODE_POOL
+	#define USING_QUEUE_NODE_POOL						0
+#endif // end of USING_QUEUE_NODE_POOL
+
+/**
+	*The number of QUEUE_NODE's carved out of one slab.  Each slab is
+	allocated with a single call to QueueMemAlloc().
+*/
+#ifndef QUEUE_NODE_POOL_SLAB_SIZE
+	#define QUEUE_NODE_POOL_SLAB_SIZE					64
+#endif // end of QUEUE_NODE_POOL_SLAB_SIZE
+
+/**
+	*The maximum number of idle QUEUE_NODE's the pool will retain.  Once
+	freeing QUEUE_NODE's leaves a whole slab's worth of idle nodes more
+	than this in the pool, slabs which are completely idle are handed
+	back with QueueMemDealloc().  Set to 0 to never shrink the pool
+	automatically.
+*/
+#ifndef QUEUE_NODE_POOL_MAX_FREE_NODES
+	#define QUEUE_NODE_POOL_MAX_FREE_NODES				1024
+#endif // end of QUEUE_NODE_POOL_MAX_FREE_NODES
+
+/**
+	*The methods the node pool allocates and frees its slabs with.  To keep
+	a producer's QUEUE_NODE's on its own NUMA node define them as
+	numa_alloc_local(Size) and numa_free(Mem, Size) from libnuma.  A slab
+	is allocated by the thread that ran out of nodes, and with the node
+	cache below its nodes keep coming back to that thread.
+*/
+#define QueueNodeSlabAlloc(Size)						QueueMemAlloc(Size)
+#define QueueNodeSlabDealloc(Mem, Size)					QueueMemDealloc(Mem)
+
+/**
+	*Set USING_QUEUE_NODE_CACHE to 1 to give every thread its own cache of
+	idle QUEUE_NODE's in front of the node pool.  A thread takes and frees
+	its own nodes without a lock.  A node freed by another thread is sent
+	back to the cache it came from QUEUE_NODE_CACHE_BATCH at a time, or as
+	soon as a remove finds its QUEUE empty, so a producer and a consumer
+	on two threads recycle the same nodes without touching the pool or the
+	allocator.  Needs USING_QUEUE_NODE_POOL and 
+	QUEUE_THREAD_LOCAL, each QUEUE_NODE grows by a pointer.
+*/
+#ifndef USING_QUEUE_NODE_CACHE
+	#define USING_QUEUE_NODE_CACHE						0
+#endif // end of USING_QUEUE_NODE_CACHE
+
+/**
+	*The number of QUEUE_NODE's a node cache takes from the pool at once,
+	and the number another thread collects before sending them back.
+*/
+#ifndef QUEUE_NODE_CACHE_BATCH
+	#define QUEUE_NODE_CACHE_BATCH						32
+#endif // end of QUEUE_NODE_CACHE_BATCH
+
+/**
+	*The most idle QUEUE_NODE's a node cache keeps.  Above this it hands
+	QUEUE_NODE_CACHE_BATCH of them back to the node pool.
+*/
+#ifndef QUEUE_NODE_CACHE_MAX_FREE_NODES
+	#define QUEUE_NODE_CACHE_MAX_FREE_NODES				256
+#endif // end of QUEUE_NODE_CACHE_MAX_FREE_NODES
+
+/**
+	*Set USING_QUEUE_SEGMENTED_NODES to 1 to have each QUEUE_NODE hold
+	QUEUE_SEGMENT_SIZE pieces of data instead of one.  QueueAdd() then only
+	allocates once every QUEUE_SEGMENT_SIZE items and QueueRemove() and 
+	QueuePeek() walk the data of a node sequentially.
+*/
+#ifndef USING_QUEUE_SEGMENTED_NODES
+	#define USING_QUEUE_SEGMENTED_NODES					0
+#endif // end of USING_QUEUE_SEGMENTED_NODES
+
+/**
+	*The number of pieces of data held by one QUEUE_NODE when
+	USING_QUEUE_SEGMENTED_NODES is defined as 1.  With the node pool
+	enabled each slab holds QUEUE_NODE_POOL_SLAB_SIZE of these nodes.
+*/
+#ifndef QUEUE_SEGMENT_SIZE
+	#define QUEUE_SEGMENT_SIZE							64
+#endif // end of QUEUE_SEGMENT_SIZE
+
+/**
+	*Set USING_QUEUE_RING_BUFFER to 1 to enable the CreateRingQueue
+	and DestroyRingQueue methods.  A ring QUEUE stores its data in one
+	array sized to a power of two and never allocates after creation.
+*/
+#ifndef USING_QUEUE_RING_BUFFER
+	#define USING_QUEUE_RING_BUFFER						0
+#endif // end of USING_QUEUE_RING_BUFFER
+
+/**
+	*Set USING_QUEUE_INTRUSIVE to 1 to enable the CreateIntrusiveQueue
+	method.  An intrusive QUEUE links the QUEUE_NODE embedded in each
+	piece of data, so QueueAdd() and QueueRemove() never allocate.
+*/
+#ifndef USING_QUEUE_INTRUSIVE
+	#define USING_QUEUE_INTRUSIVE						0
+#endif // end of USING_QUEUE_INTRUSIVE
+
+/**
+	*Set USING_QUEUE_COPY to 1 to enable the CreateCopyQueue, QueueAddCopy
+	and QueueRemoveInto methods.  A copy QUEUE stores a copy of each fixed
+	size element in the same allocation as its QUEUE_NODE.
+*/
+#ifndef USING_QUEUE_COPY
+	#define USING_QUEUE_COPY							0
+#endif // end of USING_QUEUE_COPY
+
+/**
+	*Set USING_QUEUE_PRIORITY to 1 to enable the CreatePriorityQueue,
+	DestroyPriorityQueue and QueueAddWithPriority methods.  A priority
+	QUEUE is a d-ary heap kept in one array, QueueRemove() returns the
+	data with the highest priority and the oldest among equal priorities.
+*/
+#ifndef USING_QUEUE_PRIORITY
+	#define USING_QUEUE_PRIORITY						0
+#endif // end of USING_QUEUE_PRIORITY
+
+/**
+	*The number of children of each entry of a priority QUEUE's heap.
+	A wider heap is shallower and its children share cache lines.
+*/
+#ifndef QUEUE_PRIORITY_HEAP_ARITY
+	#define QUEUE_PRIORITY_HEAP_ARITY					4
+#endif // end of QUEUE_PRIORITY_HEAP_ARITY
+
+/**
+	*Set USING_QUEUE_TIMER to 1 to enable the CreateTimerQueue, 
+	DestroyTimerQueue, QueueAddAt and QueueGetNextDeadline methods.  Data
+	added to a timer QUEUE with QueueAddAt() waits on a hierarchical timing
+	wheel and only becomes visible to QueueRemove() once its deadline, in
+	QueueGetTickCount() milliseconds, has passed.  Needs QueueGetTickCount().
+*/
+#ifndef USING_QUEUE_TIMER
+	#define USING_QUEUE_TIMER							0
+#endif // end of USING_QUEUE_TIMER
+
+/**
+	*Set USING_QUEUE_SPSC to 1 to enable the SPSC_QUEUE.  An SPSC_QUEUE
+	is a fixed capacity ring that one producer thread and one consumer
+	thread can use at the same time without taking a lock.
+*/
+#ifndef USING_QUEUE_SPSC
+	#define USING_QUEUE_SPSC							0
+#endif // end of USING_QUEUE_SPSC
+
+/**
+	*Set USING_QUEUE_RECORD to 1 to enable the RECORD_QUEUE.  A RECORD_QUEUE
+	holds variable length records of bytes back to back in one buffer.  The
+	producer reserves room for a record, writes it in place and commits it,
+	the consumer reads it in place and releases it, without a lock, an 
+	allocation or a copy.
+*/
+#ifndef USING_QUEUE_RECORD
+	#define USING_QUEUE_RECORD							0
+#endif // end of USING_QUEUE_RECORD
+
+/**
+	*Set USING_QUEUE_MPMC to 1 to enable the MPMC_QUEUE.  An MPMC_QUEUE
+	is a fixed capacity ring that any number of producer and consumer
+	threads can use at the same time without taking a lock.
+*/
+#ifndef USING_QUEUE_MPMC
+	#define USING_QUEUE_MPMC							0
+#endif // end of USING_QUEUE_MPMC
+
+/**
+	*Set USING_QUEUE_WORK_STEALING to 1 to enable the WS_DEQUE.  A WS_DEQUE
+	is a growable Chase-Lev deque for a thread pool.  Its owner thread adds
+	and removes at the bottom without a lock, while any other thread can
+	steal from the top with a single compare and exchange.
+*/
+#ifndef USING_QUEUE_WORK_STEALING
+	#define USING_QUEUE_WORK_STEALING					0
+#endif // end of USING_QUEUE_WORK_STEALING
+
+/**
+	*Set USING_QUEUE_PERSISTENT to 1 to enable the PERSISTENT_QUEUE.  A
+	PERSISTENT_QUEUE appends length prefixed records to memory mapped
+	segment files in a directory, so its contents survive a restart.
+	Needs USE_PTHREADS, since it uses POSIX mmap() and fsync().
+*/
+#ifndef USING_QUEUE_PERSISTENT
+	#define USING_QUEUE_PERSISTENT						0
+#endif // end of USING_QUEUE_PERSISTENT
+
+/**
+	*The size in bytes of one segment file of a PERSISTENT_QUEUE, a
+	multiple of the page size.  A record holds at most this many bytes
+	less 16.
+*/
+#ifndef QUEUE_PERSISTENT_SEGMENT_SIZE
+	#define QUEUE_PERSISTENT_SEGMENT_SIZE				0x01000000
+#endif // end of QUEUE_PERSISTENT_SEGMENT_SIZE
+
+/**
+	*Set QUEUE_PERSISTENT_RECYCLE_SEGMENTS to 1 to keep the last consumed
+	segment file and reuse it for the next new segment, instead of deleting
+	it and allocating the blocks of a new one.
+*/
+#ifndef QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+	#define QUEUE_PERSISTENT_RECYCLE_SEGMENTS			1
+#endif // end of QUEUE_PERSISTENT_RECYCLE_SEGMENTS
+
+/**
+	*The longest directory path a PERSISTENT_QUEUE accepts, in characters.
+*/
+#ifndef QUEUE_PERSISTENT_MAX_PATH
+	#define QUEUE_PERSISTENT_MAX_PATH					256
+#endif // end of QUEUE_PERSISTENT_MAX_PATH
+
+/**
+	*Set USING_QUEUE_SHARED to 1 to enable the SHARED_QUEUE.  A SHARED_QUEUE
+	lives in a POSIX shared memory object, so processes on the same host can
+	pass messages through it without a system call unless one has to wait.
+	Needs USE_PTHREADS and the QueueFutexWait() and QueueFutexWake() methods.
+*/
+#ifndef USING_QUEUE_SHARED
+	#define USING_QUEUE_SHARED							0
+#endif // end of USING_QUEUE_SHARED
+
+/**
+	*The longest name of a SHARED_QUEUE, in characters.
+*/
+#ifndef QUEUE_SHARED_MAX_NAME
+	#define QUEUE_SHARED_MAX_NAME						64
+#endif // end of QUEUE_SHARED_MAX_NAME
+
+/**
+	*Set USING_QUEUE_MULTI to 1 to enable the MULTI_QUEUE.  A MULTI_QUEUE
+	spreads its data over many locked shards so that threads rarely meet on
+	the same lock.  Removes take from the older front of two random shards,
+	so the order is only roughly first in, first out.  Needs USE_PTHREADS.
+*/
+#ifndef USING_QUEUE_MULTI
+	#define USING_QUEUE_MULTI							0
+#endif // end of USING_QUEUE_MULTI
+
+/**
+	*The number of entries each shard of a MULTI_QUEUE starts with, a power
+	of two.  A shard doubles whenever it runs out.
+*/
+#ifndef QUEUE_MULTI_INITIAL_CAPACITY
+	#define QUEUE_MULTI_INITIAL_CAPACITY				32
+#endif // end of QUEUE_MULTI_INITIAL_CAPACITY
+
+/**
+	*Set USING_QUEUE_COROUTINES to 1 to enable AsyncQueue<T> in Queue.hpp,
+	a Queue whose consumers co_await their data.  Needs C++20.
+*/
+#ifndef USING_QUEUE_COROUTINES
+	#define USING_QUEUE_COROUTINES						0
+#endif // end of USING_QUEUE_COROUTINES
+
+/**
+	*The size in bytes of a cache line on the target.  Indexes written by
+	different threads are kept at least this far apart.
+*/
+#ifndef QUEUE_CACHE_LINE_SIZE
+	#define QUEUE_CACHE_LINE_SIZE						64
+#endif // end of QUEUE_CACHE_LINE_SIZE
+
+/**
+	*The methods the lock-free QUEUE's use to read and write indexes shared
+	between threads.  By default these are the GCC atomic builtins.
+*/
+#define QueueAtomicLoadRelaxed(Ptr)						__atomic_load_n(Ptr, __ATOMIC_RELAXED)
+#define QueueAtomicLoadAcquire(Ptr)						__atomic_load_n(Ptr, __ATOMIC_ACQUIRE)
+#define QueueAtomicStoreRelease(Ptr, Value)				__atomic_store_n(Ptr, Value, __ATOMIC_RELEASE)
+#define QueueAtomicStoreRelaxed(Ptr, Value)				__atomic_store_n(Ptr, Value, __ATOMIC_RELAXED)
+
+/**
+	*Full and release memory fences.
+*/
+#define QueueAtomicFence()								__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define QueueAtomicFenceRelease()						__atomic_thread_fence(__ATOMIC_RELEASE)
+
+/**
+	*Compares *Ptr against *Expected and stores Value into *Ptr if they match.
+	Must evaluate to non zero if Value was stored, otherwise it must copy the
+	current value of *Ptr into *Expected and evaluate to 0.
+*/
+#define QueueAtomicCompareExchange(Ptr, Expected, Value)	__atomic_compare_exchange_n(Ptr, Expected, Value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+/**
+	*Like QueueAtomicCompareExchange() but it may not fail spuriously and it
+	is ordered with every other sequentially consistent operation.
+*/
+#define QueueAtomicCompareExchangeStrong(Ptr, Expected, Value)	__atomic_compare_exchange_n(Ptr, Expected, Value, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)
+
+/**
+	*Adds Value to *Ptr as one indivisible step, with no ordering.
+*/
+#define QueueAtomicAddRelaxed(Ptr, Value)				__atomic_fetch_add(Ptr, Value, __ATOMIC_RELAXED)
+
+/**
+	*Set USING_QUEUE_ALLOCATION_COUNTERS to 1 to have the Queue library
+	count every call it makes to QueueMemAlloc() and QueueMemDealloc().
+	Read the counts with QueueGetAllocationStats() to measure allocations
+	per operation while benchmarking a configuration.
+*/
+#ifndef USING_QUEUE_ALLOCATION_COUNTERS
+	#define USING_QUEUE_ALLOCATION_COUNTERS				0
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
+
+/**
+	*Set USING_QUEUE_BLOCKING_METHODS to 1 to enable the QueueRemoveWait,
+	QueueAddWait and QueueClose methods.  Every QUEUE then carries a lock
+	which QueueAdd, QueueRemove, QueuePeek and QueueClear also take.
+*/
+#ifndef USING_QUEUE_BLOCKING_METHODS
+	#define USING_QUEUE_BLOCKING_METHODS				0
+#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+/**
+	*Set USING_QUEUE_BOUNDED to 1 to enable the CreateBoundedQueue and 
+	QueueGetDropCount methods.  A bounded QUEUE never holds more than its
+	limit, and its overflow policy says what happens to data added beyond it.
+*/
+#ifndef USING_QUEUE_BOUNDED
+	#define USING_QUEUE_BOUNDED							0
+#endif // end of USING_QUEUE_BOUNDED
+
+/**
+	*Set USING_QUEUE_EVENT_FD to 1 to enable the QueueOpenEventFd and 
+	QueueCloseEventFd methods.  A QUEUE with an event file descriptor makes 
+	it readable when data is added to the QUEUE after a consumer found it 
+	empty, so it can be waited on with poll() or epoll() next to sockets.
+	Needs USE_PTHREADS and the QueueEvent methods below.
+*/
+#ifndef USING_QUEUE_EVENT_FD
+	#define USING_QUEUE_EVENT_FD						0
+#endif // end of USING_QUEUE_EVENT_FD
+
+/**
+	*Set USING_QUEUE_DEFERRED_CLEAR to 1 to enable the QueueClearDeferred,
+	QueueStartReclaimer and QueueStopReclaimer methods.  QueueClearDeferred()
+	detaches everything in a QUEUE at once and leaves the freeing of the
+	data and its QUEUE_NODE's to a background reclaimer thread.  Needs
+	USING_QUEUE_CLEAR_METHOD and USING_QUEUE_BLOCKING_METHODS.
+*/
+#ifndef USING_QUEUE_DEFERRED_CLEAR
+	#define USING_QUEUE_DEFERRED_CLEAR					0
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
+/**
+	*Define USE_PTHREADS as 1 to use POSIX threads for the lock, the
+	condition variables, the node pool lock and QueueGetTickCount(), which
+	the blocking methods and the wait time statistics use.
+*/
+#ifndef USE_PTHREADS
+	#define USE_PTHREADS								0
+#endif // end of USE_PTHREADS
+
+/**
+	*The timeout passed to QueueRemoveWait and QueueAddWait to wait
+	for as long as it takes.
+*/
+#define QUEUE_WAIT_FOREVER								0xFFFFFFFF
+
+#if (USE_PTHREADS == 1)
+	#include "pthread.h"
+
+	/**
+		*The lock and condition variable types and methods used by the
+		blocking methods.  QueueConditionWait() waits at most Timeout
+		milliseconds, or forever when Timeout is QUEUE_WAIT_FOREVER.
+	*/
+	#define QUEUE_LOCK									pthread_mutex_t
+	#define QUEUE_CONDITION								pthread_cond_t
+	#define QueueLockInit(Lock)							pthread_mutex_init(Lock, NULL)
+	#define QueueLock(Lock)								pthread_mutex_lock(Lock)
+	#define QueueUnlock(Lock)							pthread_mutex_unlock(Lock)
+	#define QueueConditionInit(Condition)				pthread_cond_init(Condition, NULL)
+	#define QueueConditionSignal(Condition)				pthread_cond_signal(Condition)
+	#define QueueConditionBroadcast(Condition)			pthread_cond_broadcast(Condition)
+	#define QueueConditionWait(Condition, Lock, Timeout)	QueuePthreadConditionWait(Condition, Lock, Timeout)
+
+	/**
+		*Returns a free running count of milliseconds.
+	*/
+	#define QueueGetTickCount()							QueuePosixGetTickCount()
+
+	/**
+		*The methods used to protect the node pool when more than one thread
+		uses the Queue library.
+	*/
+	#define QueueNodePoolLock()							pthread_mutex_lock(&QueueNodePoolMutex)
+	#define QueueNodePoolUnlock()						pthread_mutex_unlock(&QueueNodePoolMutex)
+
+	/**
+		*The thread type and methods used to run the reclaimer thread
+		of QueueClearDeferred().  QueueThreadCreate() is TRUE on success.
+	*/
+	#define QUEUE_THREAD								pthread_t
+	#define QUEUE_THREAD_RESULT							void*
+	#define QueueThreadCreate(Thread, Method)			(pthread_create(Thread, NULL, Method, NULL) == 0)
+	#define QueueThreadJoin(Thread)						pthread_join(Thread, NULL)
+
+	/**
+		*What a MULTI_QUEUE needs on top of the lock methods above.  
+		QueueTryLock() is TRUE if it took the lock without waiting,
+		QUEUE_THREAD_LOCAL gives every thread its own copy of a variable
+		and QueueGetTimestamp() returns a free running count of nanoseconds.
+	*/
+	#define QueueTryLock(Lock)							(pthread_mutex_trylock(Lock) == 0)
+	#define QUEUE_THREAD_LOCAL							__thread
+	#define QueueGetTimestamp()							QueuePosixGetTimestamp()
+
+	#if defined(__linux__)
+		/**
+			*The methods a SHARED_QUEUE uses to sleep on and wake up a 32 bit
+			word in shared memory.  QueueFutexWait() returns once the word no
+			longer holds Value, it is woken or Timeout milliseconds passed.
+		*/
+		#define QueueFutexWait(Address, Value, Timeout)	QueueLinuxFutexWait(Address, Value, Timeout)
+		#define QueueFutexWake(Address, Count)			QueueLinuxFutexWake(Address, Count)
+
+		/**
+			*The methods behind QueueOpenEventFd().  QueueEventCreate() returns
+			a new non-blocking event file descriptor or -1, QueueEventSignal()
+			makes it readable and QueueEventClear() makes it unreadable again.
+		*/
+		#define QueueEventCreate()						QueueLinuxEventCreate()
+		#define QueueEventSignal(Fd)					QueueLinuxEventSignal(Fd)
+		#define QueueEventClear(Fd)						QueueLinuxEventClear(Fd)
+		#define QueueEventClose(Fd)						close(Fd)
+	#endif // end of __linux__
+#else
+	/**
+		*The methods used to protect the node pool when more than one thread
+		uses the Queue library.  Leave these empty for single threaded use.
+		Any other OS supplies its own QUEUE_LOCK, QUEUE_CONDITION, lock and
+		condition methods and QueueGetTickCount() here, and QUEUE_THREAD
+		and its methods for USING_QUEUE_DEFERRED_CLEAR.
+	*/
+	#define QueueNodePoolLock()
+	#define QueueNodePoolUnlock()
+#endif // end of USE_PTHREADS
 
 /**
 	*If the user isn't using malloc then include the file that will
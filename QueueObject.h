@@ -1,7 +1,7 @@
 /*
 	Date: June 24, 2011
 	File Name: QueueObject.h
-	Version: 1.03
+	Version: 1.04
 	IDE: Visual Studio 2010 Professional
 	Compiler: C89
 
@@ -19,23 +19,399 @@
 /*
 	The following struct is a node within the Queue.
 	Each node points to a piece of data that the user
-	passed in when calling QueueAdd().
+	passed in when calling QueueAdd().  With 
+	USING_QUEUE_SEGMENTED_NODES defined as 1 each node
+	instead points to up to QUEUE_SEGMENT_SIZE pieces 
+	of data, stored from index First up to Last.
 */
 struct _QueueNode
 {
-	/**
-	* A pointer to the data that the QUEUE_NODE will point to.
-	*/
-	void *Data;
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		/**
+		* The index in Data of the next piece of data to be removed.
+		*/
+		UINT32 First;
+
+		/**
+		* The index in Data at which the next piece of data will be added.
+		*/
+		UINT32 Last;
+	#else
+		/**
+		* A pointer to the data that the QUEUE_NODE will point to.
+		*/
+		void *Data;
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
 
 	/**
 	* A pointer to the next QUEUE_NODE in the QUEUE.
 	*/
 	struct _QueueNode *Next;
+
+	#if (USING_QUEUE_NODE_POOL == 1)
+		/**
+		* The slab of the node pool the QUEUE_NODE was carved out of.
+		*/
+		struct _QueueNodeSlab *Slab;
+	#endif // end of USING_QUEUE_NODE_POOL
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+		/**
+		* The node cache of the thread which allocated the QUEUE_NODE.
+		*/
+		struct _QueueNodeCache *Owner;
+	#endif // end of USING_QUEUE_NODE_CACHE
+
+	#if (USING_QUEUE_SEGMENTED_NODES == 1)
+		/**
+		* The pointers to the data that the QUEUE_NODE will point to.
+		*/
+		void *Data[QUEUE_SEGMENT_SIZE];
+	#endif // end of USING_QUEUE_SEGMENTED_NODES
 };
 
 typedef struct _QueueNode QUEUE_NODE;
 
+#if (USING_QUEUE_NODE_POOL == 1)
+	/*
+		The following struct is one slab of the node pool.
+		A slab is allocated in a single call to QueueMemAlloc()
+		and its QUEUE_NODE's are handed out one at a time by
+		QueueAdd().
+	*/
+	struct _QueueNodeSlab
+	{
+		/**
+		* The next and previous slab with idle QUEUE_NODE's.
+		*/
+		struct _QueueNodeSlab *Next, *Prev;
+
+		/**
+		* The idle QUEUE_NODE's of this slab.
+		*/
+		QUEUE_NODE *FreeList;
+
+		/**
+		* The number of QUEUE_NODE's on FreeList.
+		*/
+		UINT32 FreeNodes;
+
+		/**
+		* The QUEUE_NODE's carved out of this slab.
+		*/
+		QUEUE_NODE Nodes[QUEUE_NODE_POOL_SLAB_SIZE];
+	};
+
+	typedef struct _QueueNodeSlab QUEUE_NODE_SLAB;
+
+	/*
+		The following struct is a snapshot of the node pool
+		returned by QueueNodePoolGetStats().
+	*/
+	struct _QueueNodePoolStats
+	{
+		/**
+		* The number of slabs currently owned by the pool.
+		*/
+		UINT32 Slabs;
+
+		/**
+		* The number of QUEUE_NODE's currently owned by the pool.
+		*/
+		UINT32 TotalNodes;
+
+		/**
+		* The number of QUEUE_NODE's sitting idle in the pool's slabs.  Nodes
+		held by a node cache count as in use.
+		*/
+		UINT32 FreeNodes;
+
+		/**
+		* The highest number of QUEUE_NODE's that were in use at once.
+		*/
+		UINT32 PeakNodesInUse;
+
+		/**
+		* The number of times a slab was allocated with QueueMemAlloc().
+		*/
+		UINT32 SlabAllocations;
+
+		/**
+		* The number of times a slab was released with QueueMemDealloc().
+		*/
+		UINT32 SlabReleases;
+	};
+
+	typedef struct _QueueNodePoolStats QUEUE_NODE_POOL_STATS;
+#endif // end of USING_QUEUE_NODE_POOL
+
+#if (USING_QUEUE_NODE_CACHE == 1 && (USING_QUEUE_NODE_POOL == 0 || !defined(QUEUE_THREAD_LOCAL)))
+	#error "A node cache sits in front of the node pool and needs QUEUE_THREAD_LOCAL, enable USING_QUEUE_NODE_POOL and USE_PTHREADS."
+#endif // end of USING_QUEUE_NODE_CACHE
+
+#if (USING_QUEUE_NODE_CACHE == 1)
+	/*
+		The following struct is the node cache of one thread.
+		Only its thread touches the idle nodes, other threads
+		only push nodes onto Returned, which is kept a cache
+		line away.  A cache is never freed, a thread that is
+		done with it leaves it for the next thread to adopt.
+	*/
+	struct _QueueNodeCache
+	{
+		/**
+		* The QUEUE_NODE's other threads sent back, pushed with a compare and exchange.
+		*/
+		QUEUE_NODE *Returned;
+
+		BYTE ReturnedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The idle QUEUE_NODE's of the thread.
+		*/
+		QUEUE_NODE *FreeList;
+
+		/**
+		* The number of QUEUE_NODE's on FreeList.
+		*/
+		UINT32 FreeNodes;
+
+		/**
+		* The cache the QUEUE_NODE's from RemoteFirst to RemoteLast go back to.
+		*/
+		struct _QueueNodeCache *Remote;
+
+		/**
+		* The QUEUE_NODE's of another thread freed by this one, not yet sent back.
+		*/
+		QUEUE_NODE *RemoteFirst;
+		QUEUE_NODE *RemoteLast;
+		UINT32 RemoteNodes;
+
+		/**
+		* TRUE while a thread owns the cache.
+		*/
+		BOOL InUse;
+
+		/**
+		* The next cache ever created.
+		*/
+		struct _QueueNodeCache *Next;
+	};
+
+	typedef struct _QueueNodeCache QUEUE_NODE_CACHE;
+#endif // end of USING_QUEUE_NODE_CACHE
+
+#if (USING_QUEUE_ALLOCATION_COUNTERS == 1)
+	/*
+		The following struct is a snapshot of the allocation
+		counters returned by QueueGetAllocationStats().
+	*/
+	struct _QueueAllocationStats
+	{
+		/**
+		* The number of successful calls to QueueMemAlloc().
+		*/
+		UINT32 Allocations;
+
+		/**
+		* The number of calls to QueueMemAlloc() that returned NULL.
+		*/
+		UINT32 FailedAllocations;
+
+		/**
+		* The number of calls to QueueMemDealloc().
+		*/
+		UINT32 Deallocations;
+	};
+
+	typedef struct _QueueAllocationStats QUEUE_ALLOCATION_STATS;
+#endif // end of USING_QUEUE_ALLOCATION_COUNTERS
+
+#if (USING_QUEUE_STATISTICS == 1)
+	/*
+		The following struct holds the statistics of one QUEUE,
+		a copy of it is returned by QueueGetStats().
+	*/
+	struct _QueueStats
+	{
+		/**
+		* The number of pieces of data ever added to the QUEUE.
+		*/
+		UINT32 Enqueues;
+
+		/**
+		* The number of pieces of data ever removed from the QUEUE.
+		*/
+		UINT32 Dequeues;
+
+		/**
+		* The number of pieces of data thrown away by QueueClear() or by
+		* QUEUE_OVERFLOW_DROP_OLDEST.
+		*/
+		UINT32 Cleared;
+
+		/**
+		* The largest Size the QUEUE ever reached.
+		*/
+		UINT32 HighWaterMark;
+
+		/**
+		* The number of times adding failed because memory could not be allocated.
+		*/
+		UINT32 AllocationFailures;
+
+		/**
+		* The number of times data was asked for while the QUEUE was empty.
+		*/
+		UINT32 EmptyRemoves;
+
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			/**
+			* The number of pieces of data that were timed.
+			*/
+			UINT32 WaitSamples;
+
+			/**
+			* The sum, in QueueGetTickCount() ticks, of the time each timed piece of data waited.
+			*/
+			UINT32 TotalWaitTime;
+
+			/**
+			* The longest time, in QueueGetTickCount() ticks, any timed piece of data waited.
+			*/
+			UINT32 MaxWaitTime;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+	};
+
+	typedef struct _QueueStats QUEUE_STATS;
+#endif // end of USING_QUEUE_STATISTICS
+
+/*
+	The following defines are the kinds of QUEUE the library
+	can create.  The kind is stored in the Type member of a 
+	QUEUE whenever more than one kind is enabled in QueueConfig.h.
+*/
+#define QUEUE_TYPE_LINKED								0
+#define QUEUE_TYPE_RING									1
+#define QUEUE_TYPE_INTRUSIVE							2
+#define QUEUE_TYPE_COPY									3
+#define QUEUE_TYPE_PRIORITY								4
+#define QUEUE_TYPE_TIMER								5
+
+/*
+	The following defines are what a bounded QUEUE does with
+	data added while it is at its limit.  REJECT fails the add,
+	BLOCK waits for room, DROP_OLDEST frees the data at the
+	front to make room and DROP_NEWEST frees the new data.
+*/
+#define QUEUE_OVERFLOW_REJECT							0
+#define QUEUE_OVERFLOW_BLOCK							1
+#define QUEUE_OVERFLOW_DROP_OLDEST						2
+#define QUEUE_OVERFLOW_DROP_NEWEST						3
+
+#if (USING_QUEUE_INTRUSIVE == 1 && USING_QUEUE_SEGMENTED_NODES == 1)
+	#error "An intrusive QUEUE needs one piece of data per QUEUE_NODE, disable USING_QUEUE_SEGMENTED_NODES."
+#endif // end of USING_QUEUE_INTRUSIVE
+
+#if (USING_QUEUE_COPY == 1 && USING_QUEUE_SEGMENTED_NODES == 1)
+	#error "A copy QUEUE stores one element behind each QUEUE_NODE, disable USING_QUEUE_SEGMENTED_NODES."
+#endif // end of USING_QUEUE_COPY
+
+#if (USING_QUEUE_DEFERRED_CLEAR == 1 && (USING_QUEUE_CLEAR_METHOD == 0 || USING_QUEUE_BLOCKING_METHODS == 0))
+	#error "The reclaimer thread frees data like QueueClear() and waits on a blocking QUEUE, enable USING_QUEUE_CLEAR_METHOD and USING_QUEUE_BLOCKING_METHODS."
+#endif // end of USING_QUEUE_DEFERRED_CLEAR
+
+#if (USING_QUEUE_TIMER == 1 && !defined(QueueGetTickCount))
+	#error "A timer QUEUE measures its deadlines with QueueGetTickCount(), define it in QueueConfig.h."
+#endif // end of USING_QUEUE_TIMER
+
+#if (USING_QUEUE_RING_BUFFER == 1 || USING_QUEUE_INTRUSIVE == 1 || USING_QUEUE_COPY == 1 || USING_QUEUE_PRIORITY == 1 || USING_QUEUE_TIMER == 1)
+	#define USING_QUEUE_TYPES							1
+#else
+	#define USING_QUEUE_TYPES							0
+#endif // end of USING_QUEUE_RING_BUFFER || USING_QUEUE_INTRUSIVE || USING_QUEUE_COPY || USING_QUEUE_PRIORITY || USING_QUEUE_TIMER
+
+#if (USING_QUEUE_PRIORITY == 1)
+	/*
+		The following struct is one entry of the heap of a
+		priority QUEUE.  Sequence is the order the data was 
+		added in, which keeps equal priorities first in first out.
+	*/
+	struct _QueuePriorityEntry
+	{
+		/**
+		* The priority the data was added with, higher is removed first.
+		*/
+		UINT32 Priority;
+
+		/**
+		* The number of pieces of data added to the QUEUE before this one.
+		*/
+		UINT32 Sequence;
+
+		/**
+		* The data stored in the entry.
+		*/
+		void *Data;
+	};
+
+	typedef struct _QueuePriorityEntry QUEUE_PRIORITY_ENTRY;
+#endif // end of USING_QUEUE_PRIORITY
+
+#if (USING_QUEUE_TIMER == 1)
+	/*
+		The following defines are the shape of the timing wheel
+		of a timer QUEUE.  Every level has 64 slots, each slot of a
+		level spans all 64 slots of the level below it, and six
+		levels cover every 32 bit deadline.
+	*/
+	#define QUEUE_TIMER_LEVELS							6
+	#define QUEUE_TIMER_SLOT_BITS						6
+	#define QUEUE_TIMER_SLOTS							(1 << QUEUE_TIMER_SLOT_BITS)
+
+	/*
+		The following struct holds one piece of data of a timer
+		QUEUE until its deadline.
+	*/
+	struct _QueueTimer
+	{
+		struct _QueueTimer *Next;
+		void *Data;
+		UINT32 Deadline;
+	};
+
+	typedef struct _QueueTimer QUEUE_TIMER;
+
+	/*
+		The following struct is the timing wheel of a timer QUEUE.
+		A timer sits at the lowest level whose slots still tell its 
+		deadline apart from Current, and moves down a level whenever
+		Current enters its slot, until it reaches level 0 and is due.
+	*/
+	struct _QueueTimerWheel
+	{
+		QUEUE_TIMER *Slots[QUEUE_TIMER_LEVELS][QUEUE_TIMER_SLOTS];
+
+		/**
+		* Expired timers, kept for the next QueueAddAt().
+		*/
+		QUEUE_TIMER *FreeList;
+
+		/**
+		* The QueueGetTickCount() the wheel has been turned to.
+		*/
+		UINT32 Current;
+
+		/**
+		* The number of timers on the wheel.
+		*/
+		UINT32 Pending;
+	};
+
+	typedef struct _QueueTimerWheel QUEUE_TIMER_WHEEL;
+#endif // end of USING_QUEUE_TIMER
+
 /*
 	The following struct is the Queue Head itself.
 	There is only one of these per Queue, and it points
@@ -64,8 +440,707 @@ struct _Queue
 	#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
 		void (*QueueFreeMethod)(void *Data);
 	#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+	#if (USING_QUEUE_TYPES == 1)
+		/**
+		* The kind of QUEUE, one of the QUEUE_TYPE_* defines.
+		*/
+		BYTE Type;
+	#endif // end of USING_QUEUE_TYPES
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		/**
+		* The array holding the data of a ring QUEUE.  Unused by any other kind of QUEUE.
+		*/
+		void **Buffer;
+
+		/**
+		* The number of elements in Buffer minus one.  Indexes wrap by masking with this.
+		*/
+		UINT32 Mask;
+
+		/**
+		* The index in Buffer of the next piece of data to be removed.
+		*/
+		UINT32 First;
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		/**
+		* The offset in bytes of the QUEUE_NODE embedded in each piece of data
+		of an intrusive QUEUE.
+		*/
+		UINT32 NodeOffset;
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_COPY == 1)
+		/**
+		* The size in bytes of each element copied into a copy QUEUE.
+		*/
+		UINT32 ElementSize;
+	#endif // end of USING_QUEUE_COPY
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		/**
+		* The heap of a priority QUEUE, the entry at index 0 is removed next.
+		*/
+		QUEUE_PRIORITY_ENTRY *Heap;
+
+		/**
+		* The number of entries Heap has room for.
+		*/
+		UINT32 Capacity;
+
+		/**
+		* The Sequence the next entry added to Heap will get.
+		*/
+		UINT32 Sequence;
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_TIMER == 1)
+		/**
+		* The data of a timer QUEUE which isn't due yet.  The due data is
+		in the QUEUE_NODE's like in any linked QUEUE.
+		*/
+		QUEUE_TIMER_WHEEL *Wheel;
+	#endif // end of USING_QUEUE_TIMER
+
+	#if (USING_QUEUE_BOUNDED == 1)
+		/**
+		* The most pieces of data the QUEUE holds, 0 for no limit.
+		*/
+		UINT32 Limit;
+
+		/**
+		* The number of pieces of data freed by the overflow policy.
+		*/
+		UINT32 Dropped;
+
+		/**
+		* What happens at the limit, one of the QUEUE_OVERFLOW_* defines.
+		*/
+		BYTE Policy;
+	#endif // end of USING_QUEUE_BOUNDED
+
+	#if (USING_QUEUE_STATISTICS == 1)
+		/**
+		* The statistics of the QUEUE, see QueueGetStats().
+		*/
+		QUEUE_STATS Stats;
+
+		#if (USING_QUEUE_WAIT_TIME_STATISTICS == 1)
+			/**
+			* The QueueGetTickCount() at which the timed piece of data was added.
+			*/
+			UINT32 SampleTime;
+
+			/**
+			* How many pieces of data had to leave, counted in Dequeues and
+			Cleared, before the timed piece of data.
+			*/
+			UINT32 SamplePosition;
+
+			/**
+			* TRUE while a piece of data is being timed.
+			*/
+			BOOL Sampling;
+		#endif // end of USING_QUEUE_WAIT_TIME_STATISTICS
+	#endif // end of USING_QUEUE_STATISTICS
+
+	#if (USING_QUEUE_BLOCKING_METHODS == 1)
+		/**
+		* The lock taken by every method that reads or changes the QUEUE.
+		*/
+		QUEUE_LOCK Lock;
+
+		/**
+		* Signaled when data is added while a thread waits in QueueRemoveWait().
+		*/
+		QUEUE_CONDITION NotEmpty;
+
+		/**
+		* Signaled when data is removed while a thread waits in QueueAddWait().
+		*/
+		QUEUE_CONDITION NotFull;
+
+		/**
+		* The number of threads waiting on NotEmpty.
+		*/
+		UINT32 EmptyWaiters;
+
+		/**
+		* The number of threads waiting on NotFull.
+		*/
+		UINT32 FullWaiters;
+
+		#if (USING_QUEUE_BOUNDED == 1)
+			/**
+			* How many of FullWaiters wait in QueueAddBatch() for room for
+			* more than one piece of data.
+			*/
+			UINT32 BatchWaiters;
+		#endif // end of USING_QUEUE_BOUNDED
+
+		/**
+		* TRUE once QueueClose() was called.
+		*/
+		BOOL Closed;
+	#endif // end of USING_QUEUE_BLOCKING_METHODS
+
+	#if (USING_QUEUE_EVENT_FD == 1)
+		/**
+		* The event file descriptor of QueueOpenEventFd(), or -1.
+		*/
+		int EventFd;
+
+		/**
+		* TRUE while EventFd is readable.  Only a remove which finds the 
+		QUEUE empty clears it again, so adding to a QUEUE a consumer hasn't
+		drained yet costs no system call.
+		*/
+		BOOL EventSignaled;
+	#endif // end of USING_QUEUE_EVENT_FD
 };
 
 typedef struct _Queue QUEUE;
 
+#if (USING_QUEUE_EVENT_FD == 1 && (USE_PTHREADS == 0 || !defined(QueueEventCreate)))
+	#error "USING_QUEUE_EVENT_FD needs USE_PTHREADS and the QueueEvent methods in QueueConfig.h."
+#endif // end of USING_QUEUE_EVENT_FD
+
+#if (USING_QUEUE_SPSC == 1)
+	/*
+		The following struct is a single producer, single
+		consumer QUEUE.  The members written by the producer
+		and the members written by the consumer are kept a
+		cache line apart so the two threads never share a line
+		on the fast path.
+	*/
+	struct _SpscQueue
+	{
+		/**
+		* The array holding the data of the QUEUE.  Never changes after creation.
+		*/
+		void **Buffer;
+
+		/**
+		* The number of elements in Buffer minus one.
+		*/
+		UINT32 Mask;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			void (*QueueFreeMethod)(void *Data);
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		BYTE SharedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The number of pieces of data ever added.  Only written by the producer.
+		*/
+		UINT32 Tail;
+
+		/**
+		* The producer's last seen copy of Head.
+		*/
+		UINT32 CachedHead;
+
+		BYTE ProducerPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The number of pieces of data ever removed.  Only written by the consumer.
+		*/
+		UINT32 Head;
+
+		/**
+		* The consumer's last seen copy of Tail.
+		*/
+		UINT32 CachedTail;
+
+		BYTE ConsumerPadding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _SpscQueue SPSC_QUEUE;
+#endif // end of USING_QUEUE_SPSC
+
+#if (USING_QUEUE_RECORD == 1)
+	/*
+		The following defines describe the records of a RECORD_QUEUE.
+		Each record starts with its length in a header, and every 
+		record's bytes start QUEUE_RECORD_ALIGNMENT aligned.  A header
+		holding QUEUE_RECORD_PADDING fills the end of the buffer when
+		the next record doesn't fit there, so no record ever wraps.
+	*/
+	#define QUEUE_RECORD_ALIGNMENT						8
+	#define QUEUE_RECORD_HEADER_SIZE					QUEUE_RECORD_ALIGNMENT
+	#define QUEUE_RECORD_PADDING						0xFFFFFFFF
+
+	/*
+		The following struct is a single producer, single
+		consumer QUEUE of byte records.  Like the SPSC_QUEUE the
+		members each side writes are kept a cache line apart.
+	*/
+	struct _RecordQueue
+	{
+		/**
+		* The bytes of the records.  Never changes after creation.
+		*/
+		BYTE *Buffer;
+
+		/**
+		* The number of bytes in Buffer minus one.
+		*/
+		UINT32 Mask;
+
+		BYTE SharedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The number of bytes ever committed, padding included.  Only written by the producer.
+		*/
+		UINT32 Tail;
+
+		/**
+		* The producer's last seen copy of Head.
+		*/
+		UINT32 CachedHead;
+
+		/**
+		* The bytes taken by the record being written, 0 if none was reserved.
+		*/
+		UINT32 Reserved;
+
+		/**
+		* The number of records ever committed.
+		*/
+		UINT32 Committed;
+
+		BYTE ProducerPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The number of bytes ever released, padding included.  Only written by the consumer.
+		*/
+		UINT32 Head;
+
+		/**
+		* The consumer's last seen copy of Tail.
+		*/
+		UINT32 CachedTail;
+
+		/**
+		* The number of records ever released.
+		*/
+		UINT32 Released;
+
+		BYTE ConsumerPadding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _RecordQueue RECORD_QUEUE;
+#endif // end of USING_QUEUE_RECORD
+
+#if (USING_QUEUE_MPMC == 1)
+	/*
+		The following struct is one slot of an MPMC_QUEUE.
+		Sequence tells the producers and consumers whose turn
+		it is to use the slot.
+	*/
+	struct _MpmcQueueCell
+	{
+		/**
+		* Equal to the position of the slot when it is free for a producer,
+		and to the position plus one when it holds data for a consumer.
+		*/
+		UINT32 Sequence;
+
+		/**
+		* The data stored in the slot.
+		*/
+		void *Data;
+	};
+
+	typedef struct _MpmcQueueCell MPMC_QUEUE_CELL;
+
+	/*
+		The following struct is a multi producer, multi 
+		consumer QUEUE.  Producers claim a slot by advancing
+		EnqueuePos and consumers by advancing DequeuePos, each
+		with a single compare and exchange.  The slots are 
+		never freed while the QUEUE is in use, so no thread
+		can ever read memory that was handed back.
+	*/
+	struct _MpmcQueue
+	{
+		/**
+		* The slots of the QUEUE.  Never changes after creation.
+		*/
+		MPMC_QUEUE_CELL *Buffer;
+
+		/**
+		* The number of slots in Buffer minus one.
+		*/
+		UINT32 Mask;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			void (*QueueFreeMethod)(void *Data);
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		BYTE SharedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position the next producer will claim.
+		*/
+		UINT32 EnqueuePos;
+
+		BYTE ProducerPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position the next consumer will claim.
+		*/
+		UINT32 DequeuePos;
+
+		BYTE ConsumerPadding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _MpmcQueue MPMC_QUEUE;
+#endif // end of USING_QUEUE_MPMC
+
+#if (USING_QUEUE_WORK_STEALING == 1)
+	/*
+		The following struct is the array of a WS_DEQUE.  When
+		it fills up it is replaced by one twice its size, but a
+		thief may still be reading the old one, so it is kept 
+		through Previous until the WS_DEQUE is destroyed.
+	*/
+	struct _WsDequeBuffer
+	{
+		/**
+		* The number of elements in Data minus one.
+		*/
+		UINT32 Mask;
+
+		/**
+		* The smaller array this one replaced.
+		*/
+		struct _WsDequeBuffer *Previous;
+
+		/**
+		* The data, allocated to Mask + 1 elements.
+		*/
+		void *Data[1];
+	};
+
+	typedef struct _WsDequeBuffer WS_DEQUE_BUFFER;
+
+	/*
+		The following struct is a Chase-Lev work stealing deque.
+		The owner adds and removes at Bottom, thieves take from 
+		Top.  Both only ever move forward.
+	*/
+	struct _WsDeque
+	{
+		/**
+		* The current array.  Only replaced by the owner.
+		*/
+		WS_DEQUE_BUFFER *Buffer;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			void (*QueueFreeMethod)(void *Data);
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+
+		BYTE SharedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position of the oldest data, advanced by thieves and by
+		the owner taking the last piece of data.
+		*/
+		UINT32 Top;
+
+		BYTE ThiefPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position one past the newest data.  Only written by the owner.
+		*/
+		UINT32 Bottom;
+
+		BYTE OwnerPadding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _WsDeque WS_DEQUE;
+#endif // end of USING_QUEUE_WORK_STEALING
+
+#if (USING_QUEUE_PERSISTENT == 1 && USE_PTHREADS == 0)
+	#error "A PERSISTENT_QUEUE maps its segment files with POSIX mmap(), enable USE_PTHREADS."
+#endif // end of USING_QUEUE_PERSISTENT
+
+#if (USING_QUEUE_PERSISTENT == 1)
+	/*
+		The following struct is the checkpoint of a PERSISTENT_QUEUE.
+		It is written to a new file which then replaces the old one,
+		so a crash always leaves one whole checkpoint behind.
+	*/
+	struct _PersistentQueueCheckpoint
+	{
+		UINT32 Magic;
+		UINT32 HeadSegment;
+		UINT32 HeadOffset;
+		UINT32 TailSegment;
+		UINT32 TailOffset;
+		UINT32 Size;
+
+		/**
+		* The check over every field above.
+		*/
+		UINT32 Check;
+	};
+
+	typedef struct _PersistentQueueCheckpoint PERSISTENT_QUEUE_CHECKPOINT;
+
+	/*
+		The following struct is a queue of records kept in numbered
+		segment files.  Records are appended at the tail segment and
+		read in place from the head segment, each one mapped on its own.
+	*/
+	struct _PersistentQueue
+	{
+		/**
+		* The directory holding the segment files and the checkpoint.
+		*/
+		char Path[QUEUE_PERSISTENT_MAX_PATH];
+
+		/**
+		* The directory opened for fsync(), so renames are durable.
+		*/
+		int Directory;
+
+		BYTE *HeadMap;
+		UINT32 HeadSegment;
+		UINT32 HeadOffset;
+
+		/**
+		* The oldest segment the head left which is not retired yet.
+		*/
+		UINT32 RetireSegment;
+
+		BYTE *TailMap;
+		UINT32 TailSegment;
+		UINT32 TailOffset;
+
+		/**
+		* How much of the tail segment is known to be on disk.
+		*/
+		UINT32 SyncedOffset;
+
+		/**
+		* The number of records between the head and the tail.
+		*/
+		UINT32 Size;
+
+		/**
+		* Sync after this many adds and removes, 0 to never sync by count.
+		*/
+		UINT32 SyncRecords;
+
+		/**
+		* Sync once this many milliseconds passed, 0 to never sync by time.
+		*/
+		UINT32 SyncInterval;
+
+		UINT32 Unsynced;
+		UINT32 LastSync;
+
+		QUEUE_LOCK Lock;
+	};
+
+	typedef struct _PersistentQueue PERSISTENT_QUEUE;
+#endif // end of USING_QUEUE_PERSISTENT
+
+#if (USING_QUEUE_SHARED == 1 && (USE_PTHREADS == 0 || !defined(QueueFutexWait)))
+	#error "A SHARED_QUEUE needs USE_PTHREADS and QueueFutexWait() and QueueFutexWake() in QueueConfig.h."
+#endif // end of USING_QUEUE_SHARED
+
+#if (USING_QUEUE_SHARED == 1)
+	/*
+		The following struct starts the shared memory of a 
+		SHARED_QUEUE, its slots follow it.  Everything in it is 
+		an index or a size, never a pointer, since every process
+		maps it at a different address.
+	*/
+	struct _SharedQueueHeader
+	{
+		/**
+		* Set last by the creator, once everything else is ready.
+		*/
+		UINT32 Magic;
+
+		/**
+		* The number of slots minus one.
+		*/
+		UINT32 Mask;
+
+		/**
+		* The most bytes one slot can hold.
+		*/
+		UINT32 SlotSize;
+
+		/**
+		* The distance in bytes from one slot to the next.
+		*/
+		UINT32 Stride;
+
+		BYTE SharedPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position the next producer will claim.
+		*/
+		UINT32 EnqueuePos;
+
+		BYTE ProducerPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* The position the next consumer will claim.
+		*/
+		UINT32 DequeuePos;
+
+		BYTE ConsumerPadding[QUEUE_CACHE_LINE_SIZE];
+
+		/**
+		* Futex words, bumped whenever a slot is filled or freed while
+		someone is waiting, and the number of processes waiting on each.
+		*/
+		UINT32 NotEmpty;
+		UINT32 EmptyWaiters;
+		UINT32 NotFull;
+		UINT32 FullWaiters;
+
+		BYTE WaiterPadding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _SharedQueueHeader SHARED_QUEUE_HEADER;
+
+	/*
+		The following struct starts each slot of a SHARED_QUEUE,
+		the message is stored right behind it.  Sequence works
+		exactly like the Sequence of an MPMC_QUEUE_CELL.
+	*/
+	struct _SharedQueueSlot
+	{
+		UINT32 Sequence;
+
+		/**
+		* The size in bytes of the message in the slot.
+		*/
+		UINT32 Length;
+	};
+
+	typedef struct _SharedQueueSlot SHARED_QUEUE_SLOT;
+
+	/*
+		The following struct is one process's view of a SHARED_QUEUE.
+		It is never shared itself.
+	*/
+	struct _SharedQueue
+	{
+		SHARED_QUEUE_HEADER *Header;
+
+		/**
+		* The first slot, inside the same mapping as Header.
+		*/
+		BYTE *Slots;
+
+		/**
+		* Copies of the header's sizes, which never change.
+		*/
+		UINT32 Mask;
+		UINT32 SlotSize;
+		UINT32 Stride;
+
+		/**
+		* The size in bytes of the mapping.
+		*/
+		UINT32 Bytes;
+
+		/**
+		* TRUE for the process which created the SHARED_QUEUE, it removes
+		the name again when it destroys it.
+		*/
+		BOOL Owner;
+
+		char Name[QUEUE_SHARED_MAX_NAME];
+	};
+
+	typedef struct _SharedQueue SHARED_QUEUE;
+#endif // end of USING_QUEUE_SHARED
+
+#if (USING_QUEUE_MULTI == 1 && USE_PTHREADS == 0)
+	#error "A MULTI_QUEUE needs QueueTryLock(), QUEUE_THREAD_LOCAL and QueueGetTimestamp(), enable USE_PTHREADS."
+#endif // end of USING_QUEUE_MULTI
+
+#if (USING_QUEUE_MULTI == 1)
+	/*
+		The Oldest stamp of a shard with nothing in it, later
+		than any real stamp so an empty shard is never picked.
+	*/
+	#define QUEUE_MULTI_EMPTY							(~(UINT64)0)
+
+	/*
+		The following struct is one piece of data in a shard
+		of a MULTI_QUEUE, along with when it was added.
+	*/
+	struct _MultiQueueEntry
+	{
+		void *Data;
+		UINT64 Stamp;
+	};
+
+	typedef struct _MultiQueueEntry MULTI_QUEUE_ENTRY;
+
+	/*
+		The following struct is one shard of a MULTI_QUEUE, a 
+		growable ring of entries behind its own lock.  Size and
+		Oldest are also read without the lock to choose a shard,
+		so outside of the lock they are only a hint.
+	*/
+	struct _MultiQueueShard
+	{
+		QUEUE_LOCK Lock;
+
+		/**
+		* The ring, Mask + 1 entries.
+		*/
+		MULTI_QUEUE_ENTRY *Entries;
+
+		UINT32 Mask;
+		UINT32 First;
+		UINT32 Size;
+
+		/**
+		* The stamp of the front entry, QUEUE_MULTI_EMPTY when there is none.
+		*/
+		UINT64 Oldest;
+
+		BYTE Padding[QUEUE_CACHE_LINE_SIZE];
+	};
+
+	typedef struct _MultiQueueShard MULTI_QUEUE_SHARD;
+
+	/*
+		The following struct is a relaxed first in, first out
+		QUEUE made of Count shards.  Each thread adds to a shard
+		of its own and removes from the older of two random ones.
+	*/
+	struct _MultiQueue
+	{
+		/**
+		* The shards.  Never changes after creation.
+		*/
+		MULTI_QUEUE_SHARD *Shards;
+
+		UINT32 Count;
+
+		#if(USING_QUEUE_DEPENDENT_FREE_METHOD == 1)
+			void (*QueueFreeMethod)(void *Data);
+		#endif // end of USING_QUEUE_DEPENDENT_FREE_METHOD
+	};
+
+	typedef struct _MultiQueue MULTI_QUEUE;
+#endif // end of USING_QUEUE_MULTI
+
 #endif // end of QUEUE_OBJECT_H
@@ -0,0 +1,1109 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueBench.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Measures the Queue library in the configuration it was compiled
+	with.  Every run prints one line with the operations per second,
+	the 50th, 99th and 99.9th percentile latency in nanoseconds and the
+	QueueMemAlloc() and QueueMemDealloc() calls per operation taken from
+	QueueGetAllocationStats(), as CSV or as JSON lines.
+
+	Workloads:
+		pingpong - Two threads bounce one piece of data back and forth
+		through two QUEUE's, the latency is the round trip.
+		burst - One thread fills a QUEUE with a burst and drains it
+		again, the latency is that of a single add or remove.
+		prodcons - 1 to N producers and 1 to N consumers share one
+		QUEUE, the latency is the time the data spent inside it.
+		steal - One owner thread adds every task and runs its own
+		while 0 to N-1 thieves take tasks from it, the latency is the
+		time a task waited to run.
+
+	Backends:
+		queue - The linked QUEUE, locked by USING_QUEUE_BLOCKING_METHODS.
+		ring - The QUEUE from CreateRingQueue().
+		priority - The QUEUE from CreatePriorityQueue(), every piece of
+		data added with the same priority.
+		copy - The QUEUE from CreateCopyQueue(), storing the data by value.
+		intrusive - The QUEUE from CreateIntrusiveQueue(), its items are
+		taken from and given back to a second intrusive QUEUE.
+		spsc - The SPSC_QUEUE, only run with one producer and one consumer.
+		record - The RECORD_QUEUE, only run with one producer and one
+		consumer.
+		mpmc - The MPMC_QUEUE.
+		multi - The MULTI_QUEUE.
+		wsdeque - The WS_DEQUE, only run by burst and steal.
+
+	Usage: QueueBench [-w workload|all] [-b backend|all] [-n ops]
+	[-t threads] [-f csv|json]
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "QueueConfig.h"
+#include "Queue.h"
+
+#if (USE_PTHREADS == 0 || USING_QUEUE_BLOCKING_METHODS == 0 || USING_QUEUE_ALLOCATION_COUNTERS == 0)
+	#error "QueueBench shares QUEUE's between threads and counts allocations, enable USE_PTHREADS, USING_QUEUE_BLOCKING_METHODS and USING_QUEUE_ALLOCATION_COUNTERS."
+#endif // end of USE_PTHREADS || USING_QUEUE_BLOCKING_METHODS || USING_QUEUE_ALLOCATION_COUNTERS
+
+/*
+	The capacity given to QUEUE's that have one, and the number of
+	pieces of data in one burst of the burst workload.
+*/
+#define BENCH_CAPACITY									4096
+#define BENCH_BURST										1024
+
+/*
+	No run keeps more latency samples than this, longer runs sample
+	every so many operations instead.
+*/
+#define BENCH_MAX_SAMPLES								(1 << 20)
+
+/*
+	Tells a consumer that every producer is done.  Timestamps are
+	never this small, so it can't be mistaken for one.
+*/
+#define BENCH_STOP										((void*)1)
+
+/*
+	The loop iterations one task of the steal workload runs for.
+*/
+#define BENCH_TASK_WORK									256
+
+/*
+	The name of the node allocation strategy compiled in, printed
+	with every run so the output of several builds can be compared.
+*/
+#if (USING_QUEUE_NODE_CACHE == 1)
+	#define BENCH_CONFIG								"cache"
+#else
+	#if (USING_QUEUE_NODE_POOL == 1)
+		#define BENCH_CONFIG							"pool"
+	#else
+		#if (USING_QUEUE_SEGMENTED_NODES == 1)
+			#define BENCH_CONFIG						"segmented"
+		#else
+			#define BENCH_CONFIG						"malloc"
+		#endif // end of USING_QUEUE_SEGMENTED_NODES
+	#endif // end of USING_QUEUE_NODE_POOL
+#endif // end of USING_QUEUE_NODE_CACHE
+
+/*
+	One kind of QUEUE as the workloads see it.  Add() returns FALSE
+	and Remove() NULL when the QUEUE is full or empty, the workloads
+	yield and try again.
+*/
+typedef struct
+{
+	const char *Name;
+
+	/*
+		FALSE if only one producer and one consumer may use it.
+	*/
+	BOOL Shared;
+
+	/*
+		TRUE if only the thread that adds may call Remove(), other
+		threads have to call Steal().
+	*/
+	BOOL Owned;
+
+	void *(*Create)(void);
+	void (*Destroy)(void *Queue);
+	BOOL (*Add)(void *Queue, const void *Data);
+	void *(*Remove)(void *Queue);
+
+	/*
+		Takes the oldest data from any thread, (void*(*)(void*))NULL if 
+		the steal workload can't run on it.
+	*/
+	void *(*Steal)(void *Queue);
+}BENCH_BACKEND;
+
+/*
+	The latencies one thread recorded, every Stride'th operation.
+*/
+typedef struct
+{
+	UINT64 *Samples;
+	UINT32 Count;
+	UINT32 Capacity;
+	UINT32 Stride;
+	UINT32 Skipped;
+}BENCH_SAMPLES;
+
+/*
+	What a thread of a run needs, filled in by the run.
+*/
+typedef struct
+{
+	const BENCH_BACKEND *Backend;
+	void *Queue;
+	void *Reply;
+	UINT64 Ops;
+	BENCH_SAMPLES Samples;
+}BENCH_THREAD;
+
+static const char *BenchFormat = "csv";
+static volatile BOOL BenchGo;
+static UINT64 BenchTasksDone;
+
+static UINT64 BenchNow(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (UINT64)Now.tv_sec * (UINT64)1000000000 + (UINT64)Now.tv_nsec;
+}
+
+static void *BenchAlloc(size_t Size)
+{
+	void *Mem;
+
+	if((Mem = calloc(1, Size)) == NULL)
+	{
+		fprintf(stderr, "QueueBench: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return Mem;
+}
+
+/*
+	The locked linked QUEUE of the QueueConfig.h in use.
+*/
+static void *BenchQueueCreate(void)
+{
+	return (void*)CreateQueue((QUEUE*)NULL, (void(*)(void*))NULL);
+}
+
+static void BenchQueueDestroy(void *Queue)
+{
+	// Every workload leaves the QUEUE empty.
+	QueueMemDealloc(Queue);
+}
+
+static BOOL BenchQueueAdd(void *Queue, const void *Data)
+{
+	return QueueAdd((QUEUE*)Queue, Data);
+}
+
+static void *BenchQueueRemove(void *Queue)
+{
+	return QueueRemove((QUEUE*)Queue);
+}
+
+#if (USING_QUEUE_RING_BUFFER == 1)
+	static void *BenchRingCreate(void)
+	{
+		return (void*)CreateRingQueue((QUEUE*)NULL, (UINT32)BENCH_CAPACITY, (void(*)(void*))NULL);
+	}
+
+	static void BenchRingDestroy(void *Queue)
+	{
+		DestroyRingQueue((QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+#endif // end of USING_QUEUE_RING_BUFFER
+
+#if (USING_QUEUE_PRIORITY == 1)
+	/*
+		Every piece of data goes in with priority 0, so the heap hands
+		it back first in, first out.
+	*/
+	static void *BenchPriorityCreate(void)
+	{
+		return (void*)CreatePriorityQueue((QUEUE*)NULL, (UINT32)BENCH_CAPACITY, (void(*)(void*))NULL);
+	}
+
+	static void BenchPriorityDestroy(void *Queue)
+	{
+		DestroyPriorityQueue((QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+#endif // end of USING_QUEUE_PRIORITY
+
+#if (USING_QUEUE_COPY == 1)
+	static void *BenchCopyCreate(void)
+	{
+		return (void*)CreateCopyQueue((QUEUE*)NULL, (UINT32)sizeof(void*), (void(*)(void*))NULL);
+	}
+
+	static BOOL BenchCopyAdd(void *Queue, const void *Data)
+	{
+		return QueueAddCopy((QUEUE*)Queue, (const void*)&Data);
+	}
+
+	static void *BenchCopyRemove(void *Queue)
+	{
+		void *Data;
+
+		return QueueRemoveInto((QUEUE*)Queue, (void*)&Data) ? Data : NULL;
+	}
+#endif // end of USING_QUEUE_COPY
+
+#if (USING_QUEUE_INTRUSIVE == 1)
+	typedef struct
+	{
+		QUEUE_NODE Link;
+		void *Data;
+	}BENCH_ITEM;
+
+	/*
+		The items not in Queue wait in Free, so neither adding nor
+		removing allocates and Add() fails once all of them are in use.
+	*/
+	typedef struct
+	{
+		QUEUE Queue;
+		QUEUE Free;
+		BENCH_ITEM Items[BENCH_CAPACITY];
+	}BENCH_INTRUSIVE;
+
+	static void *BenchIntrusiveCreate(void)
+	{
+		BENCH_INTRUSIVE *Bench;
+		UINT32 i;
+
+		Bench = (BENCH_INTRUSIVE*)BenchAlloc(sizeof(BENCH_INTRUSIVE));
+
+		CreateIntrusiveQueue(&(Bench->Queue), QueueGetNodeOffset(BENCH_ITEM, Link), (void(*)(void*))NULL);
+		CreateIntrusiveQueue(&(Bench->Free), QueueGetNodeOffset(BENCH_ITEM, Link), (void(*)(void*))NULL);
+
+		for(i = (UINT32)0; i < (UINT32)BENCH_CAPACITY; i++)
+			QueueAdd(&(Bench->Free), (const void*)&(Bench->Items[i]));
+
+		return (void*)Bench;
+	}
+
+	static void BenchIntrusiveDestroy(void *Queue)
+	{
+		free(Queue);
+	}
+
+	static BOOL BenchIntrusiveAdd(void *Queue, const void *Data)
+	{
+		BENCH_INTRUSIVE *Bench;
+		BENCH_ITEM *Item;
+
+		Bench = (BENCH_INTRUSIVE*)Queue;
+
+		if((Item = (BENCH_ITEM*)QueueRemove(&(Bench->Free))) == NULL)
+			return (BOOL)FALSE;
+
+		Item->Data = (void*)Data;
+
+		return QueueAdd(&(Bench->Queue), (const void*)Item);
+	}
+
+	static void *BenchIntrusiveRemove(void *Queue)
+	{
+		BENCH_INTRUSIVE *Bench;
+		BENCH_ITEM *Item;
+		void *Data;
+
+		Bench = (BENCH_INTRUSIVE*)Queue;
+
+		if((Item = (BENCH_ITEM*)QueueRemove(&(Bench->Queue))) == NULL)
+			return NULL;
+
+		Data = Item->Data;
+
+		QueueAdd(&(Bench->Free), (const void*)Item);
+
+		return Data;
+	}
+#endif // end of USING_QUEUE_INTRUSIVE
+
+#if (USING_QUEUE_SPSC == 1)
+	/*
+		The lock free SPSC_QUEUE, only run with one producer and one
+		consumer so it can be compared against the locked QUEUE.
+	*/
+	static void *BenchSpscCreate(void)
+	{
+		return (void*)CreateSpscQueue((SPSC_QUEUE*)NULL, (UINT32)BENCH_CAPACITY, (void(*)(void*))NULL);
+	}
+
+	static void BenchSpscDestroy(void *Queue)
+	{
+		DestroySpscQueue((SPSC_QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+
+	static BOOL BenchSpscAdd(void *Queue, const void *Data)
+	{
+		return SpscQueueAdd((SPSC_QUEUE*)Queue, Data);
+	}
+
+	static void *BenchSpscRemove(void *Queue)
+	{
+		return SpscQueueRemove((SPSC_QUEUE*)Queue);
+	}
+#endif // end of USING_QUEUE_SPSC
+
+#if (USING_QUEUE_RECORD == 1)
+	/*
+		Each piece of data is one record the size of a pointer.
+	*/
+	static void *BenchRecordCreate(void)
+	{
+		return (void*)CreateRecordQueue((RECORD_QUEUE*)NULL, (UINT32)(BENCH_CAPACITY * (QUEUE_RECORD_HEADER_SIZE + sizeof(void*))));
+	}
+
+	static void BenchRecordDestroy(void *Queue)
+	{
+		DestroyRecordQueue((RECORD_QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+
+	static BOOL BenchRecordAdd(void *Queue, const void *Data)
+	{
+		void *Record;
+
+		if((Record = RecordQueueReserve((RECORD_QUEUE*)Queue, (UINT32)sizeof(void*))) == NULL)
+			return (BOOL)FALSE;
+
+		memcpy(Record, (const void*)&Data, sizeof(void*));
+
+		return RecordQueueCommit((RECORD_QUEUE*)Queue, (UINT32)sizeof(void*));
+	}
+
+	static void *BenchRecordRemove(void *Queue)
+	{
+		void *Record, *Data;
+		UINT32 Length;
+
+		if((Record = RecordQueuePeek((RECORD_QUEUE*)Queue, &Length)) == NULL)
+			return NULL;
+
+		memcpy((void*)&Data, Record, sizeof(void*));
+
+		RecordQueueRelease((RECORD_QUEUE*)Queue);
+
+		return Data;
+	}
+#endif // end of USING_QUEUE_RECORD
+
+#if (USING_QUEUE_MPMC == 1)
+	static void *BenchMpmcCreate(void)
+	{
+		return (void*)CreateMpmcQueue((MPMC_QUEUE*)NULL, (UINT32)BENCH_CAPACITY, (void(*)(void*))NULL);
+	}
+
+	static void BenchMpmcDestroy(void *Queue)
+	{
+		DestroyMpmcQueue((MPMC_QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+
+	static BOOL BenchMpmcAdd(void *Queue, const void *Data)
+	{
+		return MpmcQueueAdd((MPMC_QUEUE*)Queue, Data);
+	}
+
+	static void *BenchMpmcRemove(void *Queue)
+	{
+		return MpmcQueueRemove((MPMC_QUEUE*)Queue);
+	}
+#endif // end of USING_QUEUE_MPMC
+
+#if (USING_QUEUE_MULTI == 1)
+	/*
+		One shard per two online processors, the default.
+	*/
+	static void *BenchMultiCreate(void)
+	{
+		return (void*)CreateMultiQueue((MULTI_QUEUE*)NULL, (UINT32)0, (void(*)(void*))NULL);
+	}
+
+	static void BenchMultiDestroy(void *Queue)
+	{
+		DestroyMultiQueue((MULTI_QUEUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+
+	static BOOL BenchMultiAdd(void *Queue, const void *Data)
+	{
+		return MultiQueueAdd((MULTI_QUEUE*)Queue, Data);
+	}
+
+	static void *BenchMultiRemove(void *Queue)
+	{
+		return MultiQueueRemove((MULTI_QUEUE*)Queue);
+	}
+#endif // end of USING_QUEUE_MULTI
+
+#if (USING_QUEUE_WORK_STEALING == 1)
+	static void *BenchWsDequeCreate(void)
+	{
+		return (void*)CreateWsDeque((WS_DEQUE*)NULL, (UINT32)BENCH_CAPACITY, (void(*)(void*))NULL);
+	}
+
+	static void BenchWsDequeDestroy(void *Queue)
+	{
+		DestroyWsDeque((WS_DEQUE*)Queue);
+		QueueMemDealloc(Queue);
+	}
+
+	static BOOL BenchWsDequePush(void *Queue, const void *Data)
+	{
+		return WsDequePush((WS_DEQUE*)Queue, Data);
+	}
+
+	static void *BenchWsDequePop(void *Queue)
+	{
+		return WsDequePop((WS_DEQUE*)Queue);
+	}
+
+	static void *BenchWsDequeSteal(void *Queue)
+	{
+		return WsDequeSteal((WS_DEQUE*)Queue);
+	}
+#endif // end of USING_QUEUE_WORK_STEALING
+
+static const BENCH_BACKEND BenchBackends[] =
+{
+	{"queue", (BOOL)TRUE, (BOOL)FALSE, BenchQueueCreate, BenchQueueDestroy, BenchQueueAdd, BenchQueueRemove, BenchQueueRemove},
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		{"ring", (BOOL)TRUE, (BOOL)FALSE, BenchRingCreate, BenchRingDestroy, BenchQueueAdd, BenchQueueRemove, BenchQueueRemove},
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_PRIORITY == 1)
+		{"priority", (BOOL)TRUE, (BOOL)FALSE, BenchPriorityCreate, BenchPriorityDestroy, BenchQueueAdd, BenchQueueRemove, BenchQueueRemove},
+	#endif // end of USING_QUEUE_PRIORITY
+
+	#if (USING_QUEUE_COPY == 1)
+		{"copy", (BOOL)TRUE, (BOOL)FALSE, BenchCopyCreate, BenchQueueDestroy, BenchCopyAdd, BenchCopyRemove, BenchCopyRemove},
+	#endif // end of USING_QUEUE_COPY
+
+	#if (USING_QUEUE_INTRUSIVE == 1)
+		{"intrusive", (BOOL)TRUE, (BOOL)FALSE, BenchIntrusiveCreate, BenchIntrusiveDestroy, BenchIntrusiveAdd, BenchIntrusiveRemove, BenchIntrusiveRemove},
+	#endif // end of USING_QUEUE_INTRUSIVE
+
+	#if (USING_QUEUE_SPSC == 1)
+		{"spsc", (BOOL)FALSE, (BOOL)FALSE, BenchSpscCreate, BenchSpscDestroy, BenchSpscAdd, BenchSpscRemove, (void*(*)(void*))NULL},
+	#endif // end of USING_QUEUE_SPSC
+
+	#if (USING_QUEUE_RECORD == 1)
+		{"record", (BOOL)FALSE, (BOOL)FALSE, BenchRecordCreate, BenchRecordDestroy, BenchRecordAdd, BenchRecordRemove, (void*(*)(void*))NULL},
+	#endif // end of USING_QUEUE_RECORD
+
+	#if (USING_QUEUE_MPMC == 1)
+		{"mpmc", (BOOL)TRUE, (BOOL)FALSE, BenchMpmcCreate, BenchMpmcDestroy, BenchMpmcAdd, BenchMpmcRemove, BenchMpmcRemove},
+	#endif // end of USING_QUEUE_MPMC
+
+	#if (USING_QUEUE_MULTI == 1)
+		{"multi", (BOOL)TRUE, (BOOL)FALSE, BenchMultiCreate, BenchMultiDestroy, BenchMultiAdd, BenchMultiRemove, BenchMultiRemove},
+	#endif // end of USING_QUEUE_MULTI
+
+	#if (USING_QUEUE_WORK_STEALING == 1)
+		{"wsdeque", (BOOL)TRUE, (BOOL)TRUE, BenchWsDequeCreate, BenchWsDequeDestroy, BenchWsDequePush, BenchWsDequePop, BenchWsDequeSteal},
+	#endif // end of USING_QUEUE_WORK_STEALING
+};
+
+#define BENCH_BACKENDS									(sizeof(BenchBackends) / sizeof(BenchBackends[0]))
+
+static void BenchSamplesInit(BENCH_SAMPLES *Samples, UINT64 Ops)
+{
+	Samples->Stride = (UINT32)(Ops / (UINT64)BENCH_MAX_SAMPLES + 1);
+	Samples->Capacity = (UINT32)(Ops / (UINT64)Samples->Stride + 1);
+	Samples->Samples = (UINT64*)BenchAlloc((size_t)Samples->Capacity * sizeof(UINT64));
+	Samples->Count = Samples->Skipped = (UINT32)0;
+}
+
+static void BenchSample(BENCH_SAMPLES *Samples, UINT64 Latency)
+{
+	if(++Samples->Skipped < Samples->Stride)
+		return;
+
+	Samples->Skipped = (UINT32)0;
+
+	if(Samples->Count < Samples->Capacity)
+		Samples->Samples[Samples->Count++] = Latency;
+}
+
+static void BenchAddUntilDone(const BENCH_BACKEND *Backend, void *Queue, const void *Data)
+{
+	while(!Backend->Add(Queue, Data))
+		sched_yield();
+}
+
+static void *BenchRemoveUntilDone(const BENCH_BACKEND *Backend, void *Queue)
+{
+	void *Data;
+
+	while((Data = Backend->Remove(Queue)) == NULL)
+		sched_yield();
+
+	return Data;
+}
+
+/*
+	Stamps the data with the time it is added at.
+*/
+static void *BenchStamp(void)
+{
+	UINT64 Now;
+
+	Now = BenchNow();
+
+	return (void*)(size_t)((Now > (UINT64)1) ? Now : (UINT64)2);
+}
+
+static void BenchWaitForGo(void)
+{
+	while(!__atomic_load_n(&BenchGo, __ATOMIC_ACQUIRE))
+		sched_yield();
+}
+
+static int BenchCompare(const void *First, const void *Second)
+{
+	UINT64 A, B;
+
+	A = *(const UINT64*)First;
+	B = *(const UINT64*)Second;
+
+	return (A > B) - (A < B);
+}
+
+static UINT64 BenchPercentile(const UINT64 *Sorted, UINT32 Count, FLOAT64 Percentile)
+{
+	UINT32 Index;
+
+	if(Count == (UINT32)0)
+		return (UINT64)0;
+
+	Index = (UINT32)(Percentile / 100.0 * (FLOAT64)(Count - 1) + 0.5);
+
+	return Sorted[Index];
+}
+
+/*
+	Merges the samples of every thread, sorts them and prints the run.
+*/
+static void BenchReport(const char *Workload, const BENCH_BACKEND *Backend, UINT32 Producers, UINT32 Consumers, UINT64 Ops, UINT64 Elapsed, BENCH_THREAD *Threads, UINT32 ThreadCount, const QUEUE_ALLOCATION_STATS *Before)
+{
+	QUEUE_ALLOCATION_STATS After;
+	UINT64 *All, P50, P99, P999;
+	UINT32 Count, i;
+	FLOAT64 Seconds, Allocs, Frees;
+
+	QueueGetAllocationStats(&After);
+
+	for(Count = (UINT32)0, i = (UINT32)0; i < ThreadCount; i++)
+		Count += Threads[i].Samples.Count;
+
+	All = (UINT64*)BenchAlloc((size_t)(Count + 1) * sizeof(UINT64));
+
+	for(Count = (UINT32)0, i = (UINT32)0; i < ThreadCount; i++)
+	{
+		memcpy(All + Count, Threads[i].Samples.Samples, (size_t)Threads[i].Samples.Count * sizeof(UINT64));
+		Count += Threads[i].Samples.Count;
+
+		free(Threads[i].Samples.Samples);
+	}
+
+	qsort(All, (size_t)Count, sizeof(UINT64), BenchCompare);
+
+	P50 = BenchPercentile(All, Count, 50.0);
+	P99 = BenchPercentile(All, Count, 99.0);
+	P999 = BenchPercentile(All, Count, 99.9);
+
+	free(All);
+
+	Seconds = (FLOAT64)Elapsed / 1e9;
+	Allocs = (FLOAT64)(After.Allocations - Before->Allocations) / (FLOAT64)Ops;
+	Frees = (FLOAT64)(After.Deallocations - Before->Deallocations) / (FLOAT64)Ops;
+
+	if(strcmp(BenchFormat, "json") == 0)
+	{
+		printf("{\"workload\":\"%s\",\"backend\":\"%s\",\"config\":\"%s\",\"producers\":%u,\"consumers\":%u,\"ops\":%llu,"
+			"\"seconds\":%.6f,\"ops_per_sec\":%.0f,\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"allocs_per_op\":%.4f,\"frees_per_op\":%.4f}\n",
+			Workload, Backend->Name, BENCH_CONFIG, Producers, Consumers, Ops, Seconds, (FLOAT64)Ops / Seconds, P50, P99, P999, Allocs, Frees);
+	}
+	else
+	{
+		printf("%s,%s,%s,%u,%u,%llu,%.6f,%.0f,%llu,%llu,%llu,%.4f,%.4f\n",
+			Workload, Backend->Name, BENCH_CONFIG, Producers, Consumers, Ops, Seconds, (FLOAT64)Ops / Seconds, P50, P99, P999, Allocs, Frees);
+	}
+
+	fflush(stdout);
+}
+
+/*
+	Starts Method on Count threads, lets them all go at once and
+	returns how many nanoseconds it took until the last one finished.
+*/
+static UINT64 BenchRunThreads(void *(**Methods)(void*), BENCH_THREAD *Threads, UINT32 Count)
+{
+	pthread_t *Handles;
+	UINT64 Start;
+	UINT32 i;
+
+	Handles = (pthread_t*)BenchAlloc((size_t)Count * sizeof(pthread_t));
+
+	__atomic_store_n(&BenchGo, (BOOL)FALSE, __ATOMIC_RELEASE);
+
+	for(i = (UINT32)0; i < Count; i++)
+	{
+		if(pthread_create(&Handles[i], NULL, Methods[i], &Threads[i]) != 0)
+		{
+			fprintf(stderr, "QueueBench: could not start a thread\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	Start = BenchNow();
+
+	__atomic_store_n(&BenchGo, (BOOL)TRUE, __ATOMIC_RELEASE);
+
+	for(i = (UINT32)0; i < Count; i++)
+		pthread_join(Handles[i], NULL);
+
+	free(Handles);
+
+	return BenchNow() - Start;
+}
+
+static void *BenchPingThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	UINT64 i, Sent;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	for(i = (UINT64)0; i < Thread->Ops; i++)
+	{
+		Sent = BenchNow();
+
+		BenchAddUntilDone(Thread->Backend, Thread->Queue, (const void*)(size_t)Sent);
+		BenchRemoveUntilDone(Thread->Backend, Thread->Reply);
+
+		BenchSample(&(Thread->Samples), BenchNow() - Sent);
+	}
+
+	BenchAddUntilDone(Thread->Backend, Thread->Queue, BENCH_STOP);
+
+	return NULL;
+}
+
+static void *BenchPongThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	void *Data;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	while((Data = BenchRemoveUntilDone(Thread->Backend, Thread->Queue)) != BENCH_STOP)
+		BenchAddUntilDone(Thread->Backend, Thread->Reply, Data);
+
+	return NULL;
+}
+
+static void BenchPingPong(const BENCH_BACKEND *Backend, UINT64 Ops)
+{
+	void *(*Methods[2])(void*);
+	BENCH_THREAD Threads[2];
+	QUEUE_ALLOCATION_STATS Before;
+	void *Queue, *Reply;
+	UINT64 Elapsed;
+
+	Queue = Backend->Create();
+	Reply = Backend->Create();
+
+	memset(Threads, 0, sizeof(Threads));
+
+	Threads[0].Backend = Threads[1].Backend = Backend;
+	Threads[0].Queue = Threads[1].Queue = Queue;
+	Threads[0].Reply = Threads[1].Reply = Reply;
+	Threads[0].Ops = Ops;
+
+	BenchSamplesInit(&(Threads[0].Samples), Ops);
+	BenchSamplesInit(&(Threads[1].Samples), (UINT64)0);
+
+	Methods[0] = BenchPingThread;
+	Methods[1] = BenchPongThread;
+
+	QueueGetAllocationStats(&Before);
+
+	Elapsed = BenchRunThreads(Methods, Threads, (UINT32)2);
+
+	BenchReport("pingpong", Backend, (UINT32)1, (UINT32)1, Ops, Elapsed, Threads, (UINT32)2, &Before);
+
+	Backend->Destroy(Queue);
+	Backend->Destroy(Reply);
+}
+
+static void BenchBurst(const BENCH_BACKEND *Backend, UINT64 Ops)
+{
+	BENCH_THREAD Thread;
+	QUEUE_ALLOCATION_STATS Before;
+	UINT64 Done, Start, Last, Now;
+	UINT32 i, Burst;
+
+	memset(&Thread, 0, sizeof(Thread));
+
+	Thread.Backend = Backend;
+	Thread.Queue = Backend->Create();
+
+	BenchSamplesInit(&(Thread.Samples), Ops);
+
+	QueueGetAllocationStats(&Before);
+
+	Start = BenchNow();
+
+	// Every piece of data is added and removed once, two operations.
+	for(Done = (UINT64)0; Done < Ops; Done += (UINT64)Burst * 2)
+	{
+		Burst = (Ops - Done >= (UINT64)BENCH_BURST * 2) ? (UINT32)BENCH_BURST : (UINT32)((Ops - Done + 1) / 2);
+
+		for(i = (UINT32)0, Last = BenchNow(); i < Burst; i++, Last = Now)
+		{
+			Backend->Add(Thread.Queue, BENCH_STOP);
+
+			BenchSample(&(Thread.Samples), (Now = BenchNow()) - Last);
+		}
+
+		for(i = (UINT32)0, Last = BenchNow(); i < Burst; i++, Last = Now)
+		{
+			Backend->Remove(Thread.Queue);
+
+			BenchSample(&(Thread.Samples), (Now = BenchNow()) - Last);
+		}
+	}
+
+	BenchReport("burst", Backend, (UINT32)1, (UINT32)1, Done, BenchNow() - Start, &Thread, (UINT32)1, &Before);
+
+	Backend->Destroy(Thread.Queue);
+}
+
+static void *BenchProducerThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	UINT64 i;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	for(i = (UINT64)0; i < Thread->Ops; i++)
+		BenchAddUntilDone(Thread->Backend, Thread->Queue, BenchStamp());
+
+	return NULL;
+}
+
+static void *BenchConsumerThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	void *Data;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	// A FIFO QUEUE hands a consumer its stop after all of the data.
+	while((Data = BenchRemoveUntilDone(Thread->Backend, Thread->Queue)) != BENCH_STOP)
+		BenchSample(&(Thread->Samples), BenchNow() - (UINT64)(size_t)Data);
+
+	return NULL;
+}
+
+/*
+	Producers and consumers run as separate threads, the stops for
+	the consumers are added once every producer is done.
+*/
+static void *BenchLastProducerThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	UINT32 *Remaining, i;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchProducerThread(Argument);
+
+	Remaining = (UINT32*)Thread->Reply;
+
+	if(__atomic_sub_fetch(&Remaining[0], (UINT32)1, __ATOMIC_ACQ_REL) == (UINT32)0)
+	{
+		for(i = (UINT32)0; i < Remaining[1]; i++)
+			BenchAddUntilDone(Thread->Backend, Thread->Queue, BENCH_STOP);
+	}
+
+	return NULL;
+}
+
+static void BenchProdCons(const BENCH_BACKEND *Backend, UINT64 Ops, UINT32 Producers, UINT32 Consumers)
+{
+	void *(**Methods)(void*);
+	BENCH_THREAD *Threads;
+	QUEUE_ALLOCATION_STATS Before;
+	UINT32 Remaining[2], i;
+	UINT64 Elapsed;
+	void *Queue;
+
+	Queue = Backend->Create();
+
+	Methods = (void *(**)(void*))BenchAlloc((size_t)(Producers + Consumers) * sizeof(*Methods));
+	Threads = (BENCH_THREAD*)BenchAlloc((size_t)(Producers + Consumers) * sizeof(BENCH_THREAD));
+
+	Remaining[0] = Producers;
+	Remaining[1] = Consumers;
+
+	for(i = (UINT32)0; i < Producers + Consumers; i++)
+	{
+		Threads[i].Backend = Backend;
+		Threads[i].Queue = Queue;
+		Threads[i].Reply = (void*)Remaining;
+
+		if(i < Producers)
+		{
+			// Spread the remainder over the first producers.
+			Threads[i].Ops = Ops / Producers + ((UINT64)i < Ops % Producers);
+			Methods[i] = BenchLastProducerThread;
+
+			BenchSamplesInit(&(Threads[i].Samples), (UINT64)0);
+		}
+		else
+		{
+			Methods[i] = BenchConsumerThread;
+
+			BenchSamplesInit(&(Threads[i].Samples), Ops / Consumers + 1);
+		}
+	}
+
+	QueueGetAllocationStats(&Before);
+
+	Elapsed = BenchRunThreads(Methods, Threads, Producers + Consumers);
+
+	BenchReport("prodcons", Backend, Producers, Consumers, Ops, Elapsed, Threads, Producers + Consumers, &Before);
+
+	// A MULTI_QUEUE is only roughly FIFO, its consumers may stop early.
+	while(Backend->Remove(Queue) != NULL)
+		continue;
+
+	free(Methods);
+	free(Threads);
+
+	Backend->Destroy(Queue);
+}
+
+/*
+	Stands in for the work of a task so thieves have something to
+	take over.
+*/
+static void BenchRunTask(BENCH_THREAD *Thread, void *Task)
+{
+	volatile UINT32 Work;
+	UINT32 i;
+
+	for(Work = (UINT32)0, i = (UINT32)0; i < (UINT32)BENCH_TASK_WORK; i++)
+		Work += i;
+
+	BenchSample(&(Thread->Samples), BenchNow() - (UINT64)(size_t)Task);
+
+	__atomic_add_fetch(&BenchTasksDone, (UINT64)1, __ATOMIC_RELEASE);
+}
+
+/*
+	All of the tasks start on the owner, it adds them in bursts and
+	runs them newest first through Remove() until it runs out.
+*/
+static void *BenchOwnerThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	UINT64 Added;
+	UINT32 i;
+	void *Task;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	for(Added = (UINT64)0; Added < Thread->Ops; )
+	{
+		for(i = (UINT32)0; i < (UINT32)BENCH_BURST && Added < Thread->Ops; i++, Added++)
+		{
+			// Full, make room by running a task.
+			while(!Thread->Backend->Add(Thread->Queue, BenchStamp()))
+			{
+				if((Task = Thread->Backend->Remove(Thread->Queue)) != NULL)
+					BenchRunTask(Thread, Task);
+			}
+		}
+
+		while((Task = Thread->Backend->Remove(Thread->Queue)) != NULL)
+			BenchRunTask(Thread, Task);
+	}
+
+	while(__atomic_load_n(&BenchTasksDone, __ATOMIC_ACQUIRE) < Thread->Ops)
+		sched_yield();
+
+	return NULL;
+}
+
+static void *BenchThiefThread(void *Argument)
+{
+	BENCH_THREAD *Thread;
+	void *Task;
+
+	Thread = (BENCH_THREAD*)Argument;
+
+	BenchWaitForGo();
+
+	while(__atomic_load_n(&BenchTasksDone, __ATOMIC_ACQUIRE) < Thread->Ops)
+	{
+		if((Task = Thread->Backend->Steal(Thread->Queue)) != NULL)
+			BenchRunTask(Thread, Task);
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/*
+	A skewed load, every task is added by one owner.  Against the
+	locked QUEUE every thread contends on the same lock, a WS_DEQUE
+	owner only contends with a thief over the last task.
+*/
+static void BenchSteal(const BENCH_BACKEND *Backend, UINT64 Ops, UINT32 Thieves)
+{
+	void *(**Methods)(void*);
+	BENCH_THREAD *Threads;
+	QUEUE_ALLOCATION_STATS Before;
+	UINT64 Elapsed;
+	UINT32 i;
+	void *Queue;
+
+	Queue = Backend->Create();
+
+	Methods = (void *(**)(void*))BenchAlloc((size_t)(Thieves + 1) * sizeof(*Methods));
+	Threads = (BENCH_THREAD*)BenchAlloc((size_t)(Thieves + 1) * sizeof(BENCH_THREAD));
+
+	for(i = (UINT32)0; i <= Thieves; i++)
+	{
+		Threads[i].Backend = Backend;
+		Threads[i].Queue = Queue;
+		Threads[i].Ops = Ops;
+
+		Methods[i] = (i == (UINT32)0) ? BenchOwnerThread : BenchThiefThread;
+
+		BenchSamplesInit(&(Threads[i].Samples), Ops);
+	}
+
+	BenchTasksDone = (UINT64)0;
+
+	QueueGetAllocationStats(&Before);
+
+	Elapsed = BenchRunThreads(Methods, Threads, Thieves + 1);
+
+	BenchReport("steal", Backend, (UINT32)1, Thieves + 1, Ops, Elapsed, Threads, Thieves + 1, &Before);
+
+	free(Methods);
+	free(Threads);
+
+	Backend->Destroy(Queue);
+}
+
+static void BenchUsage(void)
+{
+	UINT32 i;
+
+	fprintf(stderr, "usage: QueueBench [-w pingpong|burst|prodcons|steal|all] [-b backend|all] [-n ops] [-t threads] [-f csv|json]\nbackends:");
+
+	for(i = (UINT32)0; i < (UINT32)BENCH_BACKENDS; i++)
+		fprintf(stderr, " %s", BenchBackends[i].Name);
+
+	fprintf(stderr, "\n");
+
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+	const char *Workload, *Backend;
+	const BENCH_BACKEND *Current;
+	UINT64 Ops;
+	UINT32 MaxThreads, Producers, Consumers, i;
+	int Argument;
+
+	Workload = "all";
+	Backend = "all";
+	Ops = (UINT64)1000000;
+	MaxThreads = (UINT32)4;
+
+	for(Argument = 1; Argument < argc; Argument++)
+	{
+		if(Argument + 1 == argc || argv[Argument][0] != '-' || strlen(argv[Argument]) != 2)
+			BenchUsage();
+
+		switch(argv[Argument++][1])
+		{
+			case 'w': Workload = argv[Argument]; break;
+			case 'b': Backend = argv[Argument]; break;
+			case 'n': Ops = (UINT64)strtoull(argv[Argument], NULL, 10); break;
+			case 't': MaxThreads = (UINT32)strtoul(argv[Argument], NULL, 10); break;
+			case 'f': BenchFormat = argv[Argument]; break;
+			default: BenchUsage();
+		}
+	}
+
+	if(Ops == (UINT64)0 || MaxThreads == (UINT32)0 || (strcmp(BenchFormat, "csv") != 0 && strcmp(BenchFormat, "json") != 0))
+		BenchUsage();
+
+	if(strcmp(BenchFormat, "csv") == 0)
+		printf("workload,backend,config,producers,consumers,ops,seconds,ops_per_sec,p50_ns,p99_ns,p999_ns,allocs_per_op,frees_per_op\n");
+
+	for(i = (UINT32)0; i < (UINT32)BENCH_BACKENDS; i++)
+	{
+		Current = &BenchBackends[i];
+
+		if(strcmp(Backend, "all") != 0 && strcmp(Backend, Current->Name) != 0)
+			continue;
+
+		if(!Current->Owned && (strcmp(Workload, "all") == 0 || strcmp(Workload, "pingpong") == 0))
+			BenchPingPong(Current, Ops);
+
+		if(strcmp(Workload, "all") == 0 || strcmp(Workload, "burst") == 0)
+			BenchBurst(Current, Ops);
+
+		if(!Current->Owned && (strcmp(Workload, "all") == 0 || strcmp(Workload, "prodcons") == 0))
+		{
+			for(Producers = (UINT32)1; Producers <= MaxThreads; Producers++)
+			{
+				for(Consumers = (UINT32)1; Consumers <= MaxThreads; Consumers++)
+				{
+					if(Current->Shared || (Producers == (UINT32)1 && Consumers == (UINT32)1))
+						BenchProdCons(Current, Ops, Producers, Consumers);
+				}
+			}
+		}
+
+		if(Current->Steal != NULL && (strcmp(Workload, "all") == 0 || strcmp(Workload, "steal") == 0))
+		{
+			for(Consumers = (UINT32)1; Consumers <= MaxThreads; Consumers++)
+				BenchSteal(Current, Ops, Consumers - 1);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
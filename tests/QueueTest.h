@@ -0,0 +1,47 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTest.h
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	The checks shared by the Queue tests.  Every test is its own
+	program, built together with Queue.c and the switches it needs
+	given on the command line, see tests/CMakeLists.txt.  A test
+	returns EXIT_SUCCESS, or prints the first check that failed and
+	exits with EXIT_FAILURE.
+*/
+
+#ifndef QUEUE_TEST_H
+	#define QUEUE_TEST_H
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "QueueConfig.h"
+#include "Queue.h"
+
+/*
+	Fails the test if Condition is FALSE.  Condition is always
+	evaluated, so it may call the method under test.
+*/
+#define QueueTestCheck(Condition)						do { if(!(Condition)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); exit(EXIT_FAILURE); } } while(0)
+
+/*
+	Starts Method on a new thread, or fails the test.
+*/
+#define QueueTestStartThread(Thread, Method, Argument)	QueueTestCheck(pthread_create(Thread, NULL, Method, (void*)(Argument)) == 0)
+
+/*
+	Turns a count into data that is never NULL and back.
+*/
+#define QueueTestData(Value)							((void*)(size_t)((Value) + 1))
+#define QueueTestValue(Data)							((size_t)(Data) - 1)
+
+#endif // end of QUEUE_TEST_H
@@ -0,0 +1,274 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestAsync.cpp
+	Version: 1.04
+	IDE: None
+	Compiler: C++20
+
+	Description:
+	Tests the AsyncQueue of Queue.hpp with coroutine consumers, resumed
+	inline or by a small run loop, and with producers on other threads.
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Queue.hpp"
+
+#if (USING_QUEUE_COROUTINES == 0)
+	#error "QueueTestAsync needs USING_QUEUE_COROUTINES."
+#endif // end of USING_QUEUE_COROUTINES
+
+#define QueueTestCheck(Condition)						do { if(!(Condition)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); std::exit(EXIT_FAILURE); } } while(0)
+
+/*
+	A coroutine that starts right away and frees itself when done.
+*/
+struct TestTask
+{
+	struct promise_type
+	{
+		TestTask get_return_object(void) { return TestTask(); }
+		std::suspend_never initial_suspend(void) { return std::suspend_never(); }
+		std::suspend_never final_suspend(void) noexcept { return std::suspend_never(); }
+		void return_void(void) { }
+		void unhandled_exception(void) { std::terminate(); }
+	};
+};
+
+/*
+	Resumes consumers later, from a run loop, like an executor would.
+*/
+struct TestLoop
+{
+	std::deque<std::coroutine_handle<> > *Ready;
+
+	void operator()(std::coroutine_handle<> Handle) const { Ready->push_back(Handle); }
+};
+
+typedef AsyncQueue<std::string> TestQueue;
+typedef AsyncQueue<int, QueuePolicy<0, QueueHeapAllocator, QueueNoLock>, TestLoop> TestLoopQueue;
+
+// Consumers resumed by producers on other threads count here.
+static std::atomic<int> TestDone;
+static std::atomic<int> TestSum;
+
+static TestTask TestConsumer(TestQueue &Queue, int Count)
+{
+	std::string Value;
+
+	for(int i = 0; i < Count; i++)
+	{
+		if(!co_await Queue.pop(Value))
+			break;
+
+		TestSum += std::stoi(Value);
+	}
+
+	TestDone++;
+}
+
+static TestTask TestBatch(TestQueue &Queue, std::size_t Count, TestQueue::Clock::time_point Deadline, std::size_t *Got)
+{
+	std::vector<std::string> Values;
+
+	*Got = co_await Queue.pop_batch(Values, Count, Deadline);
+
+	TestDone++;
+}
+
+static TestTask TestCancellable(TestQueue &Queue, std::stop_token Token, int *Result)
+{
+	std::string Value;
+
+	*Result = (co_await Queue.pop(Value, Token)) ? 1 : 2;
+}
+
+static TestTask TestLoopConsumer(TestLoopQueue &Queue, long *Sum)
+{
+	int Value;
+
+	while(co_await Queue.pop(Value))
+		*Sum += Value;
+}
+
+static void TestRun(std::deque<std::coroutine_handle<> > &Ready)
+{
+	while(!Ready.empty())
+	{
+		std::coroutine_handle<> Handle = Ready.front();
+
+		Ready.pop_front();
+		Handle.resume();
+	}
+}
+
+static void TestPop(void)
+{
+	TestQueue Queue;
+
+	TestDone = TestSum = 0;
+
+	// Data already there is taken without suspending.
+	Queue.push("5");
+	TestConsumer(Queue, 3);
+	QueueTestCheck(TestDone == 0 && TestSum == 5);
+
+	// A push goes straight to the suspended consumer.
+	Queue.push("6");
+	Queue.push("7");
+	QueueTestCheck(TestDone == 1 && TestSum == 18 && Queue.empty());
+
+	// close() resumes every consumer with false.
+	TestConsumer(Queue, 100);
+	Queue.close();
+	QueueTestCheck(TestDone == 2);
+	QueueTestCheck(!Queue.push("1"));
+}
+
+static void TestPopBatch(void)
+{
+	TestQueue::Clock::time_point Deadline;
+	std::size_t Got;
+
+	TestDone = 0;
+
+	{
+		TestQueue Queue;
+
+		TestBatch(Queue, 3, TestQueue::Clock::time_point::max(), &Got);
+		Queue.push("1");
+		Queue.push("2");
+		QueueTestCheck(TestDone == 0);
+		Queue.push("3");
+		QueueTestCheck(TestDone == 1 && Got == 3);
+	}
+
+	{
+		TestQueue Queue;
+
+		// Only expire() notices a deadline.
+		Deadline = TestQueue::Clock::now() + std::chrono::milliseconds(5);
+
+		TestBatch(Queue, 3, Deadline, &Got);
+		Queue.push("1");
+		QueueTestCheck(Queue.next_deadline() == Deadline);
+		QueueTestCheck(Queue.expire(Deadline - std::chrono::milliseconds(1)) == 0);
+		QueueTestCheck(Queue.expire(Deadline) == 1 && Got == 1 && TestDone == 2);
+		QueueTestCheck(Queue.next_deadline() == TestQueue::Clock::time_point::max());
+	}
+}
+
+static void TestStop(void)
+{
+	std::stop_source Source, Stopped;
+	TestQueue Queue;
+	int Result;
+
+	Result = 0;
+
+	TestCancellable(Queue, Source.get_token(), &Result);
+	QueueTestCheck(Result == 0);
+
+	Source.request_stop();
+	QueueTestCheck(Result == 2);
+
+	// The stopped consumer doesn't take the next push.
+	Queue.push("1");
+	QueueTestCheck(Queue.size() == 1);
+
+	Stopped.request_stop();
+	Result = 0;
+
+	TestCancellable(Queue, Stopped.get_token(), &Result);
+	QueueTestCheck(Result == 2 && Queue.size() == 1);
+}
+
+static void TestResumer(void)
+{
+	std::deque<std::coroutine_handle<> > Ready;
+	TestLoopQueue Queue(TestLoop{&Ready});
+	long Sum;
+
+	Sum = 0;
+
+	for(int i = 0; i < 100; i++)
+		TestLoopConsumer(Queue, &Sum);
+
+	for(int i = 1; i <= 10000; i++)
+	{
+		Queue.push(i);
+
+		// Nothing runs until the loop gets to it.
+		QueueTestCheck(Ready.size() == 1);
+
+		TestRun(Ready);
+	}
+
+	Queue.close();
+	TestRun(Ready);
+
+	QueueTestCheck(Sum == 50005000L);
+}
+
+/*
+	Producers on other threads resume the consumers inline, racing
+	each other and stop requests.
+*/
+static void TestThreads(void)
+{
+	{
+		TestQueue Queue;
+
+		TestDone = TestSum = 0;
+
+		for(int i = 0; i < 4; i++)
+			TestConsumer(Queue, 1000000);
+
+		std::thread First([&Queue]() { for(int i = 0; i < 20000; i++) Queue.push("1"); });
+		std::thread Second([&Queue]() { for(int i = 0; i < 20000; i++) Queue.push("2"); });
+
+		First.join();
+		Second.join();
+
+		Queue.close();
+
+		QueueTestCheck(TestDone == 4 && TestSum == 60000);
+	}
+
+	for(int i = 0; i < 1000; i++)
+	{
+		std::stop_source Source;
+		TestQueue Queue;
+		int Result;
+
+		Result = 0;
+
+		TestCancellable(Queue, Source.get_token(), &Result);
+
+		std::thread Producer([&Queue]() { Queue.push("1"); });
+
+		Source.request_stop();
+		Producer.join();
+
+		// Either the push or the stop won, never both.
+		QueueTestCheck(Result == 1 || Result == 2);
+		QueueTestCheck(Queue.size() == ((Result == 2) ? 1u : 0u));
+	}
+}
+
+int main(void)
+{
+	TestPop();
+	TestPopBatch();
+	TestStop();
+	TestResumer();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestBounded.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreateBoundedQueue() with every overflow
+	policy, through QueueAdd() and QueueAddBatch(), and producers
+	blocked at the limit until a consumer makes room.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_BOUNDED == 0 || USING_QUEUE_BLOCKING_METHODS == 0)
+	#error "QueueTestBounded needs USING_QUEUE_BOUNDED and USING_QUEUE_BLOCKING_METHODS."
+#endif // end of USING_QUEUE_BOUNDED || USING_QUEUE_BLOCKING_METHODS
+
+#define TEST_LIMIT										8
+#define TEST_STRESS_ITEMS								100000
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestFill(QUEUE *Queue, size_t First, size_t Last)
+{
+	size_t i;
+
+	for(i = First; i < Last; i++)
+		QueueTestCheck(QueueAdd(Queue, QueueTestData(i)));
+}
+
+static void TestExpect(QUEUE *Queue, size_t First, size_t Last)
+{
+	size_t i;
+
+	for(i = First; i < Last; i++)
+		QueueTestCheck(QueueRemove(Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove(Queue) == NULL);
+}
+
+static void TestCreate(void)
+{
+	QUEUE Queue;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)0, (BYTE)QUEUE_OVERFLOW_REJECT, (void(*)(void*))NULL) == NULL);
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)(QUEUE_OVERFLOW_DROP_NEWEST + 1), (void(*)(void*))NULL) == NULL);
+
+	// An unbounded QUEUE never drops.
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	TestFill(&Queue, 0, TEST_LIMIT * 4);
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)0 && QueueGetSize(&Queue) == (UINT32)(TEST_LIMIT * 4));
+	QueueTestCheck(QueueClear(&Queue));
+}
+
+static void TestReject(void)
+{
+	const void *Items[TEST_LIMIT];
+	QUEUE Queue;
+	size_t i;
+
+	for(i = 0; i < TEST_LIMIT; i++)
+		Items[i] = QueueTestData(TEST_LIMIT + i);
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_REJECT, TestFree) == &Queue);
+
+	TestFill(&Queue, 0, TEST_LIMIT - 2);
+
+	// A batch either fits whole or isn't added at all.
+	QueueTestCheck(!QueueAddBatch(&Queue, Items, (UINT32)3));
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)2));
+	QueueTestCheck(!QueueAdd(&Queue, QueueTestData(0)));
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_LIMIT);
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)0 && TestFreed == (UINT32)0);
+
+	for(i = 0; i < TEST_LIMIT - 2; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	TestExpect(&Queue, TEST_LIMIT, TEST_LIMIT + 2);
+}
+
+static void TestDropOldest(void)
+{
+	const void *Items[TEST_LIMIT];
+	QUEUE Queue;
+	size_t i;
+
+	for(i = 0; i < TEST_LIMIT; i++)
+		Items[i] = QueueTestData(TEST_LIMIT * 3 + i);
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_DROP_OLDEST, TestFree) == &Queue);
+
+	TestFill(&Queue, 0, TEST_LIMIT * 3);
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_LIMIT);
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)(TEST_LIMIT * 2) && TestFreed == (UINT32)(TEST_LIMIT * 2));
+
+	// A batch pushes out as much of the front as it needs.
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(TEST_LIMIT * 2));
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)3));
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)(TEST_LIMIT * 2 + 2));
+
+	TestExpect(&Queue, TEST_LIMIT * 2 + 3, TEST_LIMIT * 3 + 3);
+}
+
+static void TestDropNewest(void)
+{
+	QUEUE Queue;
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_DROP_NEWEST, TestFree) == &Queue);
+
+	// Dropped data still counts as added.
+	TestFill(&Queue, 0, TEST_LIMIT * 3);
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_LIMIT);
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)(TEST_LIMIT * 2) && TestFreed == (UINT32)(TEST_LIMIT * 2));
+
+	TestExpect(&Queue, 0, TEST_LIMIT);
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t i;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(QueueAdd((QUEUE*)Argument, QueueTestData(i)));
+
+	return NULL;
+}
+
+/*
+	QueueAdd() on a full QUEUE_OVERFLOW_BLOCK QUEUE waits for room.
+*/
+static void TestBlock(void)
+{
+	pthread_t Thread;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_BLOCK, (void(*)(void*))NULL) == &Queue);
+
+	QueueTestStartThread(&Thread, TestProducer, &Queue);
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)QUEUE_WAIT_FOREVER) == QueueTestData(i));
+		QueueTestCheck(QueueGetSize(&Queue) <= (UINT32)TEST_LIMIT);
+	}
+
+	pthread_join(Thread, NULL);
+
+	TestFill(&Queue, 0, TEST_LIMIT);
+
+	QueueTestCheck(!QueueAddWait(&Queue, QueueTestData(TEST_LIMIT), (UINT32)20));
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)0);
+
+	// Closing wakes a blocked producer with a failure.
+	QueueTestCheck(QueueClose(&Queue));
+	QueueTestCheck(!QueueAdd(&Queue, QueueTestData(0)));
+
+	QueueTestCheck(QueueClear(&Queue));
+}
+
+static void *TestBatchProducer(void *Argument)
+{
+	const void *Items[TEST_LIMIT];
+	size_t i;
+
+	for(i = 0; i < TEST_LIMIT; i++)
+		Items[i] = QueueTestData(TEST_LIMIT + i);
+
+	QueueTestCheck(QueueAddBatch((QUEUE*)Argument, Items, (UINT32)TEST_LIMIT));
+
+	return NULL;
+}
+
+/*
+	A batch on a QUEUE_OVERFLOW_BLOCK QUEUE waits until all of it
+	fits, one that never can fails at once.
+*/
+static void TestBlockBatch(void)
+{
+	const void *Items[TEST_LIMIT + 1];
+	pthread_t Thread;
+	QUEUE Queue;
+	size_t i;
+
+	for(i = 0; i <= TEST_LIMIT; i++)
+		Items[i] = QueueTestData(i);
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_BLOCK, (void(*)(void*))NULL) == &Queue);
+
+	QueueTestCheck(!QueueAddBatch(&Queue, Items, (UINT32)(TEST_LIMIT + 1)));
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)2));
+
+	QueueTestStartThread(&Thread, TestBatchProducer, &Queue);
+
+	// Freeing one slot at a time is never enough until the last.
+	for(i = 0; i < 2; i++)
+		QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)QUEUE_WAIT_FOREVER) == QueueTestData(i));
+
+	pthread_join(Thread, NULL);
+
+	TestExpect(&Queue, TEST_LIMIT, TEST_LIMIT * 2);
+}
+
+static void *TestBlockedAdd(void *Argument)
+{
+	QueueTestCheck(QueueAdd((QUEUE*)Argument, QueueTestData(TEST_LIMIT)));
+
+	return NULL;
+}
+
+/*
+	Draining a full QUEUE_OVERFLOW_BLOCK QUEUE makes room for a
+	producer waiting on it.
+*/
+static void TestBlockDrain(void)
+{
+	pthread_t Thread;
+	QUEUE Queue;
+	UINT32 Count;
+	void **Drained;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_LIMIT, (BYTE)QUEUE_OVERFLOW_BLOCK, (void(*)(void*))NULL) == &Queue);
+
+	TestFill(&Queue, 0, TEST_LIMIT);
+
+	QueueTestStartThread(&Thread, TestBlockedAdd, &Queue);
+
+	// Give the producer time to block, the drain has to wake it either way.
+	QueueTestCheck(QueueAddWait(&Queue, QueueTestData(0), (UINT32)20) == (BOOL)FALSE);
+
+	QueueTestCheck((Drained = QueueDrain(&Queue, &Count)) != NULL && Count == (UINT32)TEST_LIMIT);
+	QueueMemDealloc(Drained);
+
+	pthread_join(Thread, NULL);
+
+	TestExpect(&Queue, TEST_LIMIT, TEST_LIMIT + 1);
+}
+
+int main(void)
+{
+	TestCreate();
+	TestReject();
+	TestDropOldest();
+	TestDropNewest();
+	TestBlock();
+	TestBlockBatch();
+	TestBlockDrain();
+
+	return EXIT_SUCCESS;
+}
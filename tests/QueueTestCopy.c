@@ -0,0 +1,135 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestCopy.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreateCopyQueue() with an element that is
+	not a multiple of the pointer size.  The elements added are
+	overwritten right away, so only the copies can come back out.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_COPY == 0)
+	#error "QueueTestCopy needs USING_QUEUE_COPY."
+#endif // end of USING_QUEUE_COPY
+
+#define TEST_ITEMS										1000
+
+typedef struct
+{
+	UINT32 Value;
+	char Name[13];
+}TEST_ELEMENT;
+
+static UINT32 TestFreed;
+
+/*
+	Gets a pointer to each stored copy, which stays the QUEUE's.
+*/
+static void TestFree(void *Data)
+{
+	QueueTestCheck(strncmp(((TEST_ELEMENT*)Data)->Name, "element", 7) == 0);
+
+	TestFreed++;
+}
+
+static void TestFill(TEST_ELEMENT *Element, UINT32 Value)
+{
+	memset(Element, 0, sizeof(TEST_ELEMENT));
+
+	Element->Value = Value;
+	sprintf(Element->Name, "element %u", (unsigned)(Value % 1000));
+}
+
+static void TestCheckElement(const TEST_ELEMENT *Element, UINT32 Value)
+{
+	TEST_ELEMENT Expected;
+
+	TestFill(&Expected, Value);
+
+	QueueTestCheck(memcmp(Element, &Expected, sizeof(TEST_ELEMENT)) == 0);
+}
+
+static void TestCopies(void)
+{
+	TEST_ELEMENT Element;
+	QUEUE Queue;
+	UINT32 i;
+
+	QueueTestCheck(CreateCopyQueue(&Queue, (UINT32)0, (void(*)(void*))NULL) == NULL);
+	QueueTestCheck(CreateCopyQueue(&Queue, (UINT32)sizeof(TEST_ELEMENT), (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(!QueueRemoveInto(&Queue, &Element) && QueuePeek(&Queue) == NULL);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+	{
+		TestFill(&Element, i);
+
+		QueueTestCheck(QueueAddCopy(&Queue, &Element));
+
+		memset(&Element, 0xFF, sizeof(Element));
+	}
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_ITEMS);
+
+	// The elements are inline, DataSizeInBytes doesn't matter.
+	QueueTestCheck(QueueGetSizeInBytes(&Queue, (UINT32)0) == (UINT32)(sizeof(QUEUE) + TEST_ITEMS * (sizeof(QUEUE_NODE) + sizeof(TEST_ELEMENT))));
+	QueueTestCheck(QueueGetSizeInBytes(&Queue, (UINT32)100) == QueueGetSizeInBytes(&Queue, (UINT32)0));
+
+	// QueueRemove() would hand out a pointer into a freed node.
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)TEST_ITEMS);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+	{
+		TestCheckElement((const TEST_ELEMENT*)QueuePeek(&Queue), i);
+
+		QueueTestCheck(QueueRemoveInto(&Queue, &Element));
+
+		TestCheckElement(&Element, i);
+	}
+
+	QueueTestCheck(!QueueRemoveInto(&Queue, &Element) && QueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(QueueGetSizeInBytes(&Queue, (UINT32)0) == (UINT32)sizeof(QUEUE));
+
+	// Only a copy QUEUE takes copies.
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(!QueueAddCopy(&Queue, &Element) && !QueueRemoveInto(&Queue, &Element));
+}
+
+static void TestClear(void)
+{
+	TEST_ELEMENT Element;
+	QUEUE Queue;
+	UINT32 i;
+
+	QueueTestCheck(CreateCopyQueue(&Queue, (UINT32)sizeof(TEST_ELEMENT), TestFree) == &Queue);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+	{
+		TestFill(&Element, i);
+
+		QueueTestCheck(QueueAddCopy(&Queue, &Element));
+	}
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)TEST_ITEMS && QueueGetSize(&Queue) == (UINT32)0);
+
+	TestFill(&Element, 7);
+
+	QueueTestCheck(QueueAddCopy(&Queue, &Element) && QueueRemoveInto(&Queue, &Element));
+
+	TestCheckElement(&Element, 7);
+}
+
+int main(void)
+{
+	TestCopies();
+	TestClear();
+
+	return EXIT_SUCCESS;
+}
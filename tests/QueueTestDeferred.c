@@ -0,0 +1,222 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestDeferred.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests QueueClearDeferred(), QueueStartReclaimer() and
+	QueueStopReclaimer(), with the reclaimer running, stopped and
+	started again, and while clearing threads race its stops, and
+	that a producer blocked on a full QUEUE wakes once it is cleared.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_DEFERRED_CLEAR == 0 || USING_QUEUE_RING_BUFFER == 0 || USING_QUEUE_BOUNDED == 0)
+	#error "QueueTestDeferred needs USING_QUEUE_DEFERRED_CLEAR, USING_QUEUE_RING_BUFFER and USING_QUEUE_BOUNDED."
+#endif // end of USING_QUEUE_DEFERRED_CLEAR || USING_QUEUE_RING_BUFFER || USING_QUEUE_BOUNDED
+
+#define TEST_ITEMS										100
+#define TEST_CLEARERS									3
+#define TEST_RESTARTS									200
+
+static pthread_t TestMainThread;
+static UINT32 TestFreed, TestFreedElsewhere, TestAdded;
+static BOOL TestDone;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	__atomic_add_fetch(&TestFreed, (UINT32)1, __ATOMIC_RELAXED);
+
+	if(!pthread_equal(pthread_self(), TestMainThread))
+		__atomic_add_fetch(&TestFreedElsewhere, (UINT32)1, __ATOMIC_RELAXED);
+}
+
+static void TestFill(QUEUE *Queue, size_t Count)
+{
+	size_t i;
+
+	for(i = 0; i < Count; i++)
+		QueueTestCheck(QueueAdd(Queue, QueueTestData(i)));
+}
+
+static void TestReset(void)
+{
+	__atomic_store_n(&TestFreed, (UINT32)0, __ATOMIC_RELAXED);
+	__atomic_store_n(&TestFreedElsewhere, (UINT32)0, __ATOMIC_RELAXED);
+}
+
+/*
+	Without a reclaimer QueueClearDeferred() is QueueClear().
+*/
+static void TestStopped(void)
+{
+	QUEUE Queue;
+
+	QueueTestCheck(!QueueStopReclaimer());
+	QueueTestCheck(CreateQueue(&Queue, TestFree) == &Queue);
+
+	TestReset();
+	TestFill(&Queue, TEST_ITEMS);
+
+	QueueTestCheck(QueueClearDeferred(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)TEST_ITEMS && TestFreedElsewhere == (UINT32)0);
+	QueueTestCheck(QueueIsEmpty((&Queue)));
+
+	// An empty QUEUE is fine too.
+	QueueTestCheck(QueueClearDeferred(&Queue));
+}
+
+static void TestRunning(void)
+{
+	QUEUE Queue, Ring;
+	size_t Round;
+
+	QueueTestCheck(CreateQueue(&Queue, TestFree) == &Queue);
+	QueueTestCheck(CreateRingQueue(&Ring, (UINT32)TEST_ITEMS, TestFree) == &Ring);
+
+	// Restarting gives the same result every time.
+	for(Round = 0; Round < 3; Round++)
+	{
+		TestReset();
+
+		QueueTestCheck(QueueStartReclaimer());
+		QueueTestCheck(!QueueStartReclaimer());
+
+		TestFill(&Queue, TEST_ITEMS);
+
+		QueueTestCheck(QueueClearDeferred(&Queue));
+		QueueTestCheck(QueueIsEmpty((&Queue)) && QueueRemove(&Queue) == NULL);
+
+		// The QUEUE is usable while its old contents are still pending.
+		TestFill(&Queue, TEST_ITEMS);
+		QueueTestCheck(QueueClearDeferred(&Queue));
+
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(0)) && QueueRemove(&Queue) == QueueTestData(0));
+
+		// A ring keeps its array and is cleared in place.
+		TestFill(&Ring, TEST_ITEMS);
+		QueueTestCheck(QueueClearDeferred(&Ring));
+		QueueTestCheck(QueueIsEmpty((&Ring)));
+
+		// Stopping waits until everything pending is freed.
+		QueueTestCheck(QueueStopReclaimer());
+		QueueTestCheck(!QueueStopReclaimer());
+
+		QueueTestCheck(TestFreed == (UINT32)(TEST_ITEMS * 3));
+		QueueTestCheck(TestFreedElsewhere == (UINT32)(TEST_ITEMS * 2));
+	}
+
+	QueueTestCheck(DestroyRingQueue(&Ring));
+}
+
+static void *TestClearer(void *Argument)
+{
+	QUEUE Queue;
+	size_t i;
+
+	(void)Argument;
+
+	QueueTestCheck(CreateQueue(&Queue, TestFree) == &Queue);
+
+	while(!__atomic_load_n(&TestDone, __ATOMIC_ACQUIRE))
+	{
+		for(i = 0; i < 10; i++)
+			QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+		__atomic_add_fetch(&TestAdded, (UINT32)10, __ATOMIC_RELAXED);
+
+		QueueTestCheck(QueueClearDeferred(&Queue));
+	}
+
+	return NULL;
+}
+
+/*
+	Clears that saw the reclaimer running can reach the list after a
+	stop closed it, they have to free their data themselves.  Nothing
+	may be lost or freed twice either way.
+*/
+static void TestRacingStops(void)
+{
+	pthread_t Threads[TEST_CLEARERS];
+	size_t i;
+
+	TestReset();
+
+	__atomic_store_n(&TestAdded, (UINT32)0, __ATOMIC_RELAXED);
+	__atomic_store_n(&TestDone, (BOOL)FALSE, __ATOMIC_RELEASE);
+
+	for(i = 0; i < TEST_CLEARERS; i++)
+		QueueTestStartThread(&Threads[i], TestClearer, NULL);
+
+	for(i = 0; i < TEST_RESTARTS; i++)
+	{
+		QueueTestCheck(QueueStartReclaimer());
+
+		sched_yield();
+
+		QueueTestCheck(QueueStopReclaimer());
+	}
+
+	__atomic_store_n(&TestDone, (BOOL)TRUE, __ATOMIC_RELEASE);
+
+	for(i = 0; i < TEST_CLEARERS; i++)
+		pthread_join(Threads[i], NULL);
+
+	QueueTestCheck(TestFreed == TestAdded);
+}
+
+static void *TestBlockedAdd(void *Argument)
+{
+	QueueTestCheck(QueueAdd((QUEUE*)Argument, QueueTestData(TEST_ITEMS)));
+
+	return NULL;
+}
+
+/*
+	Detaching the contents of a full QUEUE_OVERFLOW_BLOCK QUEUE makes
+	room for a producer waiting on it, the reclaimer frees them later.
+*/
+static void TestBlockClear(void)
+{
+	pthread_t Thread;
+	QUEUE Queue;
+
+	TestReset();
+
+	QueueTestCheck(QueueStartReclaimer());
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)TEST_ITEMS, (BYTE)QUEUE_OVERFLOW_BLOCK, TestFree) == &Queue);
+
+	TestFill(&Queue, TEST_ITEMS);
+
+	QueueTestStartThread(&Thread, TestBlockedAdd, &Queue);
+
+	// Give the producer time to block, the clear has to wake it either way.
+	QueueTestCheck(QueueAddWait(&Queue, QueueTestData(0), (UINT32)20) == (BOOL)FALSE);
+
+	QueueTestCheck(QueueClearDeferred(&Queue));
+
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(TEST_ITEMS) && QueueIsEmpty((&Queue)));
+
+	QueueTestCheck(QueueStopReclaimer());
+	QueueTestCheck(TestFreed == (UINT32)TEST_ITEMS && TestFreedElsewhere == (UINT32)TEST_ITEMS);
+}
+
+int main(void)
+{
+	TestMainThread = pthread_self();
+
+	TestStopped();
+	TestRunning();
+	TestRacingStops();
+	TestBlockClear();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestEventFd.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the event file descriptor of QueueOpenEventFd(), which must
+	only become readable when a QUEUE a consumer found empty gets data,
+	and a consumer thread polling it while a producer adds.
+*/
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_EVENT_FD == 0 || USING_QUEUE_BLOCKING_METHODS == 0)
+	#error "QueueTestEventFd needs USING_QUEUE_EVENT_FD and USING_QUEUE_BLOCKING_METHODS."
+#endif // end of USING_QUEUE_EVENT_FD || USING_QUEUE_BLOCKING_METHODS
+
+#define TEST_ITEMS										10
+#define TEST_STRESS_ITEMS								100000
+
+static BOOL TestReadable(int Fd, int Timeout)
+{
+	struct pollfd Poll;
+
+	Poll.fd = Fd;
+	Poll.events = POLLIN;
+	Poll.revents = 0;
+
+	return (BOOL)(poll(&Poll, 1, Timeout) == 1 && (Poll.revents & POLLIN));
+}
+
+static void TestSignals(void)
+{
+	const void *Items[TEST_ITEMS];
+	void *Removed[TEST_ITEMS], **Drained;
+	eventfd_t Value;
+	UINT32 Count;
+	QUEUE Queue;
+	size_t i;
+	int Fd;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck((Fd = QueueOpenEventFd(&Queue)) >= 0);
+	QueueTestCheck(QueueOpenEventFd(&Queue) == Fd);
+
+	QueueTestCheck(!TestReadable(Fd, 0));
+
+	// Only the first add signals, the rest find it signaled already.
+	for(i = 0; i < TEST_ITEMS; i++)
+	{
+		Items[i] = QueueTestData(i);
+
+		QueueTestCheck(QueueAdd(&Queue, Items[i]));
+		QueueTestCheck(TestReadable(Fd, 0));
+	}
+
+	QueueTestCheck(eventfd_read(Fd, &Value) == 0 && Value == (eventfd_t)1);
+	QueueTestCheck(!TestReadable(Fd, 0));
+
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(TEST_ITEMS)));
+	QueueTestCheck(!TestReadable(Fd, 0));
+
+	// Removing down to empty isn't enough, a remove has to find it empty.
+	for(i = 0; i <= TEST_ITEMS; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	QueueTestCheck(QueueAdd(&Queue, Items[0]));
+	QueueTestCheck(TestReadable(Fd, 0));
+
+	QueueTestCheck(QueueRemove(&Queue) == Items[0] && TestReadable(Fd, 0));
+	QueueTestCheck(QueueRemove(&Queue) == NULL && !TestReadable(Fd, 0));
+
+	// A batch signals once, a short batch remove rearms.
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)TEST_ITEMS));
+	QueueTestCheck(eventfd_read(Fd, &Value) == 0 && Value == (eventfd_t)1);
+
+	QueueTestCheck(QueueRemoveBatch(&Queue, Removed, (UINT32)TEST_ITEMS) == (UINT32)TEST_ITEMS);
+	QueueTestCheck(QueueRemoveBatch(&Queue, Removed, (UINT32)1) == (UINT32)0);
+
+	// So does draining, even though it never finds the QUEUE empty.
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)TEST_ITEMS) && TestReadable(Fd, 0));
+	QueueTestCheck((Drained = QueueDrain(&Queue, &Count)) != NULL && Count == (UINT32)TEST_ITEMS);
+	QueueTestCheck(!TestReadable(Fd, 0));
+
+	QueueMemDealloc(Drained);
+
+	QueueTestCheck(QueueAdd(&Queue, Items[0]));
+	QueueTestCheck(TestReadable(Fd, 0));
+
+	QueueTestCheck(QueueCloseEventFd(&Queue));
+	QueueTestCheck(QueueRemove(&Queue) == Items[0]);
+
+	// Data already there when it is opened signals at once.
+	QueueTestCheck(QueueAdd(&Queue, Items[1]));
+	QueueTestCheck((Fd = QueueOpenEventFd(&Queue)) >= 0 && TestReadable(Fd, 0));
+
+	QueueTestCheck(QueueCloseEventFd(&Queue));
+	QueueTestCheck(QueueClear(&Queue));
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t i;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		QueueTestCheck(QueueAdd((QUEUE*)Argument, QueueTestData(i)));
+
+		if(i % 64 == 0)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/*
+	The consumer only ever sleeps in poll(), so a lost signal hangs it.
+*/
+static void TestThreads(void)
+{
+	pthread_t Thread;
+	QUEUE Queue;
+	size_t Next;
+	void *Data;
+	int Fd;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck((Fd = QueueOpenEventFd(&Queue)) >= 0);
+
+	QueueTestStartThread(&Thread, TestProducer, &Queue);
+
+	for(Next = 0; Next < TEST_STRESS_ITEMS; )
+	{
+		QueueTestCheck(TestReadable(Fd, 10000));
+
+		while((Data = QueueRemove(&Queue)) != NULL)
+			QueueTestCheck(Data == QueueTestData(Next++));
+	}
+
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(!TestReadable(Fd, 0));
+	QueueTestCheck(QueueCloseEventFd(&Queue));
+}
+
+int main(void)
+{
+	TestSignals();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
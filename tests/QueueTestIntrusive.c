@@ -0,0 +1,121 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestIntrusive.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreateIntrusiveQueue() with the QUEUE_NODE
+	in the middle of each piece of data, so a wrong offset can't go
+	unnoticed.  QueueClear() frees the data the nodes live in.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_INTRUSIVE == 0)
+	#error "QueueTestIntrusive needs USING_QUEUE_INTRUSIVE."
+#endif // end of USING_QUEUE_INTRUSIVE
+
+#define TEST_ITEMS										1000
+
+typedef struct
+{
+	UINT32 Before;
+	QUEUE_NODE Link;
+	UINT32 Value;
+}TEST_ITEM;
+
+static UINT32 TestFreed;
+
+/*
+	Frees the TEST_ITEM, and with it the QUEUE_NODE linking it.
+*/
+static void TestFree(void *Data)
+{
+	QueueTestCheck(((TEST_ITEM*)Data)->Before == ((TEST_ITEM*)Data)->Value);
+
+	free(Data);
+
+	TestFreed++;
+}
+
+static TEST_ITEM *TestNewItem(UINT32 Value)
+{
+	TEST_ITEM *Item;
+
+	QueueTestCheck((Item = (TEST_ITEM*)malloc(sizeof(TEST_ITEM))) != NULL);
+
+	Item->Before = Item->Value = Value;
+
+	return Item;
+}
+
+static void TestOrder(void)
+{
+	TEST_ITEM Items[TEST_ITEMS];
+	QUEUE Queue;
+	UINT32 i;
+
+	QueueTestCheck(CreateIntrusiveQueue(&Queue, QueueGetNodeOffset(TEST_ITEM, Link), (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueuePeek(&Queue) == NULL);
+	QueueTestCheck(!QueueAdd(&Queue, NULL));
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+	{
+		Items[i].Before = Items[i].Value = i;
+
+		QueueTestCheck(QueueAdd(&Queue, &Items[i]));
+	}
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_ITEMS);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS / 2; i++)
+	{
+		QueueTestCheck(QueuePeek(&Queue) == (void*)&Items[i]);
+		QueueTestCheck(QueueRemove(&Queue) == (void*)&Items[i]);
+	}
+
+	// A removed piece of data can be added again, its node is free.
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS / 2; i++)
+		QueueTestCheck(QueueAdd(&Queue, &Items[i]));
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+		QueueTestCheck(QueueRemove(&Queue) == (void*)&Items[(i + TEST_ITEMS / 2) % TEST_ITEMS]);
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)0);
+}
+
+/*
+	The free method frees the struct holding the QUEUE_NODE, so
+	QueueClear() must be done with each node before it frees the data.
+*/
+static void TestClear(void)
+{
+	QUEUE Queue;
+	UINT32 i;
+
+	QueueTestCheck(CreateIntrusiveQueue(&Queue, QueueGetNodeOffset(TEST_ITEM, Link), TestFree) == &Queue);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, TestNewItem(i)));
+
+	TestFree(QueueRemove(&Queue));
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)(TEST_ITEMS - 1) && QueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	QueueTestCheck(QueueAdd(&Queue, TestNewItem(0)));
+	QueueTestCheck(QueueClear(&Queue) && TestFreed == (UINT32)TEST_ITEMS);
+}
+
+int main(void)
+{
+	TestOrder();
+	TestClear();
+
+	return EXIT_SUCCESS;
+}
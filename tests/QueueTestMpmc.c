@@ -0,0 +1,125 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestMpmc.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the MPMC_QUEUE, on one thread and with several producers
+	and consumers, where every piece of data must come out exactly once.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_MPMC == 0)
+	#error "QueueTestMpmc needs USING_QUEUE_MPMC."
+#endif // end of USING_QUEUE_MPMC
+
+#define TEST_CAPACITY									64
+#define TEST_THREADS									4
+#define TEST_STRESS_ITEMS								50000
+
+static MPMC_QUEUE StressQueue;
+static UINT8 StressSeen[TEST_THREADS * TEST_STRESS_ITEMS];
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestSingleThread(void)
+{
+	MPMC_QUEUE Queue;
+	size_t i, Round;
+
+	QueueTestCheck(CreateMpmcQueue(&Queue, (UINT32)(TEST_CAPACITY - 1), TestFree) == &Queue);
+	QueueTestCheck(MpmcQueueRemove(&Queue) == NULL);
+
+	for(Round = 0; Round < 3; Round++)
+	{
+		for(i = 0; i < TEST_CAPACITY; i++)
+			QueueTestCheck(MpmcQueueAdd(&Queue, QueueTestData(i)));
+
+		QueueTestCheck(!MpmcQueueAdd(&Queue, QueueTestData(TEST_CAPACITY)));
+		QueueTestCheck(MpmcQueueGetSize(&Queue) == (UINT32)TEST_CAPACITY);
+
+		for(i = 0; i < TEST_CAPACITY; i++)
+			QueueTestCheck(MpmcQueueRemove(&Queue) == QueueTestData(i));
+
+		QueueTestCheck(MpmcQueueRemove(&Queue) == NULL && MpmcQueueGetSize(&Queue) == (UINT32)0);
+	}
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(MpmcQueueAdd(&Queue, QueueTestData(0)) && MpmcQueueAdd(&Queue, QueueTestData(1)));
+	QueueTestCheck(DestroyMpmcQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)2);
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t First, i;
+
+	First = (size_t)Argument * TEST_STRESS_ITEMS;
+
+	for(i = First; i < First + TEST_STRESS_ITEMS; i++)
+	{
+		while(!MpmcQueueAdd(&StressQueue, QueueTestData(i)))
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void *TestConsumer(void *Argument)
+{
+	void *Data;
+	size_t i;
+
+	(void)Argument;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		while((Data = MpmcQueueRemove(&StressQueue)) == NULL)
+			sched_yield();
+
+		__atomic_add_fetch(&StressSeen[QueueTestValue(Data)], (UINT8)1, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+static void TestThreads(void)
+{
+	pthread_t Threads[2 * TEST_THREADS];
+	size_t i;
+
+	QueueTestCheck(CreateMpmcQueue(&StressQueue, (UINT32)TEST_CAPACITY, (void(*)(void*))NULL) == &StressQueue);
+
+	for(i = 0; i < TEST_THREADS; i++)
+	{
+		QueueTestStartThread(&Threads[i], TestProducer, i);
+		QueueTestStartThread(&Threads[TEST_THREADS + i], TestConsumer, NULL);
+	}
+
+	for(i = 0; i < 2 * TEST_THREADS; i++)
+		pthread_join(Threads[i], NULL);
+
+	for(i = 0; i < TEST_THREADS * TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(StressSeen[i] == (UINT8)1);
+
+	QueueTestCheck(MpmcQueueGetSize(&StressQueue) == (UINT32)0);
+	QueueTestCheck(DestroyMpmcQueue(&StressQueue));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
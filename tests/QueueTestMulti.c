@@ -0,0 +1,125 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestMulti.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the MULTI_QUEUE, on one thread, where the order is exact, and
+	with several producers and consumers, where every piece of data must
+	come out exactly once.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_MULTI == 0)
+	#error "QueueTestMulti needs USING_QUEUE_MULTI."
+#endif // end of USING_QUEUE_MULTI
+
+#define TEST_SHARDS										8
+#define TEST_THREADS									4
+#define TEST_STRESS_ITEMS								100000
+
+static MULTI_QUEUE StressQueue;
+static UINT8 StressSeen[TEST_THREADS * TEST_STRESS_ITEMS];
+static size_t StressRemoved;
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestSingleThread(void)
+{
+	MULTI_QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateMultiQueue(&Queue, (UINT32)TEST_SHARDS, TestFree) == &Queue);
+	QueueTestCheck(MultiQueueRemove(&Queue) == NULL);
+
+	// One thread always gets its own shard, which grows past its first size.
+	for(i = 0; i < 4 * QUEUE_MULTI_INITIAL_CAPACITY; i++)
+		QueueTestCheck(MultiQueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(MultiQueueGetSize(&Queue) == (UINT32)(4 * QUEUE_MULTI_INITIAL_CAPACITY));
+
+	for(i = 0; i < 4 * QUEUE_MULTI_INITIAL_CAPACITY; i++)
+		QueueTestCheck(MultiQueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(MultiQueueRemove(&Queue) == NULL && MultiQueueGetSize(&Queue) == (UINT32)0);
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(MultiQueueAdd(&Queue, QueueTestData(0)) && MultiQueueAdd(&Queue, QueueTestData(1)));
+	QueueTestCheck(DestroyMultiQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)2);
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t First, i;
+
+	First = (size_t)Argument * TEST_STRESS_ITEMS;
+
+	for(i = First; i < First + TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(MultiQueueAdd(&StressQueue, QueueTestData(i)));
+
+	return NULL;
+}
+
+static void *TestConsumer(void *Argument)
+{
+	void *Data;
+
+	(void)Argument;
+
+	while(__atomic_load_n(&StressRemoved, __ATOMIC_ACQUIRE) < (size_t)TEST_THREADS * TEST_STRESS_ITEMS)
+	{
+		if((Data = MultiQueueRemove(&StressQueue)) != NULL)
+		{
+			__atomic_add_fetch(&StressSeen[QueueTestValue(Data)], (UINT8)1, __ATOMIC_RELAXED);
+			__atomic_add_fetch(&StressRemoved, (size_t)1, __ATOMIC_RELEASE);
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void TestThreads(void)
+{
+	pthread_t Threads[2 * TEST_THREADS];
+	size_t i;
+
+	QueueTestCheck(CreateMultiQueue(&StressQueue, (UINT32)TEST_SHARDS, (void(*)(void*))NULL) == &StressQueue);
+
+	for(i = 0; i < TEST_THREADS; i++)
+	{
+		QueueTestStartThread(&Threads[i], TestProducer, i);
+		QueueTestStartThread(&Threads[TEST_THREADS + i], TestConsumer, NULL);
+	}
+
+	for(i = 0; i < 2 * TEST_THREADS; i++)
+		pthread_join(Threads[i], NULL);
+
+	for(i = 0; i < TEST_THREADS * TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(StressSeen[i] == (UINT8)1);
+
+	QueueTestCheck(MultiQueueGetSize(&StressQueue) == (UINT32)0);
+	QueueTestCheck(DestroyMultiQueue(&StressQueue));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestPersistent.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the PERSISTENT_QUEUE in a new directory under /tmp, built with
+	a small QUEUE_PERSISTENT_SEGMENT_SIZE so the records span many
+	segment files.  The directory is removed again when the test passes.
+	A directory put in the way of the checkpoint makes every sync fail.
+*/
+
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_PERSISTENT == 0)
+	#error "QueueTestPersistent needs USING_QUEUE_PERSISTENT."
+#endif // end of USING_QUEUE_PERSISTENT
+
+#define TEST_RECORDS									5000
+#define TEST_REMOVED									1700
+#define TEST_CRASHED									100
+#define TEST_UNSYNCED									200
+
+static char TestPath[] = "/tmp/QueueTestPersistent.XXXXXX";
+
+/*
+	Writes record Index into Buffer, returns its length.  Records are
+	between a few bytes and a few kilobytes long.
+*/
+static UINT32 TestRecord(char *Buffer, size_t Index)
+{
+	UINT32 Length;
+
+	sprintf(Buffer, "record-%lu", (unsigned long)Index);
+
+	Length = (UINT32)strlen(Buffer) + (UINT32)1 + (UINT32)(Index % 3000);
+
+	memset(Buffer + strlen(Buffer) + 1, (int)(Index & 0xFF), (size_t)(Index % 3000));
+
+	return Length;
+}
+
+static void TestCheckRecord(PERSISTENT_QUEUE *Queue, size_t Index)
+{
+	char Expected[4096];
+	const void *Record;
+	UINT32 Length;
+
+	QueueTestCheck((Record = PersistentQueuePeek(Queue, &Length)) != NULL);
+	QueueTestCheck(Length == TestRecord(Expected, Index) && memcmp(Record, Expected, (size_t)Length) == 0);
+	QueueTestCheck(PersistentQueueRemove(Queue));
+}
+
+static void TestRemoveDirectory(void)
+{
+	char Path[sizeof(TestPath) + 256];
+	struct dirent *Entry;
+	DIR *Directory;
+
+	QueueTestCheck((Directory = opendir(TestPath)) != NULL);
+
+	while((Entry = readdir(Directory)) != NULL)
+	{
+		if(strcmp(Entry->d_name, ".") == 0 || strcmp(Entry->d_name, "..") == 0)
+			continue;
+
+		snprintf(Path, sizeof(Path), "%s/%s", TestPath, Entry->d_name);
+		unlink(Path);
+	}
+
+	closedir(Directory);
+	rmdir(TestPath);
+}
+
+static void TestReopen(void)
+{
+	PERSISTENT_QUEUE Queue;
+	char Buffer[4096];
+	UINT32 Length;
+	size_t i;
+
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)100, (UINT32)0) == &Queue);
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(PersistentQueuePeek(&Queue, &Length) == NULL && !PersistentQueueRemove(&Queue));
+
+	for(i = 0; i < TEST_RECORDS; i++)
+		QueueTestCheck(PersistentQueueAdd(&Queue, Buffer, TestRecord(Buffer, i)));
+
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)TEST_RECORDS);
+
+	for(i = 0; i < TEST_REMOVED; i++)
+		TestCheckRecord(&Queue, i);
+
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+
+	// Everything not removed is still there, in order.
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)0, (UINT32)0) == &Queue);
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)(TEST_RECORDS - TEST_REMOVED));
+
+	TestCheckRecord(&Queue, TEST_REMOVED);
+
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+}
+
+/*
+	A PERSISTENT_QUEUE that is never destroyed, as if its process died.
+	Adds after the checkpoint are found again, and so are the removes.
+*/
+static void TestRecover(void)
+{
+	PERSISTENT_QUEUE Crashed, Queue;
+	const char *Record;
+	char Buffer[4096];
+	unsigned long First;
+	size_t i;
+
+	QueueTestCheck(CreatePersistentQueue(&Crashed, TestPath, (UINT32)0, (UINT32)0) == &Crashed);
+	QueueTestCheck(PersistentQueueSync(&Crashed));
+
+	for(i = TEST_RECORDS; i < TEST_RECORDS + TEST_CRASHED; i++)
+		QueueTestCheck(PersistentQueueAdd(&Crashed, Buffer, TestRecord(Buffer, i)));
+
+	for(i = TEST_REMOVED + 1; i < TEST_REMOVED + 11; i++)
+		TestCheckRecord(&Crashed, i);
+
+	// Moving past a segment file checkpoints too, so some removes may stick.
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)1, (UINT32)0) == &Queue);
+	QueueTestCheck((Record = (const char*)PersistentQueuePeek(&Queue, NULL)) != NULL);
+	QueueTestCheck(sscanf(Record, "record-%lu", &First) == 1);
+	QueueTestCheck(First >= (unsigned long)(TEST_REMOVED + 1) && First <= (unsigned long)(TEST_REMOVED + 11));
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)(TEST_RECORDS + TEST_CRASHED - First));
+
+	for(i = (size_t)First; i < TEST_RECORDS + TEST_CRASHED; i++)
+		TestCheckRecord(&Queue, i);
+
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)0 && !PersistentQueueRemove(&Queue));
+
+	QueueTestCheck(PersistentQueueAdd(&Queue, "last", (UINT32)5));
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)1, (UINT32)0) == &Queue);
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)1);
+	QueueTestCheck(strcmp((const char*)PersistentQueuePeek(&Queue, NULL), "last") == 0);
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+
+	// A directory that doesn't exist can't be opened.
+	QueueTestCheck(CreatePersistentQueue((PERSISTENT_QUEUE*)NULL, "/tmp/QueueTestPersistent.missing/queue", (UINT32)0, (UINT32)0) == NULL);
+}
+
+/*
+	Adds succeed while syncing fails, PersistentQueueSync() is what
+	reports it.  The segments the head leaves meanwhile stay until
+	a sync works again.
+*/
+static void TestSyncFailure(void)
+{
+	PERSISTENT_QUEUE Queue;
+	char Buffer[4096], Blocker[sizeof(TestPath) + 32], Name[sizeof(TestPath) + 32];
+	size_t i;
+
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)1, (UINT32)0) == &Queue);
+	QueueTestCheck(PersistentQueueRemove(&Queue) && PersistentQueueGetSize(&Queue) == (UINT32)0);
+
+	snprintf(Blocker, sizeof(Blocker), "%s/checkpoint.tmp", TestPath);
+	QueueTestCheck(mkdir(Blocker, 0700) == 0);
+
+	for(i = 0; i < TEST_UNSYNCED; i++)
+		QueueTestCheck(PersistentQueueAdd(&Queue, Buffer, TestRecord(Buffer, TEST_RECORDS + i)));
+
+	QueueTestCheck(!PersistentQueueSync(&Queue));
+	QueueTestCheck(Queue.TailSegment != Queue.HeadSegment);
+
+	snprintf(Name, sizeof(Name), "%s/%08lX.seg", TestPath, (unsigned long)Queue.HeadSegment);
+
+	for(i = 0; i < TEST_UNSYNCED; i++)
+		TestCheckRecord(&Queue, TEST_RECORDS + i);
+
+	QueueTestCheck(access(Name, F_OK) == 0);
+
+	// The next sync that works retires every segment the head left.
+	QueueTestCheck(rmdir(Blocker) == 0);
+	QueueTestCheck(PersistentQueueSync(&Queue));
+	QueueTestCheck(access(Name, F_OK) != 0);
+
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+
+	QueueTestCheck(CreatePersistentQueue(&Queue, TestPath, (UINT32)1, (UINT32)0) == &Queue);
+	QueueTestCheck(PersistentQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(DestroyPersistentQueue(&Queue));
+}
+
+int main(void)
+{
+	QueueTestCheck(mkdtemp(TestPath) != NULL);
+
+	TestReopen();
+	TestRecover();
+	TestSyncFailure();
+	TestRemoveDirectory();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,312 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestPool.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the linked QUEUE on top of the node pool, and on top of the
+	per thread node caches when built with USING_QUEUE_NODE_CACHE.
+	Every node taken from the pool has to find its way back to it, and
+	removing keeps the idle nodes within QUEUE_NODE_POOL_MAX_FREE_NODES.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_NODE_POOL == 0 || USING_QUEUE_BLOCKING_METHODS == 0 || USE_PTHREADS == 0)
+	#error "QueueTestPool needs USING_QUEUE_NODE_POOL, USING_QUEUE_BLOCKING_METHODS and USE_PTHREADS."
+#endif // end of USING_QUEUE_NODE_POOL || USING_QUEUE_BLOCKING_METHODS || USE_PTHREADS
+
+#define TEST_ITEMS										10000
+#define TEST_THREADS									4
+#define TEST_STRESS_ITEMS								50000
+#define TEST_STRESS_ROUNDS								3
+
+static QUEUE StressQueue;
+static size_t StressRemoved;
+static size_t StressSum;
+
+#if (USING_QUEUE_NODE_CACHE == 1)
+	static BOOL IdleDone, IdleFinish;
+#endif // end of USING_QUEUE_NODE_CACHE
+
+/*
+	Hands the nodes of the calling thread's node cache back to the pool.
+*/
+static void TestReleaseCache(void)
+{
+	#if (USING_QUEUE_NODE_CACHE == 1)
+		QueueNodeCacheRelease();
+	#endif // end of USING_QUEUE_NODE_CACHE
+}
+
+static void TestCheckAllNodesFree(void)
+{
+	QUEUE_NODE_POOL_STATS Stats;
+
+	QueueTestCheck(QueueNodePoolGetStats(&Stats));
+	QueueTestCheck(Stats.FreeNodes == Stats.TotalNodes);
+}
+
+static void TestSingleThread(void)
+{
+	QUEUE_NODE_POOL_STATS Stats;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueNodePoolGetStats(&Stats));
+	QueueTestCheck(Stats.TotalNodes >= (UINT32)TEST_ITEMS && Stats.PeakNodesInUse >= (UINT32)TEST_ITEMS);
+	QueueTestCheck(Stats.Slabs > (UINT32)0);
+
+	// Nodes in use keep their slabs.
+	for(i = 0; i < TEST_ITEMS / 2; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	TestReleaseCache();
+
+	QueueNodePoolShrink((UINT32)0);
+
+	QueueTestCheck(QueueNodePoolGetStats(&Stats));
+	QueueTestCheck(Stats.TotalNodes - Stats.FreeNodes == (UINT32)(TEST_ITEMS / 2));
+
+	for(i = TEST_ITEMS / 2; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	// The same nodes are used again.
+	for(i = 0; i < 100; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)0);
+
+	TestReleaseCache();
+	TestCheckAllNodesFree();
+
+	QueueNodePoolShrink((UINT32)0);
+
+	QueueTestCheck(QueueNodePoolGetStats(&Stats));
+	QueueTestCheck(Stats.Slabs == (UINT32)0 && Stats.TotalNodes == (UINT32)0);
+	QueueTestCheck(Stats.SlabReleases == Stats.SlabAllocations);
+}
+
+static void TestCheckCap(void)
+{
+	QUEUE_NODE_POOL_STATS Stats;
+
+	QueueTestCheck(QueueNodePoolGetStats(&Stats));
+	QueueTestCheck(Stats.FreeNodes < (UINT32)(QUEUE_NODE_POOL_MAX_FREE_NODES + QUEUE_NODE_POOL_SLAB_SIZE));
+}
+
+/*
+	Removing one at a time or in batches gives slabs back as soon as
+	a whole slab's worth of idle nodes is over the cap.
+*/
+static void TestCap(void)
+{
+	QUEUE_NODE_POOL_STATS Before, After;
+	QUEUE Queue;
+	void *Items[100];
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueNodePoolGetStats(&Before));
+
+	for(i = 0; i < TEST_ITEMS; i++)
+	{
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+		if(i % 100 == 0)
+			TestCheckCap();
+	}
+
+	TestReleaseCache();
+	TestCheckCap();
+
+	QueueTestCheck(QueueNodePoolGetStats(&After));
+	QueueTestCheck(After.SlabReleases > Before.SlabReleases);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	for(i = 0; i < TEST_ITEMS; i += 100)
+	{
+		QueueTestCheck(QueueRemoveBatch(&Queue, Items, (UINT32)100) == (UINT32)100);
+		QueueTestCheck(Items[0] == QueueTestData(i) && Items[99] == QueueTestData(i + 99));
+
+		TestCheckCap();
+	}
+
+	TestReleaseCache();
+	TestCheckCap();
+	TestCheckAllNodesFree();
+
+	QueueNodePoolShrink((UINT32)0);
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t i;
+
+	(void)Argument;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		// Keep the QUEUE short so nodes keep moving between threads.
+		while(QueueGetSize(&StressQueue) > (UINT32)500)
+			sched_yield();
+
+		QueueTestCheck(QueueAdd(&StressQueue, QueueTestData(i)));
+	}
+
+	TestReleaseCache();
+
+	return NULL;
+}
+
+static void *TestConsumer(void *Argument)
+{
+	void *Data;
+
+	(void)Argument;
+
+	while(__atomic_load_n(&StressRemoved, __ATOMIC_ACQUIRE) < (size_t)TEST_THREADS * TEST_STRESS_ITEMS)
+	{
+		if((Data = QueueRemove(&StressQueue)) != NULL)
+		{
+			__atomic_add_fetch(&StressSum, QueueTestValue(Data), __ATOMIC_RELAXED);
+			__atomic_add_fetch(&StressRemoved, (size_t)1, __ATOMIC_RELEASE);
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	TestReleaseCache();
+
+	return NULL;
+}
+
+/*
+	Producers and consumers on different threads, so with node caches
+	every node is freed on another thread than the one it came from.
+*/
+static void TestThreads(void)
+{
+	pthread_t Threads[2 * TEST_THREADS];
+	UINT32 Round, i;
+
+	QueueTestCheck(CreateQueue(&StressQueue, (void(*)(void*))NULL) == &StressQueue);
+
+	for(Round = (UINT32)0; Round < (UINT32)TEST_STRESS_ROUNDS; Round++)
+	{
+		StressRemoved = StressSum = 0;
+
+		for(i = (UINT32)0; i < (UINT32)TEST_THREADS; i++)
+		{
+			QueueTestStartThread(&Threads[i], TestProducer, NULL);
+			QueueTestStartThread(&Threads[TEST_THREADS + i], TestConsumer, NULL);
+		}
+
+		for(i = (UINT32)0; i < (UINT32)(2 * TEST_THREADS); i++)
+			pthread_join(Threads[i], NULL);
+
+		QueueTestCheck(StressSum == (size_t)TEST_THREADS * ((size_t)TEST_STRESS_ITEMS * (TEST_STRESS_ITEMS - 1) / 2));
+		QueueTestCheck(QueueGetSize(&StressQueue) == (UINT32)0);
+
+		TestCheckAllNodesFree();
+	}
+
+	QueueNodePoolShrink((UINT32)0);
+	TestCheckAllNodesFree();
+}
+
+#if (USING_QUEUE_NODE_CACHE == 1)
+static void *TestIdler(void *Argument)
+{
+	size_t i;
+
+	for(i = 0; i < QUEUE_NODE_CACHE_BATCH / 2; i++)
+		QueueTestCheck(QueueRemove((QUEUE*)Argument) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove((QUEUE*)Argument) == NULL);
+
+	__atomic_store_n(&IdleDone, (BOOL)TRUE, __ATOMIC_RELEASE);
+
+	// Stay alive with the cache, as a consumer waiting for more would.
+	while(!__atomic_load_n(&IdleFinish, __ATOMIC_ACQUIRE))
+		sched_yield();
+
+	TestReleaseCache();
+
+	return NULL;
+}
+
+/*
+	A consumer that frees fewer than QUEUE_NODE_CACHE_BATCH nodes and
+	then finds its QUEUE empty sends them back anyway, so the producer
+	reuses them instead of going to the pool again.
+*/
+static void TestIdleConsumer(void)
+{
+	QUEUE_NODE_POOL_STATS Before, After;
+	pthread_t Thread;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	IdleDone = IdleFinish = (BOOL)FALSE;
+
+	// The first add takes one batch from the pool.
+	for(i = 0; i < QUEUE_NODE_CACHE_BATCH / 2; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueNodePoolGetStats(&Before));
+
+	QueueTestStartThread(&Thread, TestIdler, &Queue);
+
+	while(!__atomic_load_n(&IdleDone, __ATOMIC_ACQUIRE))
+		sched_yield();
+
+	// The rest of the batch and then the nodes the consumer sent back.
+	for(i = 0; i < QUEUE_NODE_CACHE_BATCH; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueNodePoolGetStats(&After));
+	QueueTestCheck(After.FreeNodes == Before.FreeNodes);
+
+	__atomic_store_n(&IdleFinish, (BOOL)TRUE, __ATOMIC_RELEASE);
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(QueueClear(&Queue));
+
+	TestReleaseCache();
+	TestCheckAllNodesFree();
+}
+#endif // end of USING_QUEUE_NODE_CACHE
+
+int main(void)
+{
+	TestSingleThread();
+	TestCap();
+	TestThreads();
+
+	#if (USING_QUEUE_NODE_CACHE == 1)
+		TestIdleConsumer();
+	#endif // end of USING_QUEUE_NODE_CACHE
+
+	return EXIT_SUCCESS;
+}
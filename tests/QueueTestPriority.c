@@ -0,0 +1,147 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestPriority.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreatePriorityQueue(), the order it removes
+	data in, FIFO among equal priorities, growing the heap, the batch
+	methods and freeing what is left.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_PRIORITY == 0)
+	#error "QueueTestPriority needs USING_QUEUE_PRIORITY."
+#endif // end of USING_QUEUE_PRIORITY
+
+#define TEST_ITEMS										1000
+#define TEST_PRIORITIES									7
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+/*
+	Adds far more than the starting capacity with few distinct
+	priorities, so most entries tie with others.
+*/
+static void TestOrder(void)
+{
+	static UINT32 Priorities[TEST_ITEMS];
+	UINT32 Seed, Priority, Last, Seen[TEST_PRIORITIES];
+	QUEUE Queue;
+	size_t i, Index;
+
+	QueueTestCheck(CreatePriorityQueue(&Queue, (UINT32)2, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueuePeek(&Queue) == NULL);
+
+	for(Seed = (UINT32)12345, i = 0; i < TEST_ITEMS; i++)
+	{
+		Seed = Seed * (UINT32)1103515245 + (UINT32)12345;
+		Priorities[i] = (Seed >> 16) % (UINT32)TEST_PRIORITIES;
+
+		QueueTestCheck(QueueAddWithPriority(&Queue, QueueTestData(i), Priorities[i]));
+	}
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)TEST_ITEMS);
+
+	memset(Seen, 0, sizeof(Seen));
+
+	for(Last = (UINT32)TEST_PRIORITIES, i = 0; i < TEST_ITEMS; i++)
+	{
+		QueueTestCheck(QueuePeek(&Queue) != NULL);
+
+		Index = QueueTestValue(QueueRemove(&Queue));
+		Priority = Priorities[Index];
+
+		// Highest first, and in the order they were added within one priority.
+		QueueTestCheck(Priority <= Last);
+		QueueTestCheck((UINT32)(Index + 1) > Seen[Priority]);
+
+		Last = Priority;
+		Seen[Priority] = (UINT32)(Index + 1);
+	}
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(DestroyPriorityQueue(&Queue));
+}
+
+/*
+	QueueAdd() adds at priority 0, behind everything higher and in
+	order among itself.
+*/
+static void TestFifo(void)
+{
+	void *Removed[4];
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreatePriorityQueue(&Queue, (UINT32)4, (void(*)(void*))NULL) == &Queue);
+
+	for(i = 0; i < 8; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueAddWithPriority(&Queue, QueueTestData(100), (UINT32)1));
+	QueueTestCheck(QueueAddWithPriority(&Queue, QueueTestData(101), (UINT32)1));
+
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(100));
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(101));
+
+	QueueTestCheck(QueueRemoveBatch(&Queue, Removed, (UINT32)4) == (UINT32)4);
+
+	for(i = 0; i < 4; i++)
+		QueueTestCheck(Removed[i] == QueueTestData(i));
+
+	for(i = 4; i < 8; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(DestroyPriorityQueue(&Queue));
+}
+
+static void TestFreeing(void)
+{
+	QUEUE Queue, Linked, *Heap;
+	size_t i;
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(CreatePriorityQueue(&Queue, (UINT32)1, TestFree) == &Queue);
+
+	for(i = 0; i < 5; i++)
+		QueueTestCheck(QueueAddWithPriority(&Queue, QueueTestData(i), (UINT32)i));
+
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)5 && QueueGetSize(&Queue) == (UINT32)0);
+
+	// Still usable after a clear, then whatever is left goes with the heap.
+	QueueTestCheck(QueueAddWithPriority(&Queue, QueueTestData(0), (UINT32)3));
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(1)));
+	QueueTestCheck(DestroyPriorityQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)7);
+
+	QueueTestCheck((Heap = CreatePriorityQueue((QUEUE*)NULL, (UINT32)4, (void(*)(void*))NULL)) != NULL);
+	QueueTestCheck(DestroyPriorityQueue(Heap));
+	QueueMemDealloc(Heap);
+
+	// Only a priority QUEUE takes a priority or can be destroyed as one.
+	QueueTestCheck(CreateQueue(&Linked, (void(*)(void*))NULL) == &Linked);
+	QueueTestCheck(!QueueAddWithPriority(&Linked, QueueTestData(0), (UINT32)1));
+	QueueTestCheck(!DestroyPriorityQueue(&Linked));
+}
+
+int main(void)
+{
+	TestOrder();
+	TestFifo();
+	TestFreeing();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestRecord.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the RECORD_QUEUE, on one thread and with a producer writing
+	records of every length while a consumer reads them back in place.
+*/
+
+#include <stdint.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_RECORD == 0)
+	#error "QueueTestRecord needs USING_QUEUE_RECORD."
+#endif // end of USING_QUEUE_RECORD
+
+#define TEST_SIZE										1000
+#define TEST_STRESS_RECORDS								200000
+#define TEST_MAX_LENGTH									300
+
+/*
+	The length and contents of record Index.
+*/
+#define TestLength(Index)								((UINT32)(((Index) * 7919) % TEST_MAX_LENGTH))
+#define TestByte(Index, Offset)							((BYTE)((Index) + (Offset)))
+
+static void TestSingleThread(void)
+{
+	RECORD_QUEUE Queue, *Heap;
+	UINT32 Length;
+	BYTE *Record;
+
+	// The size is rounded up to a power of two.
+	QueueTestCheck(CreateRecordQueue(&Queue, (UINT32)TEST_SIZE) == &Queue);
+
+	QueueTestCheck(RecordQueuePeek(&Queue, &Length) == NULL);
+	QueueTestCheck(!RecordQueueRelease(&Queue));
+	QueueTestCheck(!RecordQueueCommit(&Queue, (UINT32)1));
+
+	// No record may take more than half of the buffer, header included.
+	QueueTestCheck(RecordQueueReserve(&Queue, (UINT32)(512 - 8 + 1)) == NULL);
+	QueueTestCheck((Record = (BYTE*)RecordQueueReserve(&Queue, (UINT32)(512 - 8))) != NULL);
+	QueueTestCheck(((uintptr_t)Record & 7) == 0);
+
+	// A commit may be shorter than the reservation, never longer.
+	QueueTestCheck(!RecordQueueCommit(&Queue, (UINT32)(512 - 7)));
+
+	memcpy(Record, "abc", 3);
+
+	QueueTestCheck(RecordQueueCommit(&Queue, (UINT32)3));
+	QueueTestCheck(RecordQueueGetSize(&Queue) == (UINT32)1);
+
+	QueueTestCheck((Record = (BYTE*)RecordQueuePeek(&Queue, &Length)) != NULL);
+	QueueTestCheck(Length == (UINT32)3 && memcmp(Record, "abc", 3) == 0);
+	QueueTestCheck(RecordQueueRelease(&Queue));
+	QueueTestCheck(RecordQueueGetSize(&Queue) == (UINT32)0 && RecordQueuePeek(&Queue, NULL) == NULL);
+
+	// Empty records are records too.
+	QueueTestCheck(RecordQueueReserve(&Queue, (UINT32)0) != NULL && RecordQueueCommit(&Queue, (UINT32)0));
+	QueueTestCheck(RecordQueuePeek(&Queue, &Length) != NULL && Length == (UINT32)0);
+	QueueTestCheck(RecordQueueRelease(&Queue));
+
+	QueueTestCheck(DestroyRecordQueue(&Queue));
+
+	QueueTestCheck((Heap = CreateRecordQueue((RECORD_QUEUE*)NULL, (UINT32)64)) != NULL);
+	QueueTestCheck(DestroyRecordQueue(Heap));
+
+	QueueMemDealloc(Heap);
+}
+
+static void *TestProducer(void *Argument)
+{
+	RECORD_QUEUE *Queue;
+	UINT32 i, j;
+	BYTE *Record;
+
+	Queue = (RECORD_QUEUE*)Argument;
+
+	for(i = (UINT32)0; i < (UINT32)TEST_STRESS_RECORDS; i++)
+	{
+		// Reserve a little more than is committed.
+		while((Record = (BYTE*)RecordQueueReserve(Queue, TestLength(i) + (UINT32)8)) == NULL)
+			sched_yield();
+
+		QueueTestCheck(((uintptr_t)Record & 7) == 0);
+
+		for(j = (UINT32)0; j < TestLength(i); j++)
+			Record[j] = TestByte(i, j);
+
+		QueueTestCheck(RecordQueueCommit(Queue, TestLength(i)));
+	}
+
+	return NULL;
+}
+
+static void TestThreads(void)
+{
+	RECORD_QUEUE Queue;
+	pthread_t Thread;
+	UINT32 Length, i, j;
+	BYTE *Record;
+
+	QueueTestCheck(CreateRecordQueue(&Queue, (UINT32)TEST_SIZE) == &Queue);
+
+	QueueTestStartThread(&Thread, TestProducer, &Queue);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_STRESS_RECORDS; i++)
+	{
+		while((Record = (BYTE*)RecordQueuePeek(&Queue, &Length)) == NULL)
+			sched_yield();
+
+		QueueTestCheck(Length == TestLength(i));
+
+		for(j = (UINT32)0; j < Length; j++)
+			QueueTestCheck(Record[j] == TestByte(i, j));
+
+		QueueTestCheck(RecordQueueRelease(&Queue));
+	}
+
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(RecordQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(DestroyRecordQueue(&Queue));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestRing.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreateRingQueue(), on its own and with the
+	blocking methods waiting for room and for data.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_RING_BUFFER == 0 || USING_QUEUE_BLOCKING_METHODS == 0)
+	#error "QueueTestRing needs USING_QUEUE_RING_BUFFER and USING_QUEUE_BLOCKING_METHODS."
+#endif // end of USING_QUEUE_RING_BUFFER || USING_QUEUE_BLOCKING_METHODS
+
+#define TEST_CAPACITY									8
+#define TEST_STRESS_ITEMS								100000
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestSingleThread(void)
+{
+	QUEUE Queue, Linked;
+	size_t i, Round;
+
+	// The capacity is rounded up to a power of two.
+	QueueTestCheck(CreateRingQueue(&Queue, (UINT32)(TEST_CAPACITY - 3), TestFree) == &Queue);
+
+	for(Round = 0; Round < 5; Round++)
+	{
+		for(i = 0; i < TEST_CAPACITY; i++)
+			QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+		QueueTestCheck(QueueIsFull((&Queue)));
+		QueueTestCheck(!QueueAdd(&Queue, QueueTestData(TEST_CAPACITY)));
+
+		for(i = 0; i < TEST_CAPACITY / 2; i++)
+		{
+			QueueTestCheck(QueuePeek(&Queue) == QueueTestData(i));
+			QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+		}
+
+		// Wraps around the end of the array.
+		for(i = TEST_CAPACITY; i < TEST_CAPACITY + TEST_CAPACITY / 2; i++)
+			QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+		for(i = TEST_CAPACITY / 2; i < TEST_CAPACITY + TEST_CAPACITY / 2; i++)
+			QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+		QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)0);
+	}
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(0)) && QueueAdd(&Queue, QueueTestData(1)));
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)2 && QueueGetSize(&Queue) == (UINT32)0);
+
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(0)));
+	QueueTestCheck(DestroyRingQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)3);
+
+	// Only a ring QUEUE can be destroyed as one.
+	QueueTestCheck(CreateQueue(&Linked, (void(*)(void*))NULL) == &Linked);
+	QueueTestCheck(!DestroyRingQueue(&Linked));
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t i;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(QueueAddWait((QUEUE*)Argument, QueueTestData(i), (UINT32)QUEUE_WAIT_FOREVER));
+
+	return NULL;
+}
+
+/*
+	A producer far ahead of the consumer has to wait for room.
+*/
+static void TestThreads(void)
+{
+	pthread_t Thread;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateRingQueue(&Queue, (UINT32)TEST_CAPACITY, (void(*)(void*))NULL) == &Queue);
+
+	QueueTestStartThread(&Thread, TestProducer, &Queue);
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)QUEUE_WAIT_FOREVER) == QueueTestData(i));
+
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)0) == NULL);
+
+	for(i = 0; i < TEST_CAPACITY; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(!QueueAddWait(&Queue, QueueTestData(TEST_CAPACITY), (UINT32)20));
+
+	QueueTestCheck(QueueClose(&Queue));
+	QueueTestCheck(!QueueAdd(&Queue, QueueTestData(0)));
+	QueueTestCheck(DestroyRingQueue(&Queue));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestSegmented.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the linked QUEUE with USING_QUEUE_SEGMENTED_NODES, built with
+	a small QUEUE_SEGMENT_SIZE so every check crosses many segments.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_SEGMENTED_NODES == 0 || USING_QUEUE_ALLOCATION_COUNTERS == 0 || USING_QUEUE_BOUNDED == 0)
+	#error "QueueTestSegmented needs USING_QUEUE_SEGMENTED_NODES, USING_QUEUE_ALLOCATION_COUNTERS and USING_QUEUE_BOUNDED."
+#endif // end of USING_QUEUE_SEGMENTED_NODES || USING_QUEUE_ALLOCATION_COUNTERS || USING_QUEUE_BOUNDED
+
+#define TEST_ITEMS										(QUEUE_SEGMENT_SIZE * 50 + 3)
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestOrder(void)
+{
+	QUEUE Queue;
+	size_t Added, Removed, Round;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueuePeek(&Queue) == NULL);
+
+	// Uneven runs of adds and removes leave the head and tail in every slot.
+	for(Added = Removed = 0, Round = 1; Round < 40; Round++)
+	{
+		while(Added < Removed + Round * 3)
+			QueueTestCheck(QueueAdd(&Queue, QueueTestData(Added++)));
+
+		while(Removed < Added - Round)
+		{
+			QueueTestCheck(QueuePeek(&Queue) == QueueTestData(Removed));
+			QueueTestCheck(QueueRemove(&Queue) == QueueTestData(Removed++));
+		}
+
+		QueueTestCheck(QueueGetSize(&Queue) == (UINT32)(Added - Removed));
+	}
+
+	while(Removed < Added)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(Removed++));
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)0);
+}
+
+static void TestAllocations(void)
+{
+	QUEUE_ALLOCATION_STATS Stats;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	QueueResetAllocationStats();
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	// One allocation per segment, not per item.
+	QueueTestCheck(QueueGetAllocationStats(&Stats));
+	QueueTestCheck(Stats.Allocations == (UINT32)((TEST_ITEMS + QUEUE_SEGMENT_SIZE - 1) / QUEUE_SEGMENT_SIZE));
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueGetAllocationStats(&Stats));
+	QueueTestCheck(Stats.Deallocations == Stats.Allocations);
+}
+
+/*
+	A head segment that was partly removed from is cleared too.
+*/
+static void TestClear(void)
+{
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, TestFree) == &Queue);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(0));
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)(TEST_ITEMS - 1) && QueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	// Still usable afterwards.
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(1)) && QueueRemove(&Queue) == QueueTestData(1));
+}
+
+static void TestBatch(void)
+{
+	const void *In[QUEUE_SEGMENT_SIZE * 3];
+	void *Out[QUEUE_SEGMENT_SIZE * 2], **Drained;
+	QUEUE Queue;
+	UINT32 Count, i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	for(i = (UINT32)0; i < (UINT32)(QUEUE_SEGMENT_SIZE * 3); i++)
+		In[i] = QueueTestData(i);
+
+	// The batch starts in the middle of the tail segment.
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(0)));
+	QueueTestCheck(QueueAddBatch(&Queue, In, (UINT32)(QUEUE_SEGMENT_SIZE * 3)));
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)(QUEUE_SEGMENT_SIZE * 3 + 1));
+
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(0));
+	QueueTestCheck(QueueRemoveBatch(&Queue, Out, (UINT32)(QUEUE_SEGMENT_SIZE * 2)) == (UINT32)(QUEUE_SEGMENT_SIZE * 2));
+
+	for(i = (UINT32)0; i < (UINT32)(QUEUE_SEGMENT_SIZE * 2); i++)
+		QueueTestCheck(Out[i] == QueueTestData(i));
+
+	Drained = QueueDrain(&Queue, &Count);
+
+	QueueTestCheck(Drained != NULL && Count == (UINT32)QUEUE_SEGMENT_SIZE);
+
+	for(i = (UINT32)0; i < Count; i++)
+		QueueTestCheck(Drained[i] == QueueTestData(QUEUE_SEGMENT_SIZE * 2 + i));
+
+	QueueMemDealloc(Drained);
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)0 && QueueRemove(&Queue) == NULL);
+	QueueTestCheck(QueueDrain(&Queue, &Count) == NULL && Count == (UINT32)0);
+}
+
+/*
+	Dropping the oldest data keeps the newest across segment boundaries.
+*/
+static void TestDropOldest(void)
+{
+	QUEUE Queue;
+	size_t i;
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(CreateBoundedQueue(&Queue, (UINT32)(QUEUE_SEGMENT_SIZE + 3), (BYTE)QUEUE_OVERFLOW_DROP_OLDEST, TestFree) == &Queue);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)(QUEUE_SEGMENT_SIZE + 3));
+	QueueTestCheck(QueueGetDropCount(&Queue) == (UINT32)(TEST_ITEMS - QUEUE_SEGMENT_SIZE - 3));
+	QueueTestCheck(TestFreed == QueueGetDropCount(&Queue));
+
+	for(i = TEST_ITEMS - QUEUE_SEGMENT_SIZE - 3; i < TEST_ITEMS; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+}
+
+int main(void)
+{
+	TestOrder();
+	TestAllocations();
+	TestClear();
+	TestBatch();
+	TestDropOldest();
+
+	return EXIT_SUCCESS;
+}
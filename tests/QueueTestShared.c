@@ -0,0 +1,173 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestShared.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the SHARED_QUEUE, in this process and with forked producer
+	and consumer processes using it at the same time.  The shared
+	memory objects are named after the process id, so tests running
+	at the same time don't meet.
+*/
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_SHARED == 0)
+	#error "QueueTestShared needs USING_QUEUE_SHARED."
+#endif // end of USING_QUEUE_SHARED
+
+#define TEST_CAPACITY									4
+#define TEST_PRODUCERS									3
+#define TEST_STRESS_MESSAGES							20000
+
+static char TestName[QUEUE_SHARED_MAX_NAME];
+
+static void TestSingleProcess(void)
+{
+	SHARED_QUEUE Queue, Other, Reader;
+	char Message[16], Copy[16];
+	UINT32 Length, Position, i;
+	void *Slot;
+
+	UnlinkSharedQueue(TestName);
+
+	QueueTestCheck(CreateSharedQueue(&Queue, TestName, (UINT32)(TEST_CAPACITY - 1), (UINT32)sizeof(Message)) == &Queue);
+	QueueTestCheck(SharedQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(!SharedQueueRemove(&Queue, Copy, &Length, (UINT32)0));
+
+	// Messages longer than a slot are refused.
+	QueueTestCheck(!SharedQueueAdd(&Queue, Message, (UINT32)(sizeof(Message) + 1), (UINT32)0));
+
+	for(i = (UINT32)0; i < (UINT32)TEST_CAPACITY; i++)
+	{
+		sprintf(Message, "message %u", i);
+
+		QueueTestCheck(SharedQueueAdd(&Queue, Message, (UINT32)strlen(Message) + (UINT32)1, (UINT32)0));
+	}
+
+	QueueTestCheck(SharedQueueGetSize(&Queue) == (UINT32)TEST_CAPACITY);
+	QueueTestCheck(!SharedQueueAdd(&Queue, Message, (UINT32)1, (UINT32)10));
+
+	// A live SHARED_QUEUE is never replaced, only opened.
+	QueueTestCheck(CreateSharedQueue(&Other, TestName, (UINT32)TEST_CAPACITY, (UINT32)sizeof(Message)) == NULL);
+	QueueTestCheck(OpenSharedQueue(&Reader, TestName) == &Reader);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_CAPACITY; i++)
+	{
+		sprintf(Message, "message %u", i);
+
+		if(i % 2)
+		{
+			QueueTestCheck(SharedQueueRemove(&Reader, Copy, &Length, (UINT32)0));
+			QueueTestCheck(Length == (UINT32)strlen(Message) + (UINT32)1 && strcmp(Copy, Message) == 0);
+		}
+		else
+		{
+			QueueTestCheck((Slot = SharedQueueAcquire(&Reader, &Position, &Length, (UINT32)0)) != NULL);
+			QueueTestCheck(strcmp((const char*)Slot, Message) == 0);
+			QueueTestCheck(SharedQueueRelease(&Reader, Position));
+		}
+	}
+
+	QueueTestCheck(SharedQueueAcquire(&Reader, &Position, &Length, (UINT32)10) == NULL);
+
+	// Written in place.
+	QueueTestCheck((Slot = SharedQueueReserve(&Queue, &Position, (UINT32)0)) != NULL);
+
+	memcpy(Slot, "in place", 9);
+
+	QueueTestCheck(SharedQueueCommit(&Queue, Position, (UINT32)9));
+	QueueTestCheck(SharedQueueRemove(&Reader, Copy, &Length, (UINT32)0) && Length == (UINT32)9 && strcmp(Copy, "in place") == 0);
+
+	QueueTestCheck(DestroySharedQueue(&Reader));
+	QueueTestCheck(DestroySharedQueue(&Queue));
+	QueueTestCheck(OpenSharedQueue(&Reader, TestName) == NULL);
+	QueueTestCheck(!UnlinkSharedQueue(TestName));
+}
+
+/*
+	Runs in a child process, exits instead of returning.
+*/
+static void TestProducer(UINT32 First)
+{
+	SHARED_QUEUE Queue;
+	UINT32 Position, i, *Slot;
+
+	QueueTestCheck(OpenSharedQueue(&Queue, TestName) == &Queue);
+
+	for(i = First; i < First + (UINT32)TEST_STRESS_MESSAGES; i++)
+	{
+		if(i % 2)
+		{
+			QueueTestCheck(SharedQueueAdd(&Queue, &i, (UINT32)sizeof(i), (UINT32)QUEUE_WAIT_FOREVER));
+		}
+		else
+		{
+			QueueTestCheck((Slot = (UINT32*)SharedQueueReserve(&Queue, &Position, (UINT32)QUEUE_WAIT_FOREVER)) != NULL);
+
+			*Slot = i;
+
+			QueueTestCheck(SharedQueueCommit(&Queue, Position, (UINT32)sizeof(i)));
+		}
+	}
+
+	DestroySharedQueue(&Queue);
+
+	_exit(EXIT_SUCCESS);
+}
+
+static void TestProcesses(void)
+{
+	SHARED_QUEUE Queue;
+	UINT8 *Seen;
+	UINT32 Value, Length, i;
+	pid_t Child;
+	int Status;
+
+	QueueTestCheck(CreateSharedQueue(&Queue, TestName, (UINT32)TEST_CAPACITY, (UINT32)sizeof(UINT32)) == &Queue);
+	QueueTestCheck((Seen = (UINT8*)calloc((size_t)(TEST_PRODUCERS * TEST_STRESS_MESSAGES), 1)) != NULL);
+
+	for(i = (UINT32)0; i < (UINT32)TEST_PRODUCERS; i++)
+	{
+		QueueTestCheck((Child = fork()) >= 0);
+
+		if(Child == 0)
+			TestProducer(i * (UINT32)TEST_STRESS_MESSAGES);
+	}
+
+	for(i = (UINT32)0; i < (UINT32)(TEST_PRODUCERS * TEST_STRESS_MESSAGES); i++)
+	{
+		QueueTestCheck(SharedQueueRemove(&Queue, &Value, &Length, (UINT32)QUEUE_WAIT_FOREVER));
+		QueueTestCheck(Length == (UINT32)sizeof(Value) && Value < (UINT32)(TEST_PRODUCERS * TEST_STRESS_MESSAGES));
+		QueueTestCheck(!Seen[Value]);
+
+		Seen[Value] = (UINT8)1;
+	}
+
+	for(i = (UINT32)0; i < (UINT32)TEST_PRODUCERS; i++)
+	{
+		QueueTestCheck(wait(&Status) > 0);
+		QueueTestCheck(WIFEXITED(Status) && WEXITSTATUS(Status) == EXIT_SUCCESS);
+	}
+
+	QueueTestCheck(SharedQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(DestroySharedQueue(&Queue));
+
+	free(Seen);
+}
+
+int main(void)
+{
+	snprintf(TestName, sizeof(TestName), "/QueueTestShared.%ld", (long)getpid());
+
+	TestSingleProcess();
+	TestProcesses();
+
+	return EXIT_SUCCESS;
+}
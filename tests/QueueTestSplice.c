@@ -0,0 +1,237 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestSplice.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests QueueAppendQueue(), QueueSwap() and QueueSplitAfter().  It is
+	built once with ring and bounded QUEUE's and the blocking methods,
+	to check what is refused, and once with segmented nodes, to check
+	splits inside a QUEUE_NODE.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_SPLICE_METHODS == 0)
+	#error "QueueTestSplice needs USING_QUEUE_SPLICE_METHODS."
+#endif // end of USING_QUEUE_SPLICE_METHODS
+
+#define TEST_ITEMS										20
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestFill(QUEUE *Queue, size_t First, size_t Last)
+{
+	size_t i;
+
+	for(i = First; i < Last; i++)
+		QueueTestCheck(QueueAdd(Queue, QueueTestData(i)));
+}
+
+/*
+	Removes everything, checking it holds First to Last in order.
+*/
+static void TestExpect(QUEUE *Queue, size_t First, size_t Last)
+{
+	size_t i;
+
+	QueueTestCheck(QueueGetSize(Queue) == (UINT32)(Last - First));
+
+	for(i = First; i < Last; i++)
+		QueueTestCheck(QueueRemove(Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemove(Queue) == NULL && QueueIsEmpty(Queue));
+}
+
+static void TestAppend(void)
+{
+	QUEUE Destination, Source;
+
+	QueueTestCheck(CreateQueue(&Destination, (void(*)(void*))NULL) == &Destination);
+	QueueTestCheck(CreateQueue(&Source, (void(*)(void*))NULL) == &Source);
+
+	TestFill(&Destination, 0, 5);
+	TestFill(&Source, 5, TEST_ITEMS);
+
+	QueueTestCheck(QueueAppendQueue(&Destination, &Source));
+	QueueTestCheck(QueueIsEmpty((&Source)) && QueueRemove(&Source) == NULL);
+
+	// Both ends keep working, the appended nodes are Destination's now.
+	QueueTestCheck(QueueAdd(&Destination, QueueTestData(TEST_ITEMS)));
+	TestExpect(&Destination, 0, TEST_ITEMS + 1);
+
+	// An empty source changes nothing, an empty destination takes everything.
+	TestFill(&Destination, 0, 3);
+	QueueTestCheck(QueueAppendQueue(&Destination, &Source));
+	QueueTestCheck(QueueAppendQueue(&Source, &Destination));
+	QueueTestCheck(QueueIsEmpty((&Destination)));
+	QueueTestCheck(QueueAdd(&Source, QueueTestData(3)));
+	TestExpect(&Source, 0, 4);
+
+	QueueTestCheck(QueueAppendQueue(&Destination, &Source));
+	QueueTestCheck(QueueIsEmpty((&Destination)) && QueueIsEmpty((&Source)));
+}
+
+static void TestSwap(void)
+{
+	QUEUE First, Second;
+
+	QueueTestCheck(CreateQueue(&First, (void(*)(void*))NULL) == &First);
+	QueueTestCheck(CreateQueue(&Second, (void(*)(void*))NULL) == &Second);
+
+	TestFill(&First, 0, 3);
+	TestFill(&Second, 3, TEST_ITEMS);
+
+	QueueTestCheck(QueueSwap(&First, &Second));
+	QueueTestCheck(QueueGetSize(&First) == (UINT32)(TEST_ITEMS - 3) && QueueGetSize(&Second) == (UINT32)3);
+
+	QueueTestCheck(QueueAdd(&First, QueueTestData(TEST_ITEMS)));
+	TestExpect(&First, 3, TEST_ITEMS + 1);
+
+	// Swapping with an empty QUEUE moves everything across.
+	QueueTestCheck(QueueSwap(&First, &Second));
+	QueueTestCheck(QueueIsEmpty((&Second)));
+	TestExpect(&First, 0, 3);
+
+	QueueTestCheck(QueueSwap(&First, &Second));
+	QueueTestCheck(QueueIsEmpty((&First)) && QueueIsEmpty((&Second)));
+}
+
+/*
+	Split points at every offset, so with segmented nodes most of
+	them land inside a QUEUE_NODE.
+*/
+static void TestSplit(void)
+{
+	QUEUE Queue, Out;
+	UINT32 Count;
+
+	QueueTestCheck(CreateQueue(&Queue, TestFree) == &Queue);
+	QueueTestCheck(CreateQueue(&Out, TestFree) == &Out);
+
+	for(Count = (UINT32)0; Count <= (UINT32)TEST_ITEMS; Count++)
+	{
+		TestFill(&Queue, 0, TEST_ITEMS);
+		QueueTestCheck(QueueAdd(&Out, QueueTestData(TEST_ITEMS)));
+
+		QueueTestCheck(QueueSplitAfter(&Queue, Count, &Out));
+		QueueTestCheck(QueueGetSize(&Queue) == Count && QueueGetSize(&Out) == (UINT32)TEST_ITEMS - Count + (UINT32)1);
+
+		// The kept part still takes adds behind its new end.
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(Count)));
+		TestExpect(&Queue, 0, (size_t)Count + 1);
+
+		QueueTestCheck(QueueRemove(&Out) == QueueTestData(TEST_ITEMS));
+		TestExpect(&Out, (size_t)Count, TEST_ITEMS);
+	}
+
+	// Keeping more than there is moves nothing.
+	TestFill(&Queue, 0, 5);
+	QueueTestCheck(QueueSplitAfter(&Queue, (UINT32)TEST_ITEMS, &Out));
+	QueueTestCheck(QueueGetSize(&Queue) == (UINT32)5 && QueueIsEmpty((&Out)));
+
+	// Every piece of data is freed once, wherever the split left it.
+	TestFill(&Queue, 5, TEST_ITEMS);
+	QueueTestCheck(QueueSplitAfter(&Queue, (UINT32)7, &Out));
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueClear(&Queue) && QueueClear(&Out));
+	QueueTestCheck(TestFreed == (UINT32)TEST_ITEMS);
+}
+
+#if (USING_QUEUE_RING_BUFFER == 1)
+	/*
+		Rings only swap, and only with another ring.
+	*/
+	static void TestKinds(void)
+	{
+		QUEUE Linked, Other, Ring, OtherRing;
+
+		QueueTestCheck(CreateQueue(&Linked, (void(*)(void*))NULL) == &Linked);
+		QueueTestCheck(CreateQueue(&Other, (void(*)(void*))NULL) == &Other);
+		QueueTestCheck(CreateRingQueue(&Ring, (UINT32)8, (void(*)(void*))NULL) == &Ring);
+		QueueTestCheck(CreateRingQueue(&OtherRing, (UINT32)8, (void(*)(void*))NULL) == &OtherRing);
+
+		TestFill(&Linked, 0, 2);
+		TestFill(&Ring, 2, 5);
+
+		QueueTestCheck(!QueueAppendQueue(&Linked, &Ring) && !QueueAppendQueue(&Ring, &Linked));
+		QueueTestCheck(!QueueSplitAfter(&Ring, (UINT32)1, &OtherRing));
+		QueueTestCheck(!QueueSwap(&Linked, &Ring));
+		QueueTestCheck(QueueGetSize(&Linked) == (UINT32)2 && QueueGetSize(&Ring) == (UINT32)3);
+
+		QueueTestCheck(QueueSwap(&Ring, &OtherRing));
+		QueueTestCheck(QueueIsEmpty((&Ring)));
+		TestExpect(&OtherRing, 2, 5);
+
+		// A closed QUEUE takes nothing in.
+		QueueTestCheck(QueueClose(&Other));
+		QueueTestCheck(!QueueAppendQueue(&Other, &Linked) && !QueueSwap(&Linked, &Other));
+		QueueTestCheck(!QueueSplitAfter(&Linked, (UINT32)0, &Other));
+		TestExpect(&Linked, 0, 2);
+
+		QueueTestCheck(DestroyRingQueue(&Ring) && DestroyRingQueue(&OtherRing));
+	}
+#endif // end of USING_QUEUE_RING_BUFFER
+
+#if (USING_QUEUE_BOUNDED == 1)
+	/*
+		Limits stay with their QUEUE's, so nothing moves that would
+		leave one over its limit.
+	*/
+	static void TestLimits(void)
+	{
+		QUEUE Small, Large;
+
+		QueueTestCheck(CreateBoundedQueue(&Small, (UINT32)4, (BYTE)QUEUE_OVERFLOW_REJECT, (void(*)(void*))NULL) == &Small);
+		QueueTestCheck(CreateQueue(&Large, (void(*)(void*))NULL) == &Large);
+
+		TestFill(&Small, 0, 2);
+		TestFill(&Large, 2, 7);
+
+		QueueTestCheck(!QueueSwap(&Small, &Large) && !QueueSwap(&Large, &Small));
+		QueueTestCheck(!QueueAppendQueue(&Small, &Large));
+		QueueTestCheck(!QueueSplitAfter(&Large, (UINT32)2, &Small));
+		QueueTestCheck(QueueGetSize(&Small) == (UINT32)2 && QueueGetSize(&Large) == (UINT32)5);
+
+		// Exactly up to the limit is fine.
+		QueueTestCheck(QueueSplitAfter(&Large, (UINT32)3, &Small));
+		QueueTestCheck(QueueGetSize(&Small) == (UINT32)4 && !QueueAdd(&Small, QueueTestData(0)));
+
+		QueueTestCheck(QueueSwap(&Small, &Large));
+		QueueTestCheck(QueueRemove(&Large) == QueueTestData(0) && QueueRemove(&Large) == QueueTestData(1));
+		TestExpect(&Large, 5, 7);
+		TestExpect(&Small, 2, 5);
+
+		TestFill(&Large, 0, 4);
+		QueueTestCheck(QueueAppendQueue(&Small, &Large));
+		TestExpect(&Small, 0, 4);
+	}
+#endif // end of USING_QUEUE_BOUNDED
+
+int main(void)
+{
+	TestAppend();
+	TestSwap();
+	TestSplit();
+
+	#if (USING_QUEUE_RING_BUFFER == 1)
+		TestKinds();
+	#endif // end of USING_QUEUE_RING_BUFFER
+
+	#if (USING_QUEUE_BOUNDED == 1)
+		TestLimits();
+	#endif // end of USING_QUEUE_BOUNDED
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestSpsc.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the SPSC_QUEUE, on one thread and with a producer and a
+	consumer thread running without a lock.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_SPSC == 0)
+	#error "QueueTestSpsc needs USING_QUEUE_SPSC."
+#endif // end of USING_QUEUE_SPSC
+
+#define TEST_CAPACITY									16
+#define TEST_STRESS_ITEMS								500000
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestSingleThread(void)
+{
+	SPSC_QUEUE Queue, *Heap;
+	size_t i, Round;
+
+	QueueTestCheck(CreateSpscQueue(&Queue, (UINT32)(TEST_CAPACITY - 5), TestFree) == &Queue);
+	QueueTestCheck(SpscQueueRemove(&Queue) == NULL && SpscQueuePeek(&Queue) == NULL);
+
+	for(Round = 0; Round < 3; Round++)
+	{
+		for(i = 0; i < TEST_CAPACITY; i++)
+			QueueTestCheck(SpscQueueAdd(&Queue, QueueTestData(i)));
+
+		QueueTestCheck(!SpscQueueAdd(&Queue, QueueTestData(TEST_CAPACITY)));
+		QueueTestCheck(SpscQueueGetSize(&Queue) == (UINT32)TEST_CAPACITY);
+
+		for(i = 0; i < TEST_CAPACITY; i++)
+		{
+			QueueTestCheck(SpscQueuePeek(&Queue) == QueueTestData(i));
+			QueueTestCheck(SpscQueueRemove(&Queue) == QueueTestData(i));
+		}
+
+		QueueTestCheck(SpscQueueRemove(&Queue) == NULL && SpscQueueGetSize(&Queue) == (UINT32)0);
+	}
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(SpscQueueAdd(&Queue, QueueTestData(0)) && SpscQueueAdd(&Queue, QueueTestData(1)));
+	QueueTestCheck(DestroySpscQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)2);
+
+	QueueTestCheck((Heap = CreateSpscQueue((SPSC_QUEUE*)NULL, (UINT32)TEST_CAPACITY, (void(*)(void*))NULL)) != NULL);
+	QueueTestCheck(DestroySpscQueue(Heap));
+
+	QueueMemDealloc(Heap);
+}
+
+static void *TestProducer(void *Argument)
+{
+	size_t i;
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		while(!SpscQueueAdd((SPSC_QUEUE*)Argument, QueueTestData(i)))
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void TestThreads(void)
+{
+	pthread_t Thread;
+	SPSC_QUEUE Queue;
+	void *Data;
+	size_t i;
+
+	QueueTestCheck(CreateSpscQueue(&Queue, (UINT32)TEST_CAPACITY, (void(*)(void*))NULL) == &Queue);
+
+	QueueTestStartThread(&Thread, TestProducer, &Queue);
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		while((Data = SpscQueueRemove(&Queue)) == NULL)
+			sched_yield();
+
+		QueueTestCheck(Data == QueueTestData(i));
+	}
+
+	pthread_join(Thread, NULL);
+
+	QueueTestCheck(SpscQueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(DestroySpscQueue(&Queue));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestStats.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests QueueGetStats() through the single, batch, drain, clear and
+	swap methods, and the wait time statistics with data held for a while.
+*/
+
+#include <time.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_STATISTICS == 0 || USING_QUEUE_WAIT_TIME_STATISTICS == 0 || USING_QUEUE_SPLICE_METHODS == 0)
+	#error "QueueTestStats needs USING_QUEUE_STATISTICS, USING_QUEUE_WAIT_TIME_STATISTICS and USING_QUEUE_SPLICE_METHODS."
+#endif // end of USING_QUEUE_STATISTICS || USING_QUEUE_WAIT_TIME_STATISTICS || USING_QUEUE_SPLICE_METHODS
+
+#define TEST_ITEMS										10
+#define TEST_WAIT_MS									20
+
+static void TestSleep(UINT32 Milliseconds)
+{
+	struct timespec Time;
+
+	Time.tv_sec = (time_t)(Milliseconds / 1000);
+	Time.tv_nsec = (long)(Milliseconds % 1000) * 1000000L;
+
+	nanosleep(&Time, NULL);
+}
+
+static void TestCounters(void)
+{
+	const void *Items[TEST_ITEMS];
+	void *Removed[TEST_ITEMS];
+	QUEUE_STATS Stats;
+	QUEUE Queue;
+	void **Drained;
+	UINT32 Count;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+	QueueTestCheck(!QueueGetStats(&Queue, (QUEUE_STATS*)NULL));
+
+	QueueTestCheck(QueueGetStats(&Queue, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)0 && Stats.Dequeues == (UINT32)0 && Stats.HighWaterMark == (UINT32)0);
+
+	// Only removes count as empty, peeking doesn't.
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueuePeek(&Queue) == NULL);
+
+	for(i = 0; i < TEST_ITEMS; i++)
+	{
+		Items[i] = QueueTestData(i);
+
+		QueueTestCheck(QueueAdd(&Queue, Items[i]));
+	}
+
+	for(i = 0; i < 3; i++)
+		QueueTestCheck(QueueRemove(&Queue) == QueueTestData(i));
+
+	QueueTestCheck(QueueRemoveBatch(&Queue, Removed, (UINT32)2) == (UINT32)2);
+
+	QueueTestCheck(QueueGetStats(&Queue, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)TEST_ITEMS && Stats.Dequeues == (UINT32)5);
+	QueueTestCheck(Stats.HighWaterMark == (UINT32)TEST_ITEMS && Stats.EmptyRemoves == (UINT32)1);
+
+	// The high water mark stays where it was while the QUEUE shrinks.
+	QueueTestCheck(QueueAddBatch(&Queue, Items, (UINT32)TEST_ITEMS));
+	QueueTestCheck(QueueGetStats(&Queue, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)(TEST_ITEMS * 2) && Stats.HighWaterMark == (UINT32)(TEST_ITEMS * 2 - 5));
+
+	QueueTestCheck((Drained = QueueDrain(&Queue, &Count)) != NULL && Count == (UINT32)(TEST_ITEMS * 2 - 5));
+	QueueMemDealloc(Drained);
+
+	for(i = 0; i < 4; i++)
+		QueueTestCheck(QueueAdd(&Queue, Items[i]));
+
+	QueueTestCheck(QueueClear(&Queue));
+
+	QueueTestCheck(QueueGetStats(&Queue, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)(TEST_ITEMS * 2 + 4) && Stats.Dequeues == (UINT32)(TEST_ITEMS * 2));
+	QueueTestCheck(Stats.Cleared == (UINT32)4 && Stats.AllocationFailures == (UINT32)0);
+	QueueTestCheck(Stats.HighWaterMark == (UINT32)(TEST_ITEMS * 2 - 5) && Stats.EmptyRemoves == (UINT32)1);
+}
+
+/*
+	One piece of data is timed at a time, so holding the first one
+	for a while shows up as one sample at least that long.
+*/
+static void TestWaitTime(void)
+{
+	QUEUE_STATS Stats;
+	QUEUE Queue;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	for(i = 0; i < 3; i++)
+		QueueTestCheck(QueueAdd(&Queue, QueueTestData(i)));
+
+	TestSleep((UINT32)TEST_WAIT_MS);
+
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(0));
+
+	QueueTestCheck(QueueGetStats(&Queue, &Stats));
+	QueueTestCheck(Stats.WaitSamples == (UINT32)1);
+	QueueTestCheck(Stats.MaxWaitTime >= (UINT32)(TEST_WAIT_MS - 1) && Stats.TotalWaitTime == Stats.MaxWaitTime);
+
+	// The data added while the first was timed isn't, the next add is.
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(1) && QueueRemove(&Queue) == QueueTestData(2));
+	QueueTestCheck(QueueGetStats(&Queue, &Stats) && Stats.WaitSamples == (UINT32)1);
+
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(3)) && QueueRemove(&Queue) == QueueTestData(3));
+	QueueTestCheck(QueueGetStats(&Queue, &Stats) && Stats.WaitSamples == (UINT32)2);
+
+	// Clearing drops the timed data without a sample.
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(4)) && QueueClear(&Queue));
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(5)) && QueueRemove(&Queue) == QueueTestData(5));
+	QueueTestCheck(QueueGetStats(&Queue, &Stats) && Stats.WaitSamples == (UINT32)3);
+}
+
+/*
+	Swapped data is neither added nor removed, and the data added
+	after a swap is timed from where it really is in the QUEUE.
+*/
+static void TestSwap(void)
+{
+	QUEUE_STATS Stats;
+	QUEUE First, Second;
+	size_t i;
+
+	QueueTestCheck(CreateQueue(&First, (void(*)(void*))NULL) == &First);
+	QueueTestCheck(CreateQueue(&Second, (void(*)(void*))NULL) == &Second);
+
+	for(i = 0; i < 3; i++)
+		QueueTestCheck(QueueAdd(&First, QueueTestData(i)));
+
+	for(i = 0; i < 5; i++)
+		QueueTestCheck(QueueAdd(&Second, QueueTestData(i)));
+
+	QueueTestCheck(QueueSwap(&First, &Second));
+
+	QueueTestCheck(QueueGetStats(&First, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)3 && Stats.Dequeues == (UINT32)0 && Stats.HighWaterMark == (UINT32)5);
+
+	QueueTestCheck(QueueGetStats(&Second, &Stats));
+	QueueTestCheck(Stats.Enqueues == (UINT32)5 && Stats.Dequeues == (UINT32)0 && Stats.HighWaterMark == (UINT32)5);
+
+	// The data timed before the swap is gone, the next add is timed behind the five swapped in.
+	QueueTestCheck(QueueAdd(&First, QueueTestData(5)));
+
+	for(i = 0; i < 5; i++)
+		QueueTestCheck(QueueRemove(&First) == QueueTestData(i));
+
+	QueueTestCheck(QueueGetStats(&First, &Stats) && Stats.WaitSamples == (UINT32)0);
+
+	QueueTestCheck(QueueRemove(&First) == QueueTestData(5));
+	QueueTestCheck(QueueGetStats(&First, &Stats) && Stats.WaitSamples == (UINT32)1 && Stats.Dequeues == (UINT32)6);
+
+	QueueTestCheck(QueueClear(&Second));
+}
+
+int main(void)
+{
+	TestCounters();
+	TestWaitTime();
+	TestSwap();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestTimer.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the QUEUE from CreateTimerQueue() against the real clock.
+	Deadlines that are meant to stay pending are hours away, so a
+	slow machine can only make the test wait longer, not fail.
+*/
+
+#include <time.h>
+#include <unistd.h>
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_TIMER == 0 || USING_QUEUE_BLOCKING_METHODS == 0)
+	#error "QueueTestTimer needs USING_QUEUE_TIMER and USING_QUEUE_BLOCKING_METHODS."
+#endif // end of USING_QUEUE_TIMER || USING_QUEUE_BLOCKING_METHODS
+
+#define TEST_HOUR										3600000
+#define TEST_TIMERS										200
+
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+/*
+	The same milliseconds as the POSIX QueueGetTickCount().
+*/
+static UINT32 TestTick(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (UINT32)((UINT32)Now.tv_sec * (UINT32)1000 + (UINT32)(Now.tv_nsec / 1000000L));
+}
+
+static BOOL TestIsDue(UINT32 Deadline)
+{
+	return (BOOL)((INT32)(Deadline - TestTick()) <= 0);
+}
+
+static void TestDue(void)
+{
+	QUEUE Queue;
+	UINT32 Deadline, Day;
+
+	QueueTestCheck(CreateTimerQueue(&Queue, TestFree) == &Queue);
+	QueueTestCheck(!QueueGetNextDeadline(&Queue, &Deadline));
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	// Data added with QueueAdd() or a past deadline is due right away.
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(0)));
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(1), TestTick() - (UINT32)10));
+	QueueTestCheck(QueueGetNextDeadline(&Queue, &Deadline) && TestIsDue(Deadline));
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(0));
+	QueueTestCheck(QueueRemove(&Queue) == QueueTestData(1));
+	QueueTestCheck(QueueRemove(&Queue) == NULL);
+
+	// A day away, so the wheel has to skip whole levels of empty slots.
+	Day = TestTick() + (UINT32)(24 * TEST_HOUR);
+
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(2), Day + (UINT32)TEST_HOUR));
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(3), Day));
+	QueueTestCheck(QueueRemove(&Queue) == NULL && QueueGetSize(&Queue) == (UINT32)0);
+	QueueTestCheck(QueueGetNextDeadline(&Queue, &Deadline) && Deadline == Day);
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(QueueAdd(&Queue, QueueTestData(4)));
+	QueueTestCheck(QueueClear(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)3);
+	QueueTestCheck(!QueueGetNextDeadline(&Queue, &Deadline));
+
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(5), TestTick() + (UINT32)TEST_HOUR));
+	QueueTestCheck(DestroyTimerQueue(&Queue));
+	QueueTestCheck(TestFreed == (UINT32)4);
+}
+
+/*
+	Timers a few milliseconds apart come out once they are due, and
+	only then.
+*/
+static void TestExpire(void)
+{
+	UINT32 Deadlines[TEST_TIMERS], Removed, Deadline, i;
+	UINT8 Seen[TEST_TIMERS];
+	QUEUE Queue;
+	void *Data;
+
+	QueueTestCheck(CreateTimerQueue(&Queue, (void(*)(void*))NULL) == &Queue);
+
+	memset(Seen, 0, sizeof(Seen));
+
+	for(i = (UINT32)0; i < (UINT32)TEST_TIMERS; i++)
+	{
+		Deadlines[i] = TestTick() + (UINT32)1 + (i * (UINT32)7919) % (UINT32)80;
+
+		QueueTestCheck(QueueAddAt(&Queue, QueueTestData(i), Deadlines[i]));
+	}
+
+	for(Removed = (UINT32)0; Removed < (UINT32)TEST_TIMERS; )
+	{
+		if((Data = QueueRemove(&Queue)) == NULL)
+		{
+			QueueTestCheck(QueueGetNextDeadline(&Queue, &Deadline));
+
+			usleep(1000);
+			continue;
+		}
+
+		QueueTestCheck(QueueTestValue(Data) < (size_t)TEST_TIMERS && !Seen[QueueTestValue(Data)]);
+		QueueTestCheck(TestIsDue(Deadlines[QueueTestValue(Data)]));
+
+		Seen[QueueTestValue(Data)] = (UINT8)1;
+		Removed++;
+	}
+
+	QueueTestCheck(!QueueGetNextDeadline(&Queue, &Deadline));
+
+	// QueueRemoveWait() sleeps until the next deadline on its own.
+	Deadline = TestTick() + (UINT32)20;
+
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(0), Deadline));
+	QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)QUEUE_WAIT_FOREVER) == QueueTestData(0));
+	QueueTestCheck(TestIsDue(Deadline));
+
+	QueueTestCheck(QueueAddAt(&Queue, QueueTestData(1), TestTick() + (UINT32)TEST_HOUR));
+	QueueTestCheck(QueueRemoveWait(&Queue, (UINT32)10) == NULL);
+	QueueTestCheck(DestroyTimerQueue(&Queue));
+}
+
+int main(void)
+{
+	TestDue();
+	TestExpire();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestTyped.cpp
+	Version: 1.04
+	IDE: None
+	Compiler: C++11
+
+	Description:
+	Tests Queue<T, Policy> of Queue.hpp, linked and as a ring, with
+	a T that counts its live objects, with a move only T and with
+	threads sharing a Queue through QueueMutexLock.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iterator>
+
+#include "Queue.hpp"
+
+#define QueueTestCheck(Condition)						do { if(!(Condition)) { std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); std::exit(EXIT_FAILURE); } } while(0)
+
+#define TEST_RING										8
+#define TEST_ITEMS										1000
+#define TEST_THREADS									4
+
+/*
+	Counts how many are alive, so a Queue that leaks or destroys
+	twice shows up.
+*/
+struct TestItem
+{
+	static int Live;
+
+	int Value;
+	std::string Name;
+
+	TestItem() : Value(-1) { Live++; }
+	TestItem(int NewValue, const char *NewName) : Value(NewValue), Name(NewName) { Live++; }
+	TestItem(const TestItem &Other) : Value(Other.Value), Name(Other.Name) { Live++; }
+	TestItem(TestItem &&Other) : Value(Other.Value), Name(std::move(Other.Name)) { Live++; }
+	~TestItem() { Live--; }
+
+	TestItem &operator=(const TestItem&) = default;
+	TestItem &operator=(TestItem&&) = default;
+};
+
+int TestItem::Live = 0;
+
+/*
+	An allocator which runs out of memory on request.
+*/
+struct TestFailingAllocator
+{
+	static bool Fail;
+
+	static void *Alloc(std::size_t Size) { return Fail ? nullptr : QueueHeapAllocator::Alloc(Size); }
+	static void Dealloc(void *Mem) { QueueHeapAllocator::Dealloc(Mem); }
+};
+
+bool TestFailingAllocator::Fail = false;
+
+typedef QueuePolicy<> TestLinked;
+typedef QueuePolicy<TEST_RING> TestRing;
+typedef QueuePolicy<0, QueueHeapAllocator, QueueMutexLock> TestLocked;
+
+template<class Policy>
+static void TestItems(void)
+{
+	std::vector<TestItem> Batch;
+	TestItem Item, Array[3];
+	int i;
+
+	{
+		Queue<TestItem, Policy> Items;
+
+		QueueTestCheck(Items.empty() && !Items.try_pop(Item));
+
+		Item = TestItem(0, "0");
+
+		QueueTestCheck(Items.push(Item) && Item.Name == "0");
+		QueueTestCheck(Items.push(TestItem(1, "1")));
+		QueueTestCheck(Items.emplace(2, "2"));
+		QueueTestCheck(Items.size() == 3);
+
+		for(i = 0; i < 3; i++)
+		{
+			QueueTestCheck(Items.try_pop(Item));
+			QueueTestCheck(Item.Value == i && Item.Name == std::to_string(i));
+		}
+
+		QueueTestCheck(Items.empty() && !Items.try_pop(Item));
+
+		for(i = 0; i < 6; i++)
+			QueueTestCheck(Items.emplace(i, "batch"));
+
+		// Into a container, then into an array, never more than there are.
+		QueueTestCheck(Items.pop_batch(std::back_inserter(Batch), 2) == 2);
+		QueueTestCheck(Items.pop_batch(Array, 3) == 3);
+		QueueTestCheck(Items.pop_batch(std::back_inserter(Batch), 10) == 1);
+		QueueTestCheck(Items.pop_batch(std::back_inserter(Batch), 10) == 0);
+
+		QueueTestCheck(Batch.size() == 3 && Batch[0].Value == 0 && Batch[1].Value == 1 && Batch[2].Value == 5);
+		QueueTestCheck(Array[0].Value == 2 && Array[2].Value == 4 && Array[2].Name == "batch");
+
+		QueueTestCheck(Items.emplace(7, "7") && Items.emplace(8, "8"));
+		Items.clear();
+		QueueTestCheck(Items.empty());
+
+		// The destructor destroys whatever is left.
+		QueueTestCheck(Items.emplace(9, "9"));
+	}
+
+	Batch.clear();
+
+	// Only Item and Array are left.
+	QueueTestCheck(TestItem::Live == 4);
+}
+
+static void TestFullRing(void)
+{
+	Queue<TestItem, TestRing> Ring;
+	TestItem Item;
+	int i, Round;
+
+	for(Round = 0; Round < 3; Round++)
+	{
+		for(i = 0; i < TEST_RING; i++)
+			QueueTestCheck(Ring.emplace(i, "ring"));
+
+		// A full ring leaves the value it was given alone.
+		Item = TestItem(TEST_RING, "kept");
+
+		QueueTestCheck(!Ring.push(std::move(Item)) && Item.Name == "kept");
+		QueueTestCheck(Ring.size() == TEST_RING);
+
+		// Wraps around the end of the slots.
+		for(i = 0; i < TEST_RING / 2; i++)
+			QueueTestCheck(Ring.try_pop(Item) && Item.Value == i);
+
+		for(i = 0; i < TEST_RING / 2; i++)
+			QueueTestCheck(Ring.emplace(TEST_RING + i, "ring"));
+
+		for(i = TEST_RING / 2; i < TEST_RING + TEST_RING / 2; i++)
+			QueueTestCheck(Ring.try_pop(Item) && Item.Value == i);
+
+		QueueTestCheck(Ring.empty());
+	}
+}
+
+template<class Policy>
+static void TestMoveOnly(void)
+{
+	Queue<std::unique_ptr<int>, Policy> Pointers;
+	std::unique_ptr<int> Pointer, Out[2];
+	int i;
+
+	for(i = 0; i < 4; i++)
+	{
+		Pointer.reset(new int(i));
+
+		QueueTestCheck(Pointers.push(std::move(Pointer)) && Pointer == nullptr);
+	}
+
+	QueueTestCheck(Pointers.emplace(new int(4)));
+
+	QueueTestCheck(Pointers.try_pop(Pointer) && *Pointer == 0);
+	QueueTestCheck(Pointers.pop_batch(Out, 2) == 2 && *Out[0] == 1 && *Out[1] == 2);
+
+	// The rest is freed with the Queue.
+}
+
+static void TestAllocationFailure(void)
+{
+	Queue<TestItem, QueuePolicy<0, TestFailingAllocator> > Items;
+	TestItem Item(1, "kept");
+
+	TestFailingAllocator::Fail = true;
+
+	QueueTestCheck(!Items.push(std::move(Item)) && Item.Name == "kept");
+	QueueTestCheck(!Items.emplace(2, "2") && Items.empty());
+
+	TestFailingAllocator::Fail = false;
+
+	QueueTestCheck(Items.push(std::move(Item)) && Items.size() == 1);
+}
+
+static void TestThreads(void)
+{
+	Queue<int, TestLocked> Shared;
+	std::vector<std::thread> Threads;
+	std::vector<int> All;
+	long Sum;
+	int i;
+
+	for(i = 0; i < TEST_THREADS; i++)
+		Threads.push_back(std::thread([&Shared]() { for(int j = 0; j < TEST_ITEMS; j++) Shared.push(j); }));
+
+	for(i = 0; i < TEST_THREADS; i++)
+		Threads[i].join();
+
+	QueueTestCheck(Shared.size() == TEST_THREADS * TEST_ITEMS);
+	QueueTestCheck(Shared.pop_batch(std::back_inserter(All), TEST_THREADS * TEST_ITEMS) == TEST_THREADS * TEST_ITEMS);
+
+	for(Sum = 0, i = 0; i < TEST_THREADS * TEST_ITEMS; i++)
+		Sum += All[i];
+
+	QueueTestCheck(Sum == (long)TEST_THREADS * TEST_ITEMS * (TEST_ITEMS - 1) / 2);
+}
+
+int main(void)
+{
+	TestItems<TestLinked>();
+	TestItems<TestRing>();
+	TestItems<TestLocked>();
+	TestFullRing();
+	TestMoveOnly<TestLinked>();
+	TestMoveOnly<TestRing>();
+	TestAllocationFailure();
+	TestThreads();
+
+	QueueTestCheck(TestItem::Live == 0);
+
+	return EXIT_SUCCESS;
+}
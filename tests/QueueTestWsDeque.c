@@ -0,0 +1,132 @@
+/*
+	Date: October 17, 2026
+	File Name: QueueTestWsDeque.c
+	Version: 1.04
+	IDE: None
+	Compiler: C99 with POSIX threads
+
+	Description:
+	Tests the WS_DEQUE, on one thread and with thieves stealing while
+	the owner pushes and pops, where every task must run exactly once.
+*/
+
+#include "QueueTest.h"
+
+#if (USING_QUEUE_WORK_STEALING == 0)
+	#error "QueueTestWsDeque needs USING_QUEUE_WORK_STEALING."
+#endif // end of USING_QUEUE_WORK_STEALING
+
+#define TEST_CAPACITY									16
+#define TEST_THIEVES									3
+#define TEST_STRESS_ITEMS								200000
+
+static WS_DEQUE StressDeque;
+static UINT8 StressSeen[TEST_STRESS_ITEMS];
+static BOOL StressDone;
+static UINT32 TestFreed;
+
+static void TestFree(void *Data)
+{
+	(void)Data;
+
+	TestFreed++;
+}
+
+static void TestSingleThread(void)
+{
+	WS_DEQUE Deque;
+	size_t i;
+
+	QueueTestCheck(CreateWsDeque(&Deque, (UINT32)TEST_CAPACITY, TestFree) == &Deque);
+	QueueTestCheck(WsDequePop(&Deque) == NULL && WsDequeSteal(&Deque) == NULL);
+
+	for(i = 0; i < 5; i++)
+		QueueTestCheck(WsDequePush(&Deque, QueueTestData(i)));
+
+	// The owner takes the newest, thieves the oldest.
+	QueueTestCheck(WsDequePop(&Deque) == QueueTestData(4));
+	QueueTestCheck(WsDequeSteal(&Deque) == QueueTestData(0));
+	QueueTestCheck(WsDequeGetSize(&Deque) == (UINT32)3);
+	QueueTestCheck(WsDequeSteal(&Deque) == QueueTestData(1));
+	QueueTestCheck(WsDequePop(&Deque) == QueueTestData(3));
+	QueueTestCheck(WsDequePop(&Deque) == QueueTestData(2));
+	QueueTestCheck(WsDequePop(&Deque) == NULL && WsDequeGetSize(&Deque) == (UINT32)0);
+
+	// Outgrows its array twice, keeping the order.
+	for(i = 0; i < 4 * TEST_CAPACITY; i++)
+		QueueTestCheck(WsDequePush(&Deque, QueueTestData(i)));
+
+	QueueTestCheck(WsDequeGetSize(&Deque) == (UINT32)(4 * TEST_CAPACITY));
+	QueueTestCheck(WsDequeSteal(&Deque) == QueueTestData(0));
+	QueueTestCheck(WsDequePop(&Deque) == QueueTestData(4 * TEST_CAPACITY - 1));
+
+	TestFreed = (UINT32)0;
+
+	QueueTestCheck(DestroyWsDeque(&Deque));
+	QueueTestCheck(TestFreed == (UINT32)(4 * TEST_CAPACITY - 2));
+}
+
+static void TestRun(void *Data)
+{
+	__atomic_add_fetch(&StressSeen[QueueTestValue(Data)], (UINT8)1, __ATOMIC_RELAXED);
+}
+
+static void *TestThief(void *Argument)
+{
+	void *Data;
+
+	(void)Argument;
+
+	while(!__atomic_load_n(&StressDone, __ATOMIC_ACQUIRE) || WsDequeGetSize(&StressDeque))
+	{
+		if((Data = WsDequeSteal(&StressDeque)) != NULL)
+			TestRun(Data);
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void TestThreads(void)
+{
+	pthread_t Threads[TEST_THIEVES];
+	void *Data;
+	size_t i;
+
+	QueueTestCheck(CreateWsDeque(&StressDeque, (UINT32)2, (void(*)(void*))NULL) == &StressDeque);
+
+	for(i = 0; i < TEST_THIEVES; i++)
+		QueueTestStartThread(&Threads[i], TestThief, NULL);
+
+	// The owner runs some tasks itself, racing the thieves for the last
+	// one, and grows the array while they steal from it.
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+	{
+		QueueTestCheck(WsDequePush(&StressDeque, QueueTestData(i)));
+
+		if(i % 3 == 0 && (Data = WsDequePop(&StressDeque)) != NULL)
+			TestRun(Data);
+	}
+
+	while((Data = WsDequePop(&StressDeque)) != NULL)
+		TestRun(Data);
+
+	__atomic_store_n(&StressDone, (BOOL)TRUE, __ATOMIC_RELEASE);
+
+	for(i = 0; i < TEST_THIEVES; i++)
+		pthread_join(Threads[i], NULL);
+
+	for(i = 0; i < TEST_STRESS_ITEMS; i++)
+		QueueTestCheck(StressSeen[i] == (UINT8)1);
+
+	QueueTestCheck(DestroyWsDeque(&StressDeque));
+}
+
+int main(void)
+{
+	TestSingleThread();
+	TestThreads();
+
+	return EXIT_SUCCESS;
+}